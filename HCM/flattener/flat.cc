@@ -1,8 +1,14 @@
 #include "hcm.h"
+#include "hcmCellBuilder.h"
+#include "flat.h"
 #include <set>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <unordered_map>
+#include <deque>
+#include <thread>
+#include <atomic>
 
 using namespace std;
 
@@ -174,7 +180,13 @@ static int flatten(hcmCtx ctx, hcmCell* sCell, hcmCell* dCell, set<string>& glob
   return 0;
 }
 
-hcmCell* hcmFlatten(string flatCellName, hcmCell* sCell, set<string>& globalNodes) {
+/** @fn static hcmCell* createFlatCell(string flatCellName, hcmCell* sCell)
+ * @brief creates the flat cell with the ports of sCell, port buses are kept buses.
+ * @param flatCellName - the name of the new flat cell
+ * @param sCell - pointer to hcmCell represent the source cell
+ * @return pointer to the new cell, the program exits if it can't be made
+ */
+static hcmCell* createFlatCell(string flatCellName, hcmCell* sCell) {
   // first create the cell in same design
   hcmCell* dCell = sCell->owner()->createCell(flatCellName);
   if (dCell == NULL) {
@@ -182,12 +194,25 @@ hcmCell* hcmFlatten(string flatCellName, hcmCell* sCell, set<string>& globalNode
     exit(1);
   }
   
-  // copy over all ports
+  // copy over all port buses, keeping them buses in the flat cell
+  map<string, hcmBus>::const_iterator bI;
+  for (bI = sCell->getBuses().begin(); bI != sCell->getBuses().end(); bI++) {
+    const hcmBus& bus = (*bI).second;
+    if (bus.getDirection() == NOT_PORT) {
+      continue;
+    }
+    if (dCell->createBus(bus.getName(), bus.getFrom(), bus.getTo(), bus.getDirection()) == NULL) {
+      cerr << "-F- Could not create new bus for port: " << bus.getName() << endl;
+      exit(1);
+    }
+  }
+
+  // and the other ports
   map<string, hcmNode*>::const_iterator nI;
   for (nI = sCell->getNodes().begin(); nI != sCell->getNodes().end(); nI++) {
     const hcmNode* node = (*nI).second;
     const hcmPort* port = node->getPort();
-    if (port == NULL) {
+    if (port == NULL || dCell->getNode(node->getName())) {
       continue;
     }
 
@@ -202,7 +227,12 @@ hcmCell* hcmFlatten(string flatCellName, hcmCell* sCell, set<string>& globalNode
       exit(1);
     }
   }
-  
+  return dCell;
+}
+
+hcmCell* hcmFlattenBottomUp(string flatCellName, hcmCell* sCell, set<string>& globalNodes) {
+  hcmCell* dCell = createFlatCell(flatCellName, sCell);
+
   // empty context for the top cell.
   hcmCtx ctx; 
   if (flatten(ctx, sCell, dCell, globalNodes)) {
@@ -212,6 +242,657 @@ hcmCell* hcmFlatten(string flatCellName, hcmCell* sCell, set<string>& globalNode
   return dCell;
 }
 
+// the nets of a context that are not resolved yet, and the ports that don't reach a net
+#define FLAT_NET_UNSET -2
+#define FLAT_NET_NONE -1
+
+// the subtrees each thread gets, and the runs of subtrees the threads take one at a time
+#define FLAT_SUBTREES_PER_THREAD 16
+#define FLAT_RUNS_PER_THREAD 8
+
+// the occurrences a master needs to be flattened into a template, fewer don't pay for making it
+#define FLAT_TEMPLATE_OCCURRENCES 8
+
+/**
+ * hcmFlattener copies the leaf instances of a hierarchy into a flat cell top down.
+ * each master is compiled once to arrays - its nodes by index and the pins of its instances as pairs of
+ * node indexes, and each context passes the flat nets of its nodes down to the contexts it holds. so a pin
+ * is resolved by two array lookups, and a hierarchical name is made once, when its flat object is added.\n
+ * the contexts near the top are resolved first, splitting the hierarchy into subtrees that need nothing from
+ * each other. runs of subtrees are walked on any thread into stages of their own, touching no shared state,
+ * and the stages are merged in order into one hcmCellBuilder batch. so the flat cell is the same for any
+ * number of threads, with the names hcmFlattenBottomUp() gives.\n
+ * a master met many times is flattened once into a template, its leaves and nets named from under it and
+ * its pins on its own ports. each occurrence is stamped out of the template by prefixing the names and
+ * binding the ports to the nets of the occurrence, without walking the hierarchy under it again.
+ * hcmFlattener is a mutable object.
+ */
+class hcmFlattener {
+  // Abstraction Function:
+    //  infos - the compiled masters under the top.
+    //  upperNets - the nets of the contexts above the subtrees, resolved by split().
+    //  prefixes - the hierarchical prefixes of the contexts above the subtrees.
+    //  subtrees/subtreePins - the subtrees in depth first order, and the upper net of each of their pins.
+    //  templates - the flattened masters, by the master.
+    //  nodeByName - the flat nodes that may be named by more than one context, by their name.
+    //  plainNames - no name under the top has a '/', so the names of nodes under instances never collide.
+
+  private:
+    struct cellInfo;
+
+    // a sub instance of a master - the pins are pairs of (node of its master, node of the master holding it).
+    struct instInfo {
+      string name;
+      cellInfo* master;
+      vector< pair<int, int> > pins;
+    };
+
+    // a compiled master - its nodes in name order, and the sub instances in name order. the instances are
+    // compiled only for a master that is flattened somewhere, it is a leaf until then.
+    struct cellInfo {
+      hcmCell* cell;
+      vector<hcmNode*> nodes;
+      vector<string> names;
+      // global - the node is a global node, its flat net is named by the node alone.
+      vector<bool> global;
+      unordered_map<const hcmNode*, int> nodeIdx;
+      vector<instInfo> insts;
+      // flatInsts/flatPins - the leaf instances and their pins under one occurrence of the cell at instLevel.
+      // counted by countCells() once all the masters are compiled.
+      size_t flatInsts;
+      size_t flatPins;
+      // instLevel - the lowest level the instances of the cell were compiled for, 0 if they were not.
+      size_t instLevel;
+      // height - the levels of the compiled instances under the cell, 0 for a leaf. counted with flatInsts.
+      size_t height;
+      // occurrences - the times the cell is met under the top, as far as it is compiled.
+      size_t occurrences;
+      bool compiled;
+      bool visited;
+    };
+
+    // a net of a context above the subtrees - its name, and its builder handle once a pin made its node.
+    struct upperNet {
+      string name;
+      bool byName;
+      int node;
+    };
+
+    // an instance of a context above the subtrees, flattened as one piece.
+    struct subtree {
+      const instInfo* inst;
+      const string* prefix;
+      size_t firstPin;
+      // level - the level of the instance, the instances of the top are level 1.
+      size_t level;
+    };
+
+    // the flat objects of a run of subtrees, in the order the run adds them. a pin is on a node of the stage,
+    // or on the upper net -(node + 1).\n
+    // a template is a stage of a master walked with no prefix - the names are relative to an occurrence but
+    // for the global nodes, and a pin is on a node of the template, or on the master node -(node + 1).
+    struct flatStage {
+      vector<string> nodeNames;
+      // nodeGlobal - the node is a global node, named alone.
+      vector<bool> nodeGlobal;
+      vector<string> instNames;
+      vector<hcmCell*> masters;
+      vector<hcmCellBuilder::hcmBuilderPin> pins;
+    };
+
+    // a net of a context in a subtree - the stage node once a pin made it, and the name to make it with.
+    struct flatNet {
+      int node;
+      const string* prefix;
+      const string* local;
+      // upper - the upper net it is, -1 for a net of the subtree.
+      int upper;
+    };
+
+    // the state of one thread walking subtrees.
+    struct walker {
+      flatStage* stage;
+      // level - the level of the subtree being walked, the instances at depth d are at level + d.
+      size_t level;
+      // unlimited - a template is walked, only the leaves stop it.
+      bool unlimited;
+      // stampNodes - the stage nodes of the nodes of the template being stamped.
+      vector<int> stampNodes;
+      vector<flatNet> nets;
+      // netsByDepth - the flat nets of the nodes of the context at each depth, reused between contexts.
+      vector< vector<int> > netsByDepth;
+    };
+
+    hcmCell* dCell;
+    set<string>& globalNodes;
+    const hcmFlattenLimits& limits;
+    // pathLevels - the most levels of the paths of the limits.
+    size_t pathLevels;
+    hcmCellBuilder builder;
+    map<const hcmCell*, cellInfo> infos;
+    vector<upperNet> upperNets;
+    deque<string> prefixes;
+    vector<subtree> subtrees;
+    vector<int> subtreePins;
+    map<const cellInfo*, flatStage> templates;
+    unordered_map<string, int> nodeByName;
+    bool plainNames;
+
+    cellInfo* getInfo(hcmCell* cell);
+    void compileInsts(cellInfo& info, size_t level);
+    void orderCells(cellInfo& info, vector<cellInfo*>& order);
+    void countCells(const vector<cellInfo*>& order);
+    void buildTemplates(cellInfo& top, const vector<cellInfo*>& order);
+    bool isLeaf(const instInfo& child, size_t level, const string& prefix, bool unlimited = false) const;
+    const flatStage* getTemplate(const instInfo& child, size_t level, bool unlimited) const;
+    int getUpperNet(const cellInfo& cInfo, vector<int>& cNets, int node, const string& prefix);
+    void split(const cellInfo& cInfo, vector<int>& cNets, const string& prefix, size_t level, size_t grain);
+
+    int getNet(walker& w, const cellInfo& cInfo, vector<int>& cNets, int node, const string& prefix);
+    int getStageNode(walker& w, flatNet& net);
+    void flattenInst(walker& w, const instInfo& child, size_t depth, const string& prefix);
+    void flattenCtx(walker& w, const cellInfo& cInfo, size_t depth, const string& prefix);
+    void flattenSubtree(walker& w, const subtree& tree);
+    void stamp(walker& w, const flatStage& tmpl, const vector<int>& occNets, const string& prefix);
+
+    int addFlatNode(string& name, bool byName);
+    void merge(flatStage& stage);
+
+  public:
+    hcmFlattener(hcmCell* d, set<string>& g, const hcmFlattenLimits& l);
+
+    /** @fn int flatten(hcmCell* sCell, unsigned int numThreads)
+     * @brief copies the leaf instances under sCell into the flat cell on up to numThreads threads.
+     * @return 0 on success, 1 if the flat objects could not be added.
+     */
+    int flatten(hcmCell* sCell, unsigned int numThreads);
+};
+
+hcmFlattener::hcmFlattener(hcmCell* d, set<string>& g, const hcmFlattenLimits& l) :
+  dCell(d), globalNodes(g), limits(l), pathLevels(0), builder(d), plainNames(true) {
+  for (auto pI = limits.paths.begin(); pI != limits.paths.end(); pI++) {
+    pathLevels = max(pathLevels, (size_t)count(pI->begin(), pI->end(), '/') + 1);
+  }
+}
+
+hcmFlattener::cellInfo* hcmFlattener::getInfo(hcmCell* cell) {
+  cellInfo& info = infos[cell];
+  if (info.compiled) {
+    return &info;
+  }
+  info.cell = cell;
+  info.compiled = true;
+  info.flatInsts = 0;
+  info.flatPins = 0;
+  info.instLevel = 0;
+  info.height = 0;
+  info.occurrences = 0;
+  info.visited = false;
+  for (auto nI = cell->getNodes().begin(); nI != cell->getNodes().end(); nI++) {
+    info.nodeIdx[nI->second] = info.nodes.size();
+    info.nodes.push_back(nI->second);
+    info.names.push_back(nI->first);
+    info.global.push_back(globalNodes.find(nI->first) != globalNodes.end());
+    if (nI->first.find('/') != string::npos) {
+      plainNames = false;
+    }
+  }
+  return &info;
+}
+
+void hcmFlattener::compileInsts(cellInfo& info, size_t level) {
+  // a cell met at a lower level was compiled for at least as many levels under it
+  if (info.instLevel && info.instLevel <= level) {
+    return;
+  }
+  hcmCell* cell = info.cell;
+  if (info.instLevel == 0) {
+    for (auto iI = cell->getInstances().begin(); iI != cell->getInstances().end(); iI++) {
+      hcmInstance* inst = iI->second;
+      instInfo ii;
+      ii.name = iI->first;
+      ii.master = getInfo(inst->masterCell());
+      for (auto pI = inst->getInstPorts().begin(); pI != inst->getInstPorts().end(); pI++) {
+        const hcmInstPort* instPort = pI->second;
+        ii.pins.push_back(make_pair(ii.master->nodeIdx[instPort->getPort()->owner()], info.nodeIdx[instPort->getNode()]));
+      }
+      if (iI->first.find('/') != string::npos) {
+        plainNames = false;
+      }
+      info.insts.push_back(ii);
+    }
+  }
+  info.instLevel = level;
+
+  // the masters below the limits stay leaves, nothing under them is compiled
+  for (auto iI = info.insts.begin(); iI != info.insts.end(); iI++) {
+    cellInfo& master = *iI->master;
+    bool stop = (limits.maxDepth > 0 && level >= (size_t)limits.maxDepth) ||
+      limits.masters.find(master.cell->getName()) != limits.masters.end();
+    if (!stop && !master.cell->getInstances().empty()) {
+      compileInsts(master, level + 1);
+    }
+  }
+}
+
+void hcmFlattener::orderCells(cellInfo& info, vector<cellInfo*>& order) {
+  if (info.visited) {
+    return;
+  }
+  info.visited = true;
+  for (auto iI = info.insts.begin(); iI != info.insts.end(); iI++) {
+    orderCells(*iI->master, order);
+  }
+  order.push_back(&info);
+}
+
+void hcmFlattener::countCells(const vector<cellInfo*>& order) {
+  // a master may be compiled again for more levels after a cell holding it was compiled, so the counts are
+  // made once all are compiled, each master before the cells holding it
+  for (auto cI = order.begin(); cI != order.end(); cI++) {
+    cellInfo& info = **cI;
+    info.flatInsts = 0;
+    info.flatPins = 0;
+    info.height = 0;
+    for (auto iI = info.insts.begin(); iI != info.insts.end(); iI++) {
+      const cellInfo& master = *iI->master;
+      if (master.insts.empty()) {
+        info.flatInsts++;
+        info.flatPins += iI->pins.size();
+      } else {
+        info.flatInsts += master.flatInsts;
+        info.flatPins += master.flatPins;
+      }
+      info.height = max(info.height, master.height + 1);
+    }
+  }
+}
+
+void hcmFlattener::buildTemplates(cellInfo& top, const vector<cellInfo*>& order) {
+  // the occurrences are counted from the top down, the masters after the masters they hold
+  top.occurrences = 1;
+  for (auto cI = order.rbegin(); cI != order.rend(); cI++) {
+    for (auto iI = (*cI)->insts.begin(); iI != (*cI)->insts.end(); iI++) {
+      iI->master->occurrences += (*cI)->occurrences;
+    }
+  }
+
+  // and the templates are made from the bottom up, a template stamps the templates under it
+  walker w;
+  w.level = 0;
+  w.unlimited = true;
+  for (auto cI = order.begin(); cI != order.end(); cI++) {
+    cellInfo& info = **cI;
+    if (info.insts.empty() || info.occurrences < FLAT_TEMPLATE_OCCURRENCES || &info == &top) {
+      continue;
+    }
+    // the highest occurrence is at instLevel - 1, a depth limit stopping under it stops under all of them
+    if (limits.maxDepth > 0 && info.instLevel - 1 + info.height > (size_t)limits.maxDepth) {
+      continue;
+    }
+    flatStage& tmpl = templates[&info];
+    w.stage = &tmpl;
+    // the nets of the ports stand for the nets of an occurrence
+    w.nets.clear();
+    w.netsByDepth.resize(max(w.netsByDepth.size(), (size_t)1));
+    w.netsByDepth[0].assign(info.nodes.size(), FLAT_NET_UNSET);
+    for (size_t n = 0; n < info.nodes.size(); n++) {
+      if (info.nodes[n]->getPort()) {
+        w.netsByDepth[0][n] = w.nets.size();
+        w.nets.push_back(flatNet{-1, NULL, NULL, (int)n});
+      }
+    }
+    flattenCtx(w, info, 0, "");
+  }
+}
+
+bool hcmFlattener::isLeaf(const instInfo& child, size_t level, const string& prefix, bool unlimited) const {
+  // a master that is not flattened anywhere has no compiled instances
+  if (child.master->insts.empty() || unlimited) {
+    return child.master->insts.empty();
+  }
+  if (limits.maxDepth > 0 && level >= (size_t)limits.maxDepth) {
+    return true;
+  }
+  // only the levels a path reaches are looked up
+  return level <= pathLevels && limits.paths.find(prefix + child.name) != limits.paths.end();
+}
+
+const hcmFlattener::flatStage* hcmFlattener::getTemplate(const instInfo& child, size_t level, bool unlimited) const {
+  auto tI = templates.find(child.master);
+  if (tI == templates.end()) {
+    return NULL;
+  }
+  // no limit may stop the walk under the occurrence, the template flattens all the compiled levels
+  if (!unlimited && ((limits.maxDepth > 0 && level + child.master->height > (size_t)limits.maxDepth) ||
+                       level < pathLevels)) {
+    return NULL;
+  }
+  return &tI->second;
+}
+
+int hcmFlattener::getUpperNet(const cellInfo& cInfo, vector<int>& cNets, int node, const string& prefix) {
+  if (cNets[node] == FLAT_NET_UNSET) {
+    // top level and global nodes are named by more than one context, and may be ports of the flat cell
+    upperNet net;
+    net.byName = cInfo.global[node] || prefix.empty();
+    net.name = net.byName ? cInfo.names[node] : prefix + cInfo.names[node];
+    net.byName = net.byName || !plainNames;
+    net.node = -1;
+    cNets[node] = upperNets.size();
+    upperNets.push_back(net);
+  }
+  return cNets[node];
+}
+
+void hcmFlattener::split(const cellInfo& cInfo, vector<int>& cNets, const string& prefix, size_t level, size_t grain) {
+  for (auto iI = cInfo.insts.begin(); iI != cInfo.insts.end(); iI++) {
+    const instInfo& child = *iI;
+    size_t firstPin = subtreePins.size();
+    for (auto pI = child.pins.begin(); pI != child.pins.end(); pI++) {
+      subtreePins.push_back(getUpperNet(cInfo, cNets, pI->second, prefix));
+    }
+    if (isLeaf(child, level, prefix) || child.master->flatInsts <= grain) {
+      subtrees.push_back(subtree{&child, &prefix, firstPin, level});
+      continue;
+    }
+
+    // too big for one piece, its own nodes become upper nets too
+    vector<int> childNets(child.master->nodes.size(), FLAT_NET_UNSET);
+    for (size_t n = 0; n < child.master->nodes.size(); n++) {
+      if (child.master->nodes[n]->getPort()) {
+        childNets[n] = FLAT_NET_NONE;
+      }
+    }
+    for (size_t p = 0; p < child.pins.size(); p++) {
+      childNets[child.pins[p].first] = subtreePins[firstPin + p];
+    }
+    subtreePins.resize(firstPin);
+    prefixes.push_back(prefix + child.name + "/");
+    split(*child.master, childNets, prefixes.back(), level + 1, grain);
+  }
+}
+
+int hcmFlattener::getNet(walker& w, const cellInfo& cInfo, vector<int>& cNets, int node, const string& prefix) {
+  if (cNets[node] == FLAT_NET_UNSET) {
+    // an inner node of the context, a global node is one net in all the contexts
+    flatNet net;
+    net.node = -1;
+    net.prefix = cInfo.global[node] ? NULL : &prefix;
+    net.local = &cInfo.names[node];
+    net.upper = -1;
+    cNets[node] = w.nets.size();
+    w.nets.push_back(net);
+  }
+  return cNets[node];
+}
+
+int hcmFlattener::getStageNode(walker& w, flatNet& net) {
+  if (net.upper >= 0) {
+    return -(net.upper + 1);
+  }
+  if (net.node < 0) {
+    flatStage& stage = *w.stage;
+    net.node = stage.nodeNames.size();
+    stage.nodeNames.push_back(net.prefix ? *net.prefix + *net.local : *net.local);
+    stage.nodeGlobal.push_back(net.prefix == NULL);
+  }
+  return net.node;
+}
+
+void hcmFlattener::flattenInst(walker& w, const instInfo& child, size_t depth, const string& prefix) {
+  const cellInfo& master = *child.master;
+  size_t level = w.level + depth;
+  if (!isLeaf(child, level, prefix, w.unlimited)) {
+    const flatStage* tmpl = getTemplate(child, level, w.unlimited);
+    if (tmpl) {
+      stamp(w, *tmpl, w.netsByDepth[depth + 1], prefix + child.name + "/");
+    } else {
+      flattenCtx(w, master, depth + 1, prefix + child.name + "/");
+    }
+    return;
+  }
+
+  // a leaf, or a subtree kept as an instance of its master. its nets are the ones at depth + 1
+  flatStage& stage = *w.stage;
+  int newInst = stage.instNames.size();
+  stage.instNames.push_back(prefix + child.name);
+  stage.masters.push_back(master.cell);
+  vector<int>& leafNets = w.netsByDepth[depth + 1];
+  for (size_t n = 0; n < master.nodes.size(); n++) {
+    if (leafNets[n] < 0) {
+      continue;
+    }
+    int node = getStageNode(w, w.nets[leafNets[n]]);
+    stage.pins.push_back(hcmCellBuilder::hcmBuilderPin{newInst, node, master.nodes[n]->getPort()});
+  }
+}
+
+void hcmFlattener::flattenCtx(walker& w, const cellInfo& cInfo, size_t depth, const string& prefix) {
+  size_t netsMark = w.nets.size();
+  if (w.netsByDepth.size() <= depth + 1) {
+    w.netsByDepth.resize(depth + 2);
+  }
+  for (auto iI = cInfo.insts.begin(); iI != cInfo.insts.end(); iI++) {
+    const instInfo& child = *iI;
+    // the nodes of the child reach a net only through a connected port
+    vector<int>& childNets = w.netsByDepth[depth + 1];
+    childNets.assign(child.master->nodes.size(), FLAT_NET_UNSET);
+    for (size_t n = 0; n < child.master->nodes.size(); n++) {
+      if (child.master->nodes[n]->getPort()) {
+        childNets[n] = FLAT_NET_NONE;
+      }
+    }
+    for (auto pI = child.pins.begin(); pI != child.pins.end(); pI++) {
+      childNets[pI->first] = getNet(w, cInfo, w.netsByDepth[depth], pI->second, prefix);
+    }
+    flattenInst(w, child, depth, prefix);
+  }
+  // the nets of the inner nodes of this context are not seen outside of it
+  w.nets.resize(netsMark);
+}
+
+void hcmFlattener::flattenSubtree(walker& w, const subtree& tree) {
+  const instInfo& child = *tree.inst;
+  // the context holding the subtree is at depth 0, its nets are the upper nets of the pins
+  w.level = tree.level;
+  w.unlimited = false;
+  w.nets.clear();
+  w.netsByDepth.resize(max(w.netsByDepth.size(), (size_t)2));
+  vector<int>& childNets = w.netsByDepth[1];
+  childNets.assign(child.master->nodes.size(), FLAT_NET_UNSET);
+  for (size_t n = 0; n < child.master->nodes.size(); n++) {
+    if (child.master->nodes[n]->getPort()) {
+      childNets[n] = FLAT_NET_NONE;
+    }
+  }
+  for (size_t p = 0; p < child.pins.size(); p++) {
+    int upper = subtreePins[tree.firstPin + p];
+    if (upper < 0) {
+      continue;
+    }
+    childNets[child.pins[p].first] = w.nets.size();
+    w.nets.push_back(flatNet{-1, NULL, NULL, upper});
+  }
+  flattenInst(w, child, 0, *tree.prefix);
+}
+
+void hcmFlattener::stamp(walker& w, const flatStage& tmpl, const vector<int>& occNets, const string& prefix) {
+  flatStage& stage = *w.stage;
+  int firstInst = stage.instNames.size();
+  for (size_t i = 0; i < tmpl.instNames.size(); i++) {
+    stage.instNames.push_back(prefix + tmpl.instNames[i]);
+    stage.masters.push_back(tmpl.masters[i]);
+  }
+
+  // the nodes are added at their first pin, as the walk of the occurrence would add them
+  vector<int>& nodes = w.stampNodes;
+  nodes.assign(tmpl.nodeNames.size(), -1);
+  for (auto pI = tmpl.pins.begin(); pI != tmpl.pins.end(); pI++) {
+    int node;
+    if (pI->node < 0) {
+      // a port of the master, not connected on this occurrence if it has no net
+      int net = occNets[-(pI->node + 1)];
+      if (net < 0) {
+        continue;
+      }
+      node = getStageNode(w, w.nets[net]);
+    } else {
+      if (nodes[pI->node] < 0) {
+        bool global = tmpl.nodeGlobal[pI->node];
+        nodes[pI->node] = stage.nodeNames.size();
+        stage.nodeNames.push_back(global ? tmpl.nodeNames[pI->node] : prefix + tmpl.nodeNames[pI->node]);
+        stage.nodeGlobal.push_back(global);
+      }
+      node = nodes[pI->node];
+    }
+    stage.pins.push_back(hcmCellBuilder::hcmBuilderPin{firstInst + pI->inst, node, pI->port});
+  }
+}
+
+int hcmFlattener::addFlatNode(string& name, bool byName) {
+  if (!byName) {
+    // the name has the prefix of its context only, so no other net has it
+    return builder.addNode(move(name));
+  }
+  auto nI = nodeByName.find(name);
+  if (nI != nodeByName.end()) {
+    return nI->second;
+  }
+  hcmNode* node = dCell->getNode(name);
+  int handle = node ? builder.useNode(node) : builder.addNode(name);
+  nodeByName[name] = handle;
+  return handle;
+}
+
+void hcmFlattener::merge(flatStage& stage) {
+  int firstInst = -1;
+  for (size_t i = 0; i < stage.instNames.size(); i++) {
+    int handle = builder.addInst(move(stage.instNames[i]), stage.masters[i]);
+    if (i == 0) {
+      firstInst = handle;
+    }
+  }
+
+  // the nodes are added at their first pin, as a walk on one thread would add them
+  vector<int> handles(stage.nodeNames.size(), -1);
+  for (auto pI = stage.pins.begin(); pI != stage.pins.end(); pI++) {
+    int node;
+    if (pI->node < 0) {
+      upperNet& net = upperNets[-(pI->node + 1)];
+      if (net.node < 0) {
+        net.node = addFlatNode(net.name, net.byName);
+      }
+      node = net.node;
+    } else {
+      if (handles[pI->node] < 0) {
+        handles[pI->node] = addFlatNode(stage.nodeNames[pI->node], stage.nodeGlobal[pI->node] || !plainNames);
+      }
+      node = handles[pI->node];
+    }
+    builder.addPin(firstInst + pI->inst, node, pI->port);
+  }
+  stage = flatStage();
+}
+
+int hcmFlattener::flatten(hcmCell* sCell, unsigned int numThreads) {
+  cellInfo* topInfo = getInfo(sCell);
+  compileInsts(*topInfo, 1);
+  vector<cellInfo*> order;
+  orderCells(*topInfo, order);
+  countCells(order);
+  buildTemplates(*topInfo, order);
+  if (numThreads == 0) {
+    numThreads = max(1u, thread::hardware_concurrency());
+  }
+  // the nodes of a flat net are about as many as the instances. the counts of a partial flatten are only
+  // a bound, as the masters are counted for the lowest level they are met
+  if (limits.maxDepth == 0 && limits.paths.empty()) {
+    builder.reserve(topInfo->flatInsts, topInfo->flatInsts, topInfo->flatPins);
+  }
+
+  // all the nodes of the top are upper nets named by the node, big instances are split further
+  size_t grain = (numThreads > 1) ? topInfo->flatInsts / (numThreads * FLAT_SUBTREES_PER_THREAD) : topInfo->flatInsts;
+  vector<int> topNets(topInfo->nodes.size(), FLAT_NET_UNSET);
+  prefixes.push_back("");
+  split(*topInfo, topNets, prefixes.back(), 1, grain);
+
+  // runs of subtrees of about the same number of instances
+  size_t runInsts = max(topInfo->flatInsts / (numThreads * FLAT_RUNS_PER_THREAD), (size_t)1);
+  vector<size_t> runs(1, 0);
+  size_t insts = 0;
+  for (size_t t = 0; t < subtrees.size(); t++) {
+    const cellInfo& master = *subtrees[t].inst->master;
+    insts += master.insts.empty() ? 1 : master.flatInsts;
+    if (insts >= runInsts || t + 1 == subtrees.size()) {
+      runs.push_back(t + 1);
+      insts = 0;
+    }
+  }
+  size_t numRuns = runs.size() - 1;
+  vector<flatStage> stages(numRuns);
+  auto walkRun = [&](walker& w, size_t r) {
+    w.stage = &stages[r];
+    for (size_t t = runs[r]; t < runs[r + 1]; t++) {
+      flattenSubtree(w, subtrees[t]);
+    }
+  };
+
+  numThreads = min(numThreads, (unsigned int)numRuns);
+  if (numThreads <= 1) {
+    // merge each run as it is walked, so only one stage is held
+    walker w;
+    for (size_t r = 0; r < numRuns; r++) {
+      walkRun(w, r);
+      merge(stages[r]);
+    }
+  } else {
+    // each thread takes the next run until all are walked, then the stages are merged in order
+    atomic<size_t> next(0);
+    auto walkRuns = [&]() {
+      walker w;
+      for (size_t r = next++; r < numRuns; r = next++) {
+        walkRun(w, r);
+      }
+    };
+    vector<thread> threads;
+    for (unsigned int t = 1; t < numThreads; t++) {
+      threads.emplace_back(walkRuns);
+    }
+    walkRuns();
+    for (auto tI = threads.begin(); tI != threads.end(); ++tI) {
+      tI->join();
+    }
+    for (size_t r = 0; r < numRuns; r++) {
+      merge(stages[r]);
+    }
+  }
+
+  if (builder.commit() != OK) {
+    const vector<string>& errors = builder.getErrors();
+    for (size_t e = 0; e < errors.size(); e++) {
+      cerr << "-E- " << errors[e] << endl;
+    }
+    return 1;
+  }
+  return 0;
+}
+
+hcmCell* hcmFlatten(string flatCellName, hcmCell* sCell, set<string>& globalNodes, unsigned int numThreads) {
+  return hcmFlattenPartial(flatCellName, sCell, globalNodes, hcmFlattenLimits(), numThreads);
+}
+
+hcmCell* hcmFlattenPartial(string flatCellName, hcmCell* sCell, set<string>& globalNodes, const hcmFlattenLimits& limits,
+                           unsigned int numThreads) {
+  hcmCell* dCell = createFlatCell(flatCellName, sCell);
+  hcmFlattener flattener(dCell, globalNodes, limits);
+  if (flattener.flatten(sCell, numThreads)) {
+    cerr << "-F- Could not populate new cell: " << flatCellName << endl;
+    exit(1);
+  }
+  return dCell;
+}
+
 int hcmWriteCellVerilog(hcmCell* topCell, string fileName) {
   ofstream fv(fileName.c_str());
   if (!fv.good()) {
@@ -241,27 +922,33 @@ int hcmWriteCellVerilog(hcmCell* topCell, string fileName) {
   }
   fv << endl;
 
-  // go over all instances
+  // go over all instances, the flat names are made from the name table into one buffer
+  const hcmNameTable& names = topCell->owner()->getNameTable();
+  string str;
   map<string, hcmInstance*>::const_iterator iI;
   for (iI = topCell->getInstances().begin(); iI != topCell->getInstances().end(); iI++) {
     hcmInstance* inst = (*iI).second;
 
-    ostringstream is;
+    str.clear();
     // go over all the inst ports of the original inst and find their occ nodes etc ...
-    is << "   " << inst->masterCell()->getName() << " " << inst->getName() << " (" << endl;
+    str += "   ";
+    names.appendName(inst->masterCell()->getNameId(), str);
+    str += ' ';
+    names.appendName(inst->getNameId(), str);
+    str += " (\n";
     
     map<string, hcmInstPort*>::const_iterator ipI;
     for (ipI = inst->getInstPorts().begin(); ipI != inst->getInstPorts().end(); ipI++) {
-      hcmNode* node = (*ipI).second->getNode();
-      string nn = node->getName() ;
-      replace(nn.begin(), nn.end(), '%', '/');
       if (ipI != inst->getInstPorts().begin()){
-	      is << "," << endl;
+	      str += ",\n";
       }
-      is << "      ." << (*ipI).second->getPort()->getName() << " ( " << nn << " ) ";
+      str += "      .";
+      names.appendName((*ipI).second->getPort()->getNameId(), str);
+      str += " ( ";
+      names.appendName((*ipI).second->getNode()->getNameId(), str);
+      str += " ) ";
     }
-    is << " ); \n" << endl;
-    string str = is.str();
+    str += " ); \n\n";
     replace( str.begin(), str.end(), '%', '/');
     fv << str;
   }
@@ -5,14 +5,57 @@
 
 using namespace std;
 
-/** @fn hcmCell* hcmFlatten(string flatCellName, hcmCell* sCell, set<string>& globalNodes)
- * @brief create a flat model cell based on the given folded model. 
+/** @fn hcmCell* hcmFlatten(string flatCellName, hcmCell* sCell, set<string>& globalNodes, unsigned int numThreads = 1)
+ * @brief create a flat model cell based on the given folded model.\n
+ * the subtrees of the hierarchy are flattened concurrently on up to \a numThreads threads and then added to the
+ * flat cell in order, so the flat cell is the same for any number of threads.
  * @param flatCellName - the name of the new flat cell
  * @param sCell - pointer to hcmCell represent the source cell
  * @param glbNodeNames - refernce to set<string> containing all the global nodes
+ * @param numThreads - the most threads to flatten on, 0 for the number of hardware threads
  * @return pointer to the genereter flatten model on success, null otherwise
  */
-hcmCell* hcmFlatten(string cellName, hcmCell* dCell, set<string>& globalNodes);
+hcmCell* hcmFlatten(string cellName, hcmCell* dCell, set<string>& globalNodes, unsigned int numThreads = 1);
+
+/**
+ * hcmFlattenLimits are where a partial flatten stops. an instance it stops at stays an instance of its
+ * master in the flat cell, connected to the flat nets of its ports, and nothing under it is visited.
+ */
+struct hcmFlattenLimits {
+  // maxDepth - the level of the instances that are not flattened, the instances of the top are level 1.
+  // 0 to flatten all the levels.
+  int maxDepth;
+  // masters - the masters whose instances are not flattened.
+  set<string> masters;
+  // paths - the hierarchical names of the instances that are not flattened, as a/b/c.
+  set<string> paths;
+
+  hcmFlattenLimits() : maxDepth(0) {}
+};
+
+/** @fn hcmCell* hcmFlattenPartial(string flatCellName, hcmCell* sCell, set<string>& globalNodes, const hcmFlattenLimits& limits, unsigned int numThreads = 1)
+ * @brief create a flat model cell as hcmFlatten() does, down to the \a limits only.\n
+ * the instances at the limits keep their masters and their names, their nets are named as in a full flatten.
+ * only the masters above the limits are visited, so a shallow flatten costs as much as the levels it flattens.
+ * @param flatCellName - the name of the new flat cell
+ * @param sCell - pointer to hcmCell represent the source cell
+ * @param glbNodeNames - refernce to set<string> containing all the global nodes
+ * @param limits - where to stop flattening
+ * @param numThreads - the most threads to flatten on, 0 for the number of hardware threads
+ * @return pointer to the genereter flatten model on success, null otherwise
+ */
+hcmCell* hcmFlattenPartial(string flatCellName, hcmCell* sCell, set<string>& globalNodes, const hcmFlattenLimits& limits,
+                           unsigned int numThreads = 1);
+
+/** @fn hcmCell* hcmFlattenBottomUp(string flatCellName, hcmCell* sCell, set<string>& globalNodes)
+ * @brief create the same flat cell as hcmFlatten(), resolving every pin of a leaf by walking up its context.\n
+ * it is slower, and is kept as the reference hcmFlatten() is checked against.
+ * @param flatCellName - the name of the new flat cell
+ * @param sCell - pointer to hcmCell represent the source cell
+ * @param glbNodeNames - refernce to set<string> containing all the global nodes
+ * @return pointer to the genereter flatten model on success, null otherwise
+ */
+hcmCell* hcmFlattenBottomUp(string flatCellName, hcmCell* sCell, set<string>& globalNodes);
 
 /** @fn int hcmWriteCellVerilog(hcmCell* topCell, string fileName)
  * @brief convert a hcmCell to a verilog file format.
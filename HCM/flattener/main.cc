@@ -16,13 +16,42 @@ int main(int argc, char **argv) {
   int anyErr = 0;
   unsigned int i;
   vector<string> vlgFiles;
+  bool memReport = false;
+  bool bottomUp = false;
+  unsigned int numThreads = 1;
+  hcmFlattenLimits limits;
   
   if (argc < 3) {
     anyErr++;
   } else {
-    if (!strcmp(argv[argIdx], "-v")) {
-      argIdx++;
-      verbose = true;
+    // the options may come in any order, -s and -p may be given more than once
+    for (; argIdx < argc && argv[argIdx][0] == '-'; argIdx++) {
+      const char* opt = argv[argIdx];
+      if (!strcmp(opt, "-v")) {
+        verbose = true;
+      } else if (!strcmp(opt, "-m")) {
+        memReport = true;
+      } else if (!strcmp(opt, "-b")) {
+        bottomUp = true;
+      } else if (argIdx + 1 >= argc) {
+        cerr << "-E- Missing the value of option " << opt << endl;
+        anyErr++;
+      } else if (!strcmp(opt, "-j")) {
+        numThreads = atoi(argv[++argIdx]);
+      } else if (!strcmp(opt, "-d")) {
+        limits.maxDepth = atoi(argv[++argIdx]);
+      } else if (!strcmp(opt, "-s")) {
+        limits.masters.insert(argv[++argIdx]);
+      } else if (!strcmp(opt, "-p")) {
+        limits.paths.insert(argv[++argIdx]);
+      } else {
+        cerr << "-E- Unknown option " << opt << endl;
+        anyErr++;
+      }
+    }
+    if (bottomUp && (limits.maxDepth || !limits.masters.empty() || !limits.paths.empty())) {
+      cerr << "-E- The bottom up flatten has no limits" << endl;
+      anyErr++;
     }
     for (;argIdx < argc; argIdx++) {
       vlgFiles.push_back(argv[argIdx]);
@@ -35,7 +64,8 @@ int main(int argc, char **argv) {
   }
 
   if (anyErr) {
-    cerr << "Usage: " << argv[0] << "  [-v] top-cell file1.v [file2.v] ... \n";
+    cerr << "Usage: " << argv[0] << "  [-v] [-m] [-b] [-j threads] [-d depth] [-s master]... [-p path]...\n"
+         << "        top-cell file1.v [file2.v] ... \n";
     exit(1);
   }
 
@@ -46,6 +76,7 @@ int main(int argc, char **argv) {
   hcmDesign* design = new hcmDesign("design");
   string cellName = vlgFiles[0];
   for (i = 1; i < vlgFiles.size(); i++) {
+    hcmAllocPhase phase("parse");
     printf("-I- Parsing verilog %s ...\n", vlgFiles[i].c_str());
     if (!design->parseStructuralVerilog(vlgFiles[i].c_str())) {
       cerr << "-E- Could not parse: " << vlgFiles[i] << " aborting." << endl;
@@ -59,11 +90,31 @@ int main(int argc, char **argv) {
     exit(1);
   }
     
-  hcmCell *flatCell = hcmFlatten(cellName + string("_flat"), topCell, globalNodes);
+  hcmCell *flatCell;
+  {
+    hcmAllocPhase phase("flatten");
+    if (bottomUp) {
+      flatCell = hcmFlattenBottomUp(cellName + string("_flat"), topCell, globalNodes);
+    } else {
+      flatCell = hcmFlattenPartial(cellName + string("_flat"), topCell, globalNodes, limits, numThreads);
+    }
+  }
   cout << "-I- Top cell flattened" << endl;
 
   string flatVlgFileName = cellName + string("_flat.v");
   hcmWriteCellVerilog(flatCell, flatVlgFileName);
 
+  if (memReport) {
+    cout << "-I- Memory report:" << endl;
+    design->memoryReport().print(cout);
+    if (hcmAllocPhase::enabled()) {
+      map<string, hcmAllocStats> phases = hcmAllocPhase::getStats();
+      for (auto pI = phases.begin(); pI != phases.end(); ++pI) {
+        cout << "  phase " << pI->first << ": " << pI->second.allocs << " allocations "
+             << pI->second.bytes << " bytes" << endl;
+      }
+    }
+  }
+
   return(0);
 }
@@ -0,0 +1,259 @@
+#include "hcm.h"
+#include "gen.h"
+#include <cmath>
+
+using namespace std;
+
+hcmNetGen::hcmNetGen(hcmDesign* library, const hcmNetGenParams& p) : params(p), hasFlop(false), leafGates(0), rngState(p.seed), fanoutThreshold(0) {
+  if (params.depth < 1 || params.branch < 1 || params.variants < 1 || params.width < 1) {
+    errorText = "depth, branch, variants and width must be positive";
+    return;
+  }
+  if (params.fanout < 1 || params.dffRatio < 0 || params.dffRatio >= 1) {
+    errorText = "the fanout must be at least 1 and the dff ratio in [0, 1)";
+    return;
+  }
+
+  // the cells are visited by name, so the gate numbers don't depend on the library order
+  const map<string, hcmCell*>& cells = library->getCells();
+  for (auto cI = cells.begin(); cI != cells.end(); ++cI) {
+    hcmCell* cell = cI->second;
+    const vector<string>* order = cell->getPortOrder();
+    if (!order || order->empty()) {
+      continue;
+    }
+    libGate g;
+    g.name = cI->first;
+    g.ports = *order;
+    g.output = -1;
+    g.clock = -1;
+    bool usable = true;
+    for (size_t i = 0; i < order->size() && usable; i++) {
+      hcmPort* port = cell->getPort((*order)[i]);
+      if (!port || cell->getBus((*order)[i])) {
+        usable = false;
+      } else if (port->getDirection() == OUT) {
+        usable = (g.output < 0);
+        g.output = i;
+      } else if (port->getDirection() == IN) {
+        g.inputs.push_back(i);
+      } else {
+        usable = false;
+      }
+    }
+    if (!usable || g.output < 0 || g.inputs.empty()) {
+      continue;
+    }
+    if (g.name == "dff") {
+      // the flip flop takes the clock by its name and the data as its other input
+      for (size_t i = 0; i < g.inputs.size(); i++) {
+        if (g.ports[g.inputs[i]] == "CLK") {
+          g.clock = g.inputs[i];
+          g.inputs.erase(g.inputs.begin() + i);
+          break;
+        }
+      }
+      if (g.clock >= 0 && g.inputs.size() == 1) {
+        flop = g;
+        hasFlop = true;
+      }
+      continue;
+    }
+    gates.push_back(g);
+  }
+  if (gates.empty()) {
+    errorText = "the library has no gates with one output";
+    return;
+  }
+  if (!hasFlop && params.dffRatio > 0) {
+    cerr << "-W- the library has no dff(D, CLK, Q), no flip flops are made" << endl;
+  }
+
+  // spread the instances over the leaves of the hierarchy
+  double leaves = pow((double)params.branch, params.depth - 1);
+  leafGates = (uint64_t)ceil(params.numInsts / leaves);
+  leafGates = max(leafGates, (uint64_t)params.width);
+
+  double stop = 1.0 / params.fanout;
+  fanoutThreshold = (uint32_t)(stop * 4294967295.0);
+}
+
+// splitmix64, the same sequence on every platform
+uint64_t hcmNetGen::nextRandom() {
+  uint64_t z = (rngState += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+uint64_t hcmNetGen::below(uint64_t n) {
+  return nextRandom() % n;
+}
+
+void hcmNetGen::addNet(uint32_t net) {
+  // a geometric fanout - each load the net takes, it stops taking more with the chance 1/fanout
+  uint32_t loads = 1;
+  while ((uint32_t)nextRandom() >= fanoutThreshold) {
+    loads++;
+  }
+  if (budget.size() <= net) {
+    budget.resize(net + 1);
+  }
+  budget[net] = loads;
+  open.push_back(net);
+}
+
+uint32_t hcmNetGen::pickNet(uint32_t numNets) {
+  if (open.empty()) {
+    return below(numNets);
+  }
+  size_t i = below(open.size());
+  uint32_t net = open[i];
+  if (--budget[net] == 0) {
+    open[i] = open.back();
+    open.pop_back();
+  }
+  return net;
+}
+
+string hcmNetGen::blockName(int level, int variant) const {
+  if (level == params.depth - 1) {
+    return params.top;
+  }
+  return "blk" + to_string(level) + "_" + to_string(variant);
+}
+
+void hcmNetGen::writeHeader(ostream& out, const string& name) const {
+  out << "module " << name << " (clk, in, out);\n";
+  out << "  input clk;\n";
+  out << "  input [" << params.width - 1 << ":0] in;\n";
+  out << "  output [" << params.width - 1 << ":0] out;\n";
+}
+
+void hcmNetGen::writeLeaf(ostream& out, const string& name) {
+  uint32_t width = params.width;
+  uint64_t numDff = hasFlop ? (uint64_t)(leafGates * params.dffRatio + 0.5) : 0;
+  numDff = min(numDff, leafGates - width);
+  uint64_t numComb = leafGates - numDff;
+  // the nets by number - the in bits, the flip flop outputs, then the gate outputs of which the last drive out
+  uint64_t numWires = numDff + numComb - width;
+  auto netName = [&](uint64_t net) {
+    if (net < width) {
+      return "in[" + to_string(net) + "]";
+    }
+    if (net < width + numWires) {
+      return "n" + to_string(net - width);
+    }
+    return "out[" + to_string(net - width - numWires) + "]";
+  };
+
+  writeHeader(out, name);
+  for (uint64_t w = 0; w < numWires; w++) {
+    out << ((w % 16) ? ", " : "  wire ") << "n" << w << (((w % 16) == 15 || w + 1 == numWires) ? ";\n" : "");
+  }
+
+  open.clear();
+  budget.clear();
+  for (uint32_t net = 0; net < width + numDff; net++) {
+    addNet(net);
+  }
+  uint64_t numNets = width + numDff;
+  for (uint64_t i = 0; i < numComb; i++, numNets++) {
+    const libGate& g = gates[below(gates.size())];
+    vector<string> pins(g.ports.size());
+    for (size_t in = 0; in < g.inputs.size(); in++) {
+      pins[g.inputs[in]] = netName(pickNet(numNets));
+    }
+    pins[g.output] = netName(numNets);
+    out << "  " << g.name << " g" << i << " (";
+    for (size_t p = 0; p < pins.size(); p++) {
+      out << (p ? ", " : "") << pins[p];
+    }
+    out << ");\n";
+    addNet(numNets);
+  }
+
+  // the flip flops take any net, loops through them are fine
+  for (uint64_t i = 0; i < numDff; i++) {
+    const libGate& g = flop;
+    vector<string> pins(g.ports.size());
+    pins[g.inputs[0]] = netName(pickNet(numNets));
+    pins[g.clock] = "clk";
+    pins[g.output] = netName(width + i);
+    out << "  " << g.name << " f" << i << " (";
+    for (size_t p = 0; p < pins.size(); p++) {
+      out << (p ? ", " : "") << pins[p];
+    }
+    out << ");\n";
+  }
+  out << "endmodule\n\n";
+}
+
+void hcmNetGen::writeBlock(ostream& out, const string& name, int level) {
+  uint32_t width = params.width;
+  uint32_t branch = params.branch;
+  // the nets by number - the in bits, then the out bits of each sub block. the last one drives out
+  auto netName = [&](uint64_t net) {
+    if (net < width) {
+      return "in[" + to_string(net) + "]";
+    }
+    uint64_t sub = (net - width) / width;
+    string bus = (sub + 1 == branch) ? string("out") : "c" + to_string(sub);
+    return bus + "[" + to_string((net - width) % width) + "]";
+  };
+
+  writeHeader(out, name);
+  for (uint32_t c = 0; c + 1 < branch; c++) {
+    out << ((c % 16) ? ", " : "  wire [" + to_string(width - 1) + ":0] ") << "c" << c <<
+      (((c % 16) == 15 || c + 2 == branch) ? ";\n" : "");
+  }
+
+  open.clear();
+  budget.clear();
+  for (uint32_t net = 0; net < width; net++) {
+    addNet(net);
+  }
+  uint64_t numNets = width;
+  for (uint32_t c = 0; c < branch; c++) {
+    out << "  " << blockName(level - 1, below(params.variants)) << " u" << c << " (clk, {";
+    // the bits of the concatenation are from the msb down
+    for (uint32_t b = 0; b < width; b++) {
+      out << (b ? ", " : "") << netName(pickNet(numNets));
+    }
+    out << "}, " << ((c + 1 == branch) ? string("out") : "c" + to_string(c)) << ");\n";
+    for (uint32_t b = 0; b < width; b++, numNets++) {
+      addNet(numNets);
+    }
+  }
+  out << "endmodule\n\n";
+}
+
+uint64_t hcmNetGen::getFlatInsts() const {
+  uint64_t res = leafGates;
+  for (int l = 1; l < params.depth; l++) {
+    res *= params.branch;
+  }
+  return res;
+}
+
+int hcmNetGen::write(ostream& out) {
+  if (!good()) {
+    return 1;
+  }
+  rngState = params.seed;
+  out << "// generated by netgen: seed " << params.seed << " insts " << getFlatInsts() << " depth " << params.depth <<
+    " branch " << params.branch << " variants " << params.variants << " width " << params.width <<
+    " fanout " << params.fanout << " dff " << params.dffRatio << "\n\n";
+  for (int level = 0; level < params.depth; level++) {
+    int numVariants = (level == params.depth - 1) ? 1 : params.variants;
+    for (int v = 0; v < numVariants; v++) {
+      if (level == 0) {
+        writeLeaf(out, blockName(level, v));
+      } else {
+        writeBlock(out, blockName(level, v), level);
+      }
+    }
+  }
+  out.flush();
+  return out.good() ? 0 : 1;
+}
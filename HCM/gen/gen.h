@@ -0,0 +1,124 @@
+#ifndef __GEN_H__
+#define __GEN_H__
+#include "hcm.h"
+#include <cstdint>
+#include <ostream>
+
+using namespace std;
+
+/**
+ * hcmNetGenParams are the knobs of a generated netlist.
+ * the same knobs and seed always give the same netlist, on any machine.
+ */
+struct hcmNetGenParams {
+  // seed - the seed of the random choices.
+  uint64_t seed;
+  // numInsts - the number of gate instances of the flat netlist, rounded to fill the leaf blocks.
+  uint64_t numInsts;
+  // depth - the hierarchy levels, 1 for a top holding the gates.
+  int depth;
+  // branch - the sub block instances of each block above the leaves.
+  int branch;
+  // variants - the different blocks of each level below the top.
+  int variants;
+  // width - the width of the in and out buses of every block.
+  int width;
+  // fanout - the mean fanout of a net, the fanouts are geometrically distributed.
+  double fanout;
+  // dffRatio - the part of the gates of a leaf block that are flip flops.
+  double dffRatio;
+  // top - the name of the top module.
+  string top;
+
+  hcmNetGenParams() : seed(1), numInsts(10000), depth(3), branch(4), variants(2), width(8),
+                      fanout(2.0), dffRatio(0.1), top("top") {}
+};
+
+/**
+ * hcmNetGen writes a synthetic hierarchical structural verilog netlist of the gates of a cell library.
+ * every block has the ports (clk, in[width-1:0], out[width-1:0]). the blocks of level 0 hold gates and flip flops,
+ * a block of level l holds branch instances of the variants of level l-1, chained through their buses, and the top
+ * is the single block of level depth-1. so the file grows with depth * variants while the flat netlist grows as
+ * branch^(depth-1).\n
+ * the nets of a leaf block are only driven by gates before them, and flip flops by any net, so the combinational
+ * logic has no loops. the random numbers come from a generator of its own, not from the standard library.
+ * hcmNetGen is a mutable object.
+ */
+class hcmNetGen {
+  private:
+    // a gate of the library - its ports in header order, the output and the inputs by their position.
+    struct libGate {
+      string name;
+      vector<string> ports;
+      int output;
+      vector<int> inputs;
+      // clock - the position of the clock of a flip flop, -1 for a gate.
+      int clock;
+    };
+
+    hcmNetGenParams params;
+    vector<libGate> gates;
+    // flop/hasFlop - the flip flop of the library, if it has one.
+    libGate flop;
+    bool hasFlop;
+    // leafGates - the gates of each leaf block.
+    uint64_t leafGates;
+    // rngState - the state of the splitmix64 generator.
+    uint64_t rngState;
+    // fanoutThreshold - the chance of a net to stop taking loads, scaled to 2^32.
+    uint32_t fanoutThreshold;
+    // open/budget - the nets that can still take loads, and the loads left for each net.
+    vector<uint32_t> open;
+    vector<uint32_t> budget;
+    string errorText;
+
+    uint64_t nextRandom();
+    uint64_t below(uint64_t n);
+
+    /** @fn void addNet(uint32_t net)
+     * @brief makes the new net \a net available as a load, with its drawn fanout.
+     */
+    void addNet(uint32_t net);
+
+    /** @fn uint32_t pickNet(uint32_t numNets)
+     * @brief picks the net of a load among the open nets, or among the first \a numNets nets if none is open.
+     */
+    uint32_t pickNet(uint32_t numNets);
+
+    string blockName(int level, int variant) const;
+    void writeHeader(ostream& out, const string& name) const;
+    void writeLeaf(ostream& out, const string& name);
+    void writeBlock(ostream& out, const string& name, int level);
+
+  public:
+    /** @fn hcmNetGen(hcmDesign* library, const hcmNetGenParams& params)
+     * @brief hcmNetGen constractor, the gates are the cells of \a library with one output and some inputs.\n
+     * a cell named dff with the inputs D and CLK is used as the flip flop.
+     * @param library - the design the library cells were read into.
+     * @param params - the knobs of the netlist.
+     */
+    hcmNetGen(hcmDesign* library, const hcmNetGenParams& params);
+
+    /** @fn bool good() const
+     * @brief gets whether the library and the knobs can make a netlist, see error() if not.
+     */
+    bool good() const { return errorText.empty(); }
+
+    /** @fn const string& error() const
+     * @brief gets the reason the netlist can't be made.
+     */
+    const string& error() const { return errorText; }
+
+    /** @fn uint64_t getFlatInsts() const
+     * @brief gets the number of gate instances of the flat netlist.
+     */
+    uint64_t getFlatInsts() const;
+
+    /** @fn int write(ostream& out)
+     * @brief writes the netlist to \a out, the leaf blocks first and the top last.
+     * @return 0 on success.
+     */
+    int write(ostream& out);
+};
+
+#endif //__GEN_H__
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <fstream>
+#include <string.h>
+#include <stdlib.h>
+#include "hcm.h"
+#include "gen.h"
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char **argv) {
+  int argIdx = 1;
+  int anyErr = 0;
+  hcmNetGenParams params;
+  string outFileName;
+  string libFileName;
+
+  for (; argIdx < argc && argv[argIdx][0] == '-'; argIdx++) {
+    if (argIdx + 1 >= argc) {
+      anyErr++;
+      break;
+    }
+    const char* opt = argv[argIdx];
+    const char* val = argv[++argIdx];
+    if (!strcmp(opt, "-seed")) {
+      params.seed = strtoull(val, NULL, 10);
+    } else if (!strcmp(opt, "-insts")) {
+      params.numInsts = strtoull(val, NULL, 10);
+    } else if (!strcmp(opt, "-depth")) {
+      params.depth = atoi(val);
+    } else if (!strcmp(opt, "-branch")) {
+      params.branch = atoi(val);
+    } else if (!strcmp(opt, "-variants")) {
+      params.variants = atoi(val);
+    } else if (!strcmp(opt, "-width")) {
+      params.width = atoi(val);
+    } else if (!strcmp(opt, "-fanout")) {
+      params.fanout = atof(val);
+    } else if (!strcmp(opt, "-dff")) {
+      params.dffRatio = atof(val);
+    } else if (!strcmp(opt, "-top")) {
+      params.top = val;
+    } else if (!strcmp(opt, "-o")) {
+      outFileName = val;
+    } else {
+      cerr << "-E- Unknown option " << opt << endl;
+      anyErr++;
+    }
+  }
+  if (argIdx + 1 != argc) {
+    anyErr++;
+  } else {
+    libFileName = argv[argIdx];
+  }
+
+  if (anyErr) {
+    cerr << "Usage: " << argv[0] << " [-seed n] [-insts n] [-depth n] [-branch n] [-variants n] [-width n]\n"
+         << "        [-fanout mean] [-dff ratio] [-top name] [-o out.v] stdcell.v\n";
+    exit(1);
+  }
+
+  hcmDesign* library = new hcmDesign("library");
+  if (library->parseStructuralVerilog(libFileName.c_str()) != BAD_PARAM) {
+    cerr << "-E- Could not parse: " << libFileName << " aborting." << endl;
+    exit(1);
+  }
+
+  hcmNetGen gen(library, params);
+  if (!gen.good()) {
+    cerr << "-E- " << gen.error() << endl;
+    exit(1);
+  }
+  cerr << "-I- Writing " << gen.getFlatInsts() << " flat instances of top " << params.top << endl;
+
+  int res;
+  if (outFileName.empty()) {
+    res = gen.write(cout);
+  } else {
+    ofstream out(outFileName.c_str());
+    if (!out.good()) {
+      cerr << "-E- Could not open: " << outFileName << endl;
+      exit(1);
+    }
+    res = gen.write(out);
+  }
+  if (res) {
+    cerr << "-E- Could not write the netlist" << endl;
+  }
+  delete library;
+  return res;
+}
@@ -1,4 +1,5 @@
 #include "hcm.h"
+#include "hcmOccTree.h"
 #include <fstream>
 #include <list>
 #include <set>
@@ -37,6 +38,12 @@ class hcmNodeCtx {
      */
     list<const hcmInstance*>& getParents() { return(parentInsts); };
 
+    /** @fn const list<const hcmInstance*>& getParents() const
+     * @brief gets parentInsts container. this method doesn't change the state of the object.
+     * @return const list of parentInsts
+     */
+    const list<const hcmInstance*>& getParents() const { return(parentInsts); };
+
     /** @fn const hcmNode* getNode() const
      * @brief gets the hcmNode of the hcmNodeCtx
      * @return hcmNode of the hcmNodeCtx
@@ -84,12 +91,14 @@ class vcdFormatter {
     ofstream vcd;
     // true if the parser is OK, false otherwise
     bool is_good;
-    // codeByNodeCtx - container of tuples of type (const hcmNodeCtx, string) - 
-    // for each tuple, the hcmNodeCtx repersent the contex of the node,
-    // and the string is a VCDId representation of the hcmNodeCtx.
-    map<const hcmNodeCtx, string, cmpNodeCtx> codeByNodeCtx;
     // const pointer to hcmCell of the topCell to parse
     const hcmCell* topCell;
+    // occTree - numbering of the node occurrences under topCell.
+    hcmOccTree occTree;
+    // codeByNodeOcc - container of tuples of type (hcmOccId, string) - 
+    // for each tuple, the hcmOccId is the occurrence id of the node context,
+    // and the string is a VCDId representation of the hcmNodeCtx.
+    unordered_map<hcmOccId, string> codeByNodeOcc;
     // container for the global nodes
     set<string> glbNodeNames;
     // debug mode - true print all inside nodes, false - print only input / output to vcd file
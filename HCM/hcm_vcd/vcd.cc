@@ -78,15 +78,13 @@ int vcdFormatter::dfsVCDScope(list<const hcmInstance*>& parentInsts) {
     }
     
     if (debug_mode) {
-      string code = getVCDId(codeByNodeCtx.size()+1);
-      hcmNodeCtx nodeCtx(parentInsts, node);
-      codeByNodeCtx[nodeCtx] = code;
+      string code = getVCDId(codeByNodeOcc.size()+1);
+      codeByNodeOcc[occTree.getNodeOccId(parentInsts.begin(), parentInsts.end(), node)] = code;
       vcd << "$var wire 1 " << code << " " << name << " $end" << endl;
     }
     else if ((!debug_mode) && (node->getPort())) {
-      string code = getVCDId(codeByNodeCtx.size()+1);
-      hcmNodeCtx nodeCtx(parentInsts, node);
-      codeByNodeCtx[nodeCtx] = code;
+      string code = getVCDId(codeByNodeOcc.size()+1);
+      codeByNodeOcc[occTree.getNodeOccId(parentInsts.begin(), parentInsts.end(), node)] = code;
       vcd << "$var wire 1 " << code << " " << name << " $end" << endl;
     }
   }
@@ -127,7 +125,8 @@ int vcdFormatter::genVCDHeader() {
   return(0);  
 }
 
-vcdFormatter::vcdFormatter(string fileName, const hcmCell* cell, set<string>& glbNodeNames_, bool debug_mode_) {
+vcdFormatter::vcdFormatter(string fileName, const hcmCell* cell, set<string>& glbNodeNames_, bool debug_mode_)
+  : occTree(cell) {
   debug_mode = debug_mode_;
   topCell = cell;
   vcd.open(fileName.c_str());
@@ -146,7 +145,7 @@ vcdFormatter::vcdFormatter(string fileName, const hcmCell* cell, set<string>& gl
 }
 
 vcdFormatter::~vcdFormatter() {
-  codeByNodeCtx.clear();
+  codeByNodeOcc.clear();
   vcd.close();
 }
 
@@ -159,8 +158,9 @@ int vcdFormatter::changeValue(const hcmNodeCtx* nodeCtx, bool value) {
   if ((!debug_mode) && (!nodeCtx->getNode()->getPort())) {
     return(0);
   }
-  map<const hcmNodeCtx, string, cmpNodeCtx>::const_iterator cI = codeByNodeCtx.find(*nodeCtx);
-  if (cI == codeByNodeCtx.end()) {
+  const list<const hcmInstance*>& parents = nodeCtx->getParents();
+  auto cI = codeByNodeOcc.find(occTree.getNodeOccId(parents.begin(), parents.end(), nodeCtx->getNode()));
+  if (cI == codeByNodeOcc.end()) {
     cerr << "-E- Could not find VCD context for node: " << nodeCtx->getName() << endl;
     return(1);
   }
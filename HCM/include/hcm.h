@@ -4,6 +4,7 @@
 // #include "hcm_common.h"
 #include <map>
 #include <set>
+#include <string>
 
 using namespace std;
 
@@ -92,10 +93,16 @@ class hcmTypedProperty: public hcmProperty {
     }
 };
 
+#include "hcmMemory.h"
+#include "hcmStringPool.h"
+#include "hcmNameTable.h"
+#include "hcmArena.h"
+#include "hcmJournal.h"
 #include "hcmObject.h"
 #include "hcmInstPort.h"
 #include "hcmPort.h"
 #include "hcmNode.h"
+#include "hcmBus.h"
 #include "hcmInstance.h"
 #include "hcmCell.h"
 #include "hcmDesign.h"
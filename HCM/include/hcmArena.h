@@ -0,0 +1,158 @@
+#ifndef HCM_ARENA_H
+#define HCM_ARENA_H
+
+#include "hcm_common.h"
+#include <cstddef>
+#include <new>
+
+/**
+ * A hcmArenaBase is the untyped part of a hcmArena.
+ * It hands out fixed size slots carved from large chunks and keeps freed slots on a free list.
+ * every slot starts with a header pointing back to its arena so an object can be returned
+ * to the arena it came from by its address alone.
+ * hcmArenaBase is a mutable object.
+ */
+class hcmArenaBase {
+  // RepInvariant:
+  	//  every slot in chunks[0..n-2] and the first usedInLastChunk slots of the last chunk
+  	//  are either live or on the free list.
+
+  // Abstraction Function:
+    //  a pool of slots of slotSize bytes each, liveCount of them hold an object.
+
+  protected:
+    // slotHeader - prepended to every slot.
+    struct slotHeader {
+      // arena - the arena owning the slot, NULL for an object allocated on the heap.
+      hcmArenaBase* arena;
+      // nextFree - the next slot in the free list, valid only if the slot is not live.
+      slotHeader* nextFree;
+      // live - true if the slot holds a constructed object.
+      bool live;
+    };
+
+    // headerSize - size of slotHeader rounded up to keep the object aligned.
+    static const size_t headerSize = (sizeof(slotHeader) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+
+    // slotSize - size of a slot including its header.
+    size_t slotSize;
+    // chunks - the memory chunks holding the slots, slotsPerChunk slots each.
+    vector<char*> chunks;
+    // usedInLastChunk - number of slots of the last chunk that were ever handed out.
+    size_t usedInLastChunk;
+    // freeList - slots returned to the arena.
+    slotHeader* freeList;
+    // liveCount - number of live objects.
+    size_t liveCount;
+    // releasing - true while release() destroys the live objects.
+    bool releasing;
+
+    static const size_t slotsPerChunk = 1024;
+
+    /** @fn hcmArenaBase(size_t objSize)
+     * @brief hcmArenaBase constractor.
+     * @param objSize - the size of the objects held by the arena.
+     */
+    hcmArenaBase(size_t objSize);
+
+    /** @fn ~hcmArenaBase()
+     * @brief hcmArenaBase distractor. frees the chunks, does not destroy the objects.
+     */
+    ~hcmArenaBase();
+
+    /** @fn slotHeader* slotAt(size_t chunk, size_t idx) const
+     * @brief gets the header of slot \a idx in chunk \a chunk.
+     */
+    slotHeader* slotAt(size_t chunk, size_t idx) const {
+      return (slotHeader*)(chunks[chunk] + idx * slotSize);
+    }
+
+    /** @fn size_t slotsInChunk(size_t chunk) const
+     * @brief gets the number of slots ever handed out from chunk \a chunk.
+     */
+    size_t slotsInChunk(size_t chunk) const {
+      return (chunk + 1 == chunks.size()) ? usedInLastChunk : slotsPerChunk;
+    }
+
+    /** @fn void freeChunks()
+     * @brief frees all the chunks at once and resets the arena.
+     */
+    void freeChunks();
+
+  public:
+    /** @fn static void* allocate(hcmArenaBase* arena, size_t size)
+     * @brief gets memory for an object of \a size bytes.
+     * @param arena - the arena to take the slot from, NULL to allocate on the heap.
+     * @param size - the size of the object.
+     * @return pointer to the memory of the object.
+     */
+    static void* allocate(hcmArenaBase* arena, size_t size);
+
+    /** @fn static void deallocate(void* obj)
+     * @brief returns the memory of an object got from allocate() to where it came from.
+     * @param obj - pointer returned by allocate().
+     * @return none
+     */
+    static void deallocate(void* obj);
+
+    /** @fn static bool isReleasing(const void* obj)
+     * @brief checks if the object is being destroyed by a bulk release of its arena.
+     * objects use it to skip unlinking themselves from objects that are released as well.
+     * @param obj - pointer returned by allocate().
+     * @return true if the arena of the object is in release()
+     */
+    static bool isReleasing(const void* obj);
+
+    /** @fn size_t size() const
+     * @brief gets the number of live objects in the arena.
+     */
+    size_t size() const { return liveCount; }
+
+    /** @fn size_t bytes() const
+     * @brief gets the number of bytes held by the arena chunks.
+     */
+    size_t bytes() const { return chunks.size() * slotsPerChunk * slotSize; }
+};
+
+/**
+ * A hcmArena is a pool of objects of type T owned by a hcmDesign.
+ * objects are allocated from it by the class operator new and go back to it by delete.
+ * release() destroys all the live objects in one sweep over the chunks and frees them.
+ * hcmArena is a mutable object.
+ */
+template <typename T>
+class hcmArena : public hcmArenaBase {
+  public:
+    /** @fn hcmArena()
+     * @brief hcmArena constractor.
+     */
+    hcmArena() : hcmArenaBase(sizeof(T)) {}
+
+    /** @fn ~hcmArena()
+     * @brief hcmArena distractor. releases all the live objects.
+     */
+    ~hcmArena() { release(); }
+
+    /** @fn void release()
+     * @brief destroys all the live objects in allocation order and frees the chunks.
+     * while releasing, isReleasing() returns true for the objects of this arena.
+     * @return none
+     */
+    void release() {
+      releasing = true;
+      for (size_t c = 0; c < chunks.size(); c++) {
+        size_t n = slotsInChunk(c);
+        for (size_t i = 0; i < n; i++) {
+          slotHeader* slot = slotAt(c, i);
+          if (slot->live) {
+            ((T*)((char*)slot + headerSize))->~T();
+            slot->live = false;
+          }
+        }
+      }
+      freeChunks();
+      releasing = false;
+    }
+};
+
+#endif
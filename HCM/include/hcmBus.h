@@ -0,0 +1,95 @@
+#ifndef HCM_BUS_H
+#define HCM_BUS_H
+
+#include "hcm_common.h"
+#include "hcmNameTable.h"
+
+/**
+ * A hcmBus is a range of bit nodes of a cell declared together (e.g P1[7:0]).
+ * the bit nodes are kept in a contiguous table indexed by their bit index, so getting a bit
+ * does not format or look up its name. a bit node is still a regular hcmNode of the cell.
+ * hcmBus is a mutable object.
+ */
+class hcmBus {
+  // RepInvariant:
+  	//  bits.size() == getWidth() && (bits[i] == NULL || bits[i]->getBus() == this)
+
+  // Abstraction Function:
+    //  name - the name of the bus (e.g P1).
+    //  from/to - the range of the bus as declared (e.g 7 and 0 for P1[7:0]).
+    //  bits - bits[i] is the node of bit getLow()+i, NULL if it was deleted.
+
+  private:
+    string name;
+    hcmNameId nameId;
+    int from;
+    int to;
+    hcmPortDir dir;
+    vector<hcmNode*> bits;
+
+  public:
+    /** @fn hcmBus(string busName, hcmNameId id, int fromIdx, int toIdx, hcmPortDir direction)
+     * @brief hcmBus constractor. the bit nodes are added by the owner cell.
+     */
+    hcmBus(string busName, hcmNameId id, int fromIdx, int toIdx, hcmPortDir direction);
+
+    /** @fn const string& getName() const
+     * @brief gets the name of the bus.
+     */
+    const string& getName() const { return name; }
+
+    /** @fn hcmNameId getNameId() const
+     * @brief gets the id of the bus name in the design hcmNameTable.
+     */
+    hcmNameId getNameId() const { return nameId; }
+
+    /** @fn int getFrom() const
+     * @brief gets the first index of the range as declared (7 for P1[7:0]).
+     */
+    int getFrom() const { return from; }
+
+    /** @fn int getTo() const
+     * @brief gets the last index of the range as declared (0 for P1[7:0]).
+     */
+    int getTo() const { return to; }
+
+    // the range of the bus regardless of the declaration order.
+    int getLow() const { return (from < to) ? from : to; }
+    int getHigh() const { return (from < to) ? to : from; }
+    int getWidth() const { return getHigh() - getLow() + 1; }
+
+    /** @fn hcmPortDir getDirection() const
+     * @brief gets the direction the bus was declared with, NOT_PORT for an internal bus.
+     */
+    hcmPortDir getDirection() const { return dir; }
+
+    /** @fn hcmNode* getNode(int index) const
+     * @brief gets the node of bit \a index.
+     * @return the node\n NULL if \a index is out of the range or the bit was deleted.
+     */
+    hcmNode* getNode(int index) const {
+      int i = index - getLow();
+      return (i < 0 || i >= (int)bits.size()) ? NULL : bits[i];
+    }
+
+    /** @fn hcmPort* getPort(int index) const
+     * @brief gets the port of bit \a index.
+     * @return the port\n NULL if the bit has no node or no port.
+     */
+    hcmPort* getPort(int index) const;
+
+    /** @fn vector<hcmPort*> getPorts() const
+     * @brief gets the ports of the bits in declaration order (from getFrom() to getTo()), bits with no port are skipped.
+     */
+    vector<hcmPort*> getPorts() const;
+
+    /** @fn string getBitName(int index) const
+     * @brief formats the name of bit \a index (e.g P1[3]).
+     */
+    string getBitName(int index) const;
+
+    friend class hcmCell;
+    friend class hcmNode;
+};
+
+#endif
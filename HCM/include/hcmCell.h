@@ -17,7 +17,7 @@ class hcmCell : public hcmObject {
     //  cells - a mapping between the name of a cell(e.g B_I1) and the pointer to the hcmInstance object (e.h Inst_I1{C})
     //  myInstances - a mapping of the hcmInstances that this cell contains.
     //  nodes - a mapping between a name of a node(e.g Node P1) to the hcmPort Object.
-    //  buses - a mapping between a name of a port/bus(e.g Port P1) to a pair representing a range of the port(e.g P1[7:0]).
+    //  buses - a mapping between a name of a port/bus(e.g Port P1) to the hcmBus holding its range(e.g P1[7:0]) and bit nodes.
   private:
     //  design - pointer to the design this hcmCell is contained in, the owner.
     hcmDesign* design;
@@ -39,10 +39,68 @@ class hcmCell : public hcmObject {
     // and the hcmNode* is a reference for the hcmNode object.
     map< string, hcmNode* > nodes;
 
-    // buses - container of tuples of type (string, pair<int,int>) - 
+    // buses - container of tuples of type (string, hcmBus) - 
     // for each tuple, the string repersent the name of the bus / port(e.g P1),
-    // and the pair<int,int> representing a range of the port(e.g P1[7:0]).
-    map< string, pair<int,int> > buses;
+    // and the hcmBus holds the range of the port(e.g P1[7:0]) and its bit nodes by index.
+    map< string, hcmBus > buses;
+
+    // busesById - hash index of the buses container by the hcmNameId of the bus name.
+    unordered_map< hcmNameId, hcmBus* > busesById;
+
+    // cellsById - hash index of the cells container by the hcmNameId of the instance name.
+    unordered_map< hcmNameId, hcmInstance* > cellsById;
+
+    // nodesById - hash index of the nodes container by the hcmNameId of the node name.
+    unordered_map< hcmNameId, hcmNode* > nodesById;
+
+    // generation - the design journal generation of the last change in this cell, 0 if never changed.
+    hcmGeneration generation;
+
+    // portTable - the ports of the cell by their ordinal, NULL for a deleted port.
+    // ordinals are given in creation order and are never reused.
+    vector< hcmPort* > portTable;
+
+    // portOrder - the port list of the cell header in order, for connections by order. a name may be a bus.
+    // hasPortOrder - the header was given, a cell with no header can't be connected by order.
+    vector< string > portOrder;
+    bool hasPortOrder;
+
+    // portOrderTable - portOrder compiled to ports, the bit ports of a bus by index, none for an unknown name.
+    // it is compiled on the first use and again after a change of the cell (see getGeneration()).
+    vector< vector< hcmPort* > > portOrderTable;
+    hcmGeneration portOrderGeneration;
+    bool portOrderCompiled;
+
+    /** @fn void compilePortOrder()
+     * @brief resolves the names of portOrder to the ports of the cell.
+     */
+    void compilePortOrder();
+
+    /** @fn int registerPort(hcmPort* port)
+     * @brief adds a new port of this cell to the port table.
+     * @return the ordinal of the port.
+     */
+    int registerPort(hcmPort* port);
+
+    /** @fn void unregisterPort(hcmPort* port)
+     * @brief removes a deleted port from the port table, its ordinal stays unused.
+     */
+    void unregisterPort(hcmPort* port);
+
+    /** @fn hcmNode* addNodeUnchecked(string name)
+     * @brief creates a node and adds it to the containers, the caller made sure the name is free.
+     */
+    hcmNode* addNodeUnchecked(string name);
+
+    /** @fn hcmInstance* addInstUnchecked(string name, hcmCell* masterCell)
+     * @brief creates an instance and adds it to the containers, the caller made sure the name is free.
+     */
+    hcmInstance* addInstUnchecked(string name, hcmCell* masterCell);
+
+    /** @fn hcmInstPort* connectUnchecked(hcmInstance* inst, hcmNode* node, hcmPort* port)
+     * @brief creates an instPort and links it, the caller made sure the parameters are valid.
+     */
+    hcmInstPort* connectUnchecked(hcmInstance* inst, hcmNode* node, hcmPort* port);
 
     /** @fn bool instPortParametersValid(hcmInstance *inst, hcmNode *node, hcmPort* port)
     * @brief a checker for a set of parameters .
@@ -125,7 +183,7 @@ class hcmCell : public hcmObject {
      */
     hcmRes deleteNode(string name);
 
-    /** @fn void createBus(string name, int high , int low, hcmPortDir dir = NOT_PORT)
+    /** @fn hcmBus* createBus(string name, int high , int low, hcmPortDir dir = NOT_PORT)
      * @brief creates a new bus(a sequence of bits - each bit will be represented by a new hcmNode and corresponding hcmPort).\n 
      * the bus will be with created with name \a name and range from \a low to \a high. 
      * the method updates the inner containers accordingly.
@@ -133,10 +191,25 @@ class hcmCell : public hcmObject {
      * @param high - int repersenting upper bound of the range.
      * @param low - int repersenting lower bound of the range.
      * @param dir - hcmPortDir repersenting the direction of the bus 
-     * @return none
+     * @return pointer to the new hcmBus.\n Null in case of bad parameters or a node or bus with the same name.
      * @see hcmPortDir
      */
-    void createBus(string name, int high, int low, hcmPortDir dir = NOT_PORT);
+    hcmBus* createBus(string name, int high, int low, hcmPortDir dir = NOT_PORT);
+
+    /** @fn hcmBus *getBus(string_view name)
+     * @brief gets the hcmBus with name \a name if exist in the current cell.\n
+     * the lookup goes through the design name table and doesn't allocate memory.
+     * @param name - string represent the name of the desired hcmBus.
+     * @return hcmBus with name \a name if exist in the current cell.\n Null otherwise.
+     */
+    hcmBus* getBus(string_view name);
+
+    /** @fn const hcmBus *getBus(string_view name) const
+     * @brief gets the hcmBus with name \a name if exist in the current cell. this method doesn't change the state of the object.
+     * @param name - string represent the name of the desired hcmBus.
+     * @return const hcmBus with name \a name if exist in the current cell.\n Null otherwise.
+     */
+    const hcmBus* getBus(string_view name) const;
     
     /** @fn void deleteBus(string name)
      * @brief .
@@ -183,47 +256,50 @@ class hcmCell : public hcmObject {
      */
     static hcmRes disConnect(hcmInstPort* instPort); // equals to: delete instPort;
 
-    /** @fn hcmInstance *getInst(string name)
-     * @brief gets the hcmInstance with name \a name if exist in the current cell.
+    /** @fn hcmInstance *getInst(string_view name)
+     * @brief gets the hcmInstance with name \a name if exist in the current cell.\n
+     * the lookup goes through the design name table and doesn't allocate memory.
      * @param name - string represent the name of the desired hcmInstance.
      * @return hcmInstance with name \a name if exist in the current cell.\n Null otherwise.
      */
-    hcmInstance* getInst(string name);
+    hcmInstance* getInst(string_view name);
 
-    /** @fn hcmNode *getNode(string name)
-     * @brief gets the hcmNode with name \a name if exist in the current cell.
+    /** @fn hcmNode *getNode(string_view name)
+     * @brief gets the hcmNode with name \a name if exist in the current cell.\n
+     * the lookup goes through the design name table and doesn't allocate memory.
      * @param name - string represent the name of the desired hcmNode.
      * @return hcmNode with name \a name if exist in the current cell.\n Null otherwise.
      */
-    hcmNode* getNode(string name);
+    hcmNode* getNode(string_view name);
 
-    /** @fn hcmPort *getPort(string name)
-     * @brief gets the hcmPort with name \a name if exist in the current cell.
+    /** @fn hcmPort *getPort(string_view name)
+     * @brief gets the hcmPort with name \a name if exist in the current cell.\n
+     * the lookup goes through the design name table and doesn't allocate memory.
      * @param name - string represent the name of the desired hcmPort.
      * @return hcmPort with name \a name if exist in the current cell.\n Null otherwise.
      */
-    hcmPort* getPort(string name);
+    hcmPort* getPort(string_view name);
 
-    /** @fn const hcmInstance *getInst(string name) const
+    /** @fn const hcmInstance *getInst(string_view name) const
      * @brief gets the hcmInstance with name \a name if exist in the current cell. this method doesn't change the state of the object.
      * @param name - string represent the name of the desired hcmInstance.
      * @return const hcmInstance with name \a name if exist in the current cell.\n Null otherwise.
      */
-    const hcmInstance* getInst(string name) const;
+    const hcmInstance* getInst(string_view name) const;
 
-    /** @fn const hcmNode *getNode(string name) const
+    /** @fn const hcmNode *getNode(string_view name) const
      * @brief gets the hcmNode with name \a name if exist in the current cell. this method doesn't change the state of the object.
      * @param name - string represent the name of the desired hcmNode.
      * @return const hcmNode with name \a name if exist in the current cell.\n Null otherwise.
      */
-    const hcmNode* getNode(string name) const;
+    const hcmNode* getNode(string_view name) const;
 
-    /** @fn const hcmPort *getPort(string name) const
+    /** @fn const hcmPort *getPort(string_view name) const
      * @brief gets the hcmPort with name \a name if exist in the current cell. this method doesn't change the state of the object.
      * @param name - string represent the name of the desired hcmPort.
      * @return const hcmPort with name \a name if exist in the current cell.\n Null otherwise.
      */
-    const hcmPort* getPort(string name) const;
+    const hcmPort* getPort(string_view name) const;
 
     /** @fn vector<hcmPort*> getPorts()
      * @brief gets all the hcmPort's that exist in the current cell.
@@ -231,6 +307,38 @@ class hcmCell : public hcmObject {
      */
     vector<hcmPort*> getPorts();
 
+    /** @fn const vector<hcmPort*>& getPortTable() const
+     * @brief gets the ports of the current cell indexed by their ordinal (see hcmPort::getOrdinal()).
+     * @return the port table, entries of deleted ports are NULL.
+     */
+    const vector<hcmPort*>& getPortTable() const;
+
+    /** @fn hcmGeneration getGeneration() const
+     * @brief gets the generation of the last change of the nodes, ports, instances or connections of this cell.\n
+     * anything derived from the cell is up to date as long as the generation did not change.
+     * @return the design journal generation of the last change in this cell.
+     */
+    hcmGeneration getGeneration() const;
+
+    /** @fn void setPortOrder(const vector<string>& names)
+     * @brief sets the port list of the cell header, the order instances of the cell are connected by.
+     * @param names - the ports in order, a name of a bus stands for all its bits.
+     */
+    void setPortOrder(const vector<string>& names);
+
+    /** @fn const vector<string>* getPortOrder() const
+     * @brief gets the port list of the cell header.
+     * @return the names of the ports in order\n Null if the cell has no header.
+     */
+    const vector<string>* getPortOrder() const;
+
+    /** @fn const vector<hcmPort*>* getOrderedPorts(size_t idx)
+     * @brief gets the ports of entry \a idx of the header, compiled once per change of the cell.\n
+     * a bus gives its bit ports by index as hcmInstance::getAvailablePorts(string) does, ignoring connections.
+     * @return the ports of the entry, empty if the cell has no such port\n Null if there is no entry \a idx.
+     */
+    const vector<hcmPort*>* getOrderedPorts(size_t idx);
+
     /** @fn map< string, hcmInstance* > & getInstances()
      * @brief gets a container of tuples of type (string, hcmInstance*). \n
      * for each tuple, the string repersent the name of the cell(e.g A_I1), \n
@@ -276,16 +384,19 @@ class hcmCell : public hcmObject {
      */
     const map< string, hcmNode* >& getNodes() const;
     
-    /** @fn const map< string, pair<int,int> >& getBuses() const
-     * @brief gets a container of tuples of type (string, pair<int,int>). this method doesn't change the state of the object. \n
-     * buses - container of tuples of type (string, pair<int,int>) - 
+    /** @fn const map< string, hcmBus >& getBuses() const
+     * @brief gets a container of tuples of type (string, hcmBus). this method doesn't change the state of the object. \n
+     * buses - container of tuples of type (string, hcmBus) - 
      * for each tuple, the string repersent the name of the bus / port(e.g P1),
-     * and the pair<int,int> representing a range of the port(e.g P1[7:0]).
+     * and the hcmBus holds the range of the port(e.g P1[7:0]) and its bit nodes.
      * @return a map object as described above.
      */
-    const map< string, pair<int,int> >& getBuses() const;
+    const map< string, hcmBus >& getBuses() const;
 
     friend class hcmDesign;
+    friend class hcmPort;
+    friend class hcmCellBuilder;
+    friend class hcmJournal;
 
 };
 
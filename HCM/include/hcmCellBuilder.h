@@ -0,0 +1,148 @@
+#ifndef HCM_CELL_BUILDER_H
+#define HCM_CELL_BUILDER_H
+
+#include "hcm.h"
+
+/**
+ * A hcmCellBuilder collects nodes, instances and pins to be added to a cell in one batch.
+ * the adds only record the request, commit() validates the whole batch once and then
+ * publishes it into the cell without the per call checks and messages of createNode(),
+ * createInst() and connect().
+ * nodes and instances are referred to by the handle returned when they are added,
+ * objects already in the cell can be given a handle by useNode() and useInst().
+ * if the batch is not valid nothing is added to the cell.
+ * hcmCellBuilder is a mutable object.
+ */
+class hcmCellBuilder {
+  // RepInvariant:
+  	//  cell != NULL
+  	//  every pin refers to handles in the range of nodes and insts
+
+  // Abstraction Function:
+    //  cell - the cell the batch is added to.
+    //  nodes/insts - the nodes and instances of the batch by their handle, obj is set for existing
+    //                objects and for new ones once committed.
+    //  pins - the connections of the batch.
+    //  errors - the problems found by the last commit().
+
+  public:
+    // hcmBuilderPin - a connection of the master port \a port of instance \a inst to node \a node.
+    struct hcmBuilderPin {
+      int inst;
+      int node;
+      hcmPort* port;
+    };
+
+  private:
+    struct nodeRec {
+      string name;
+      hcmPortDir dir;
+      hcmNode* obj;
+    };
+    struct instRec {
+      string name;
+      hcmCell* master;
+      hcmInstance* obj;
+    };
+
+    hcmCell* cell;
+    vector<nodeRec> nodes;
+    vector<instRec> insts;
+    vector<hcmBuilderPin> pins;
+    vector<string> errors;
+    // committed - the number of leading nodes/insts already published by a previous commit.
+    size_t committedNodes;
+    size_t committedInsts;
+
+    /** @fn bool validate()
+     * @brief checks the batch against itself and the cell, filling errors.
+     * @return true if the batch can be published.
+     */
+    bool validate();
+
+  public:
+    /** @fn hcmCellBuilder(hcmCell* cell)
+     * @brief hcmCellBuilder constractor.
+     * @param cell - the cell the batch will be added to, can't be NULL.
+     */
+    hcmCellBuilder(hcmCell* cell);
+
+    /** @fn void reserve(size_t numNodes, size_t numInsts, size_t numPins)
+     * @brief reserves room in the builder and in the cell indexes for the expected batch size.
+     * @return none
+     */
+    void reserve(size_t numNodes, size_t numInsts, size_t numPins);
+
+    /** @fn int addNode(string name, hcmPortDir dir = NOT_PORT)
+     * @brief adds a new node, with a port of direction \a dir unless it is NOT_PORT.
+     * @return the handle of the node.
+     */
+    int addNode(string name, hcmPortDir dir = NOT_PORT);
+
+    /** @fn int addNodes(const vector<string>& names, hcmPortDir dir = NOT_PORT)
+     * @brief adds new nodes, all with the same port direction.
+     * @return the handle of the first node, the others follow it in order.
+     */
+    int addNodes(const vector<string>& names, hcmPortDir dir = NOT_PORT);
+
+    /** @fn int useNode(hcmNode* node)
+     * @brief gets a handle for a node already in the cell.
+     * @return the handle of the node.
+     */
+    int useNode(hcmNode* node);
+
+    /** @fn int addInst(string name, hcmCell* master)
+     * @brief adds a new instance of \a master.
+     * @return the handle of the instance.
+     */
+    int addInst(string name, hcmCell* master);
+
+    /** @fn int addInsts(const vector<string>& names, const vector<hcmCell*>& masters)
+     * @brief adds new instances, names[i] is an instance of masters[i].
+     * @return the handle of the first instance, the others follow it in order.
+     */
+    int addInsts(const vector<string>& names, const vector<hcmCell*>& masters);
+
+    /** @fn int useInst(hcmInstance* inst)
+     * @brief gets a handle for an instance already in the cell.
+     * @return the handle of the instance.
+     */
+    int useInst(hcmInstance* inst);
+
+    /** @fn void addPin(int inst, int node, hcmPort* port)
+     * @brief connects port \a port of the master of instance \a inst to node \a node.
+     * @return none
+     */
+    void addPin(int inst, int node, hcmPort* port);
+
+    /** @fn void addPins(const vector<hcmBuilderPin>& batch)
+     * @brief adds a batch of connections.
+     * @return none
+     */
+    void addPins(const vector<hcmBuilderPin>& batch);
+
+    /** @fn hcmRes commit()
+     * @brief validates the batch and publishes it into the cell.\n
+     * on success the batch is emptied, the handles stay valid and getNode()/getInst() give the new objects.
+     * @return OK if the batch was published\n
+     * BAD_PARAM if the batch is not valid, nothing is published and getErrors() tells why.
+     */
+    hcmRes commit();
+
+    /** @fn const vector<string>& getErrors() const
+     * @brief gets the problems found by the last commit().
+     */
+    const vector<string>& getErrors() const { return errors; }
+
+    /** @fn hcmNode* getNode(int handle) const
+     * @brief gets the node of a handle, NULL for a new node that was not committed yet.
+     */
+    hcmNode* getNode(int handle) const { return nodes[handle].obj; }
+
+    /** @fn hcmInstance* getInst(int handle) const
+     * @brief gets the instance of a handle, NULL for a new instance that was not committed yet.
+     */
+    hcmInstance* getInst(int handle) const { return insts[handle].obj; }
+};
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef HCM_COMPACT_NETLIST_H
+#define HCM_COMPACT_NETLIST_H
+
+#include "hcm.h"
+#include <unordered_map>
+
+/**
+ * A hcmCompactNetlist is a frozen, array based view of a flat hcmCell.
+ * instances, pins (instPorts) and nets (nodes) are numbered densely and stored in contiguous arrays,
+ * the connectivity is kept in CSR form (an offsets array and an indices array) so engines
+ * can walk the netlist over integers instead of the maps and names of the hcm objects.
+ * numbering follows the cell maps order: nets by node name, instances by instance name
+ * and the pins of each instance by instPort name.
+ * a pin with direction IN_OUT is both a fanin and a fanout of its instance and its net.
+ * hcmCompactNetlist is an immutable object - it has to be rebuilt if the cell changes.
+ */
+class hcmCompactNetlist {
+  // RepInvariant:
+  	//  instPinOffset.size() == numInsts()+1 && instPinOffset.back() == numPins()
+  	//  every *Offset array is non decreasing and ends with the size of its indices array
+
+  // Abstraction Function:
+    //  cell - the flat cell this view was built from.
+    //  insts/nets/pins - the hcm objects by their index.
+    //  masters - the master cells by their type code.
+
+  private:
+    // cell - the cell this view was built from.
+    const hcmCell* cell;
+    // builtGeneration - the generation of the cell when the view was built.
+    hcmGeneration builtGeneration;
+
+    // mapping from index back to the hcm objects.
+    vector<hcmInstance*> insts;
+    vector<hcmNode*> nets;
+    vector<hcmInstPort*> pins;
+    vector<hcmCell*> masters;
+
+    // instMaster - the type code (index into masters) of each instance.
+    vector<int> instMaster;
+    // instPinOffset - the pins of instance i are [instPinOffset[i], instPinOffset[i+1]).
+    vector<int> instPinOffset;
+
+    // pinInst, pinNet, pinDir - the instance, net and master port direction of each pin.
+    vector<int> pinInst;
+    vector<int> pinNet;
+    vector<hcmPortDir> pinDir;
+
+    // netPortDir - the direction of the cell port on each net, NOT_PORT for internal nets.
+    vector<hcmPortDir> netPortDir;
+
+    // CSR of the pins driving each net (OUT and IN_OUT pins).
+    vector<int> netFaninOffset;
+    vector<int> netFaninPins;
+    // CSR of the pins loading each net (IN and IN_OUT pins).
+    vector<int> netFanoutOffset;
+    vector<int> netFanoutPins;
+
+    // CSR of the input pins (IN and IN_OUT) of each instance.
+    vector<int> instFaninOffset;
+    vector<int> instFaninPins;
+    // CSR of the output pins (OUT and IN_OUT) of each instance.
+    vector<int> instFanoutOffset;
+    vector<int> instFanoutPins;
+
+    // reverse lookups from the hcm objects to their index.
+    unordered_map<const hcmInstance*, int> instIdx;
+    unordered_map<const hcmNode*, int> netIdx;
+
+    /** @fn static void buildCSR(int n, const vector<int>& key, const vector<char>& take, vector<int>& offset, vector<int>& items)
+     * @brief counting sort of the pins with take[p] set by key[p] into offset/items.
+     */
+    static void buildCSR(int n, const vector<int>& key, const vector<char>& take, vector<int>& offset, vector<int>& items);
+
+  public:
+    /** @fn hcmCompactNetlist(hcmCell* flatCell)
+     * @brief builds the view of \a flatCell in a single pass over its nodes and instances.
+     * instances of non primitive masters are kept as black boxes.
+     * @param flatCell - the cell to build the view of.
+     * @return none
+     */
+    hcmCompactNetlist(hcmCell* flatCell);
+
+    /** @fn const hcmCell* getCell() const
+     * @brief gets the cell this view was built from.
+     */
+    const hcmCell* getCell() const { return cell; }
+
+    /** @fn bool isStale() const
+     * @brief checks if the cell changed since the view was built, a stale view has to be rebuilt.
+     */
+    bool isStale() const { return cell->getGeneration() != builtGeneration; }
+
+    // sizes
+    int numInsts() const { return insts.size(); }
+    int numNets() const { return nets.size(); }
+    int numPins() const { return pins.size(); }
+    int numMasters() const { return masters.size(); }
+
+    // per instance data
+    int getInstMaster(int i) const { return instMaster[i]; }
+    int instPinBegin(int i) const { return instPinOffset[i]; }
+    int instPinEnd(int i) const { return instPinOffset[i+1]; }
+    const int* instFaninBegin(int i) const { return instFaninPins.data() + instFaninOffset[i]; }
+    const int* instFaninEnd(int i) const { return instFaninPins.data() + instFaninOffset[i+1]; }
+    const int* instFanoutBegin(int i) const { return instFanoutPins.data() + instFanoutOffset[i]; }
+    const int* instFanoutEnd(int i) const { return instFanoutPins.data() + instFanoutOffset[i+1]; }
+
+    // per pin data
+    int getPinInst(int p) const { return pinInst[p]; }
+    int getPinNet(int p) const { return pinNet[p]; }
+    hcmPortDir getPinDir(int p) const { return pinDir[p]; }
+
+    // per net data
+    hcmPortDir getNetPortDir(int n) const { return netPortDir[n]; }
+    const int* netFaninBegin(int n) const { return netFaninPins.data() + netFaninOffset[n]; }
+    const int* netFaninEnd(int n) const { return netFaninPins.data() + netFaninOffset[n+1]; }
+    const int* netFanoutBegin(int n) const { return netFanoutPins.data() + netFanoutOffset[n]; }
+    const int* netFanoutEnd(int n) const { return netFanoutPins.data() + netFanoutOffset[n+1]; }
+
+    // mapping back to the hcm objects
+    hcmInstance* getInst(int i) const { return insts[i]; }
+    hcmNode* getNet(int n) const { return nets[n]; }
+    hcmInstPort* getPin(int p) const { return pins[p]; }
+    hcmCell* getMaster(int m) const { return masters[m]; }
+
+    /** @fn int getInstIndex(const hcmInstance* inst) const
+     * @brief gets the index of \a inst in this view.
+     * @return the index\n -1 if the instance is not part of the view.
+     */
+    int getInstIndex(const hcmInstance* inst) const;
+
+    /** @fn int getNetIndex(const hcmNode* node) const
+     * @brief gets the index of \a node in this view.
+     * @return the index\n -1 if the node is not part of the view.
+     */
+    int getNetIndex(const hcmNode* node) const;
+};
+
+#endif
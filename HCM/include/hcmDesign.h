@@ -3,6 +3,8 @@
 
 #include "hcmObject.h"
 
+class hcmVerilogLibrary;
+
 /**
  * A hcmDesign is a container to hold a set of cells.
  * 
@@ -15,9 +17,54 @@ class hcmDesign : public hcmObject {
 
   // Abstraction Function:
     //  cells - a mapping between the name of a cell and the pointer to the hcmCell object.
+    //  nameTable - the symbol table of all the names used by the design objects.
+    //  journal - the change counters and listeners of the design netlist.
+    //  props - the property columns of all the design objects, indexed by their hcmObjId.
+    //  *Arena - the pools holding the nodes, ports, instances and instPorts of all the cells.
+    //  parseCacheDir - the directory of the parse cache, empty if the files are always parsed.
+    //  parseCacheHits - the files read from the parse cache.
+    //  library - the index of the library modules not built yet, NULL if no library was added.
   private:
     map< string, class hcmCell* > cells;
 
+    // cellsById - hash index of the cells container by the hcmNameId of the cell name.
+    unordered_map< hcmNameId, class hcmCell* > cellsById;
+
+    // nameTable - the symbol table of all the names used by the design objects.
+    hcmNameTable nameTable;
+
+    // journal - the change counters and listeners of the design netlist.
+    hcmJournal journal;
+
+    // props - the property columns of all the design objects, declared before the pools
+    // so it outlives the objects released by them.
+    hcmPropStore props;
+
+    // per type pools of the design objects - allocated by the class operator new of each type.
+    hcmArena<hcmNode> nodeArena;
+    hcmArena<hcmPort> portArena;
+    hcmArena<hcmInstance> instArena;
+    hcmArena<hcmInstPort> instPortArena;
+
+    // parseCacheDir - the directory holding the parsed form of the verilog files read before, empty for none.
+    string parseCacheDir;
+
+    // parseCacheHits - the files parseStructuralVerilog() got from the parse cache instead of parsing them.
+    size_t parseCacheHits;
+
+    // library - the modules of the library files, built into cells on their first use.
+    hcmVerilogLibrary* library;
+
+    // releasing - true while the destructor tears the design down in bulk.
+    bool releasing;
+
+    /** @fn void bulkRelease()
+     * @brief destroys all the design objects without unlinking them from each other.\n
+     * each arena is swept once and its chunks are freed, then the cells are deleted.
+     * @return none
+     */
+    void bulkRelease();
+
   public:
 
     /** @fn hcmDesign(string name)
@@ -50,28 +97,123 @@ class hcmDesign : public hcmObject {
      */
     void deleteCell(string name);
   
-    /** @fn hcmCell *getCell(string name)
-     * @brief return a pointer to a hcmCell with the corresponding name.
+    /** @fn hcmCell *getCell(string_view name)
+     * @brief return a pointer to a hcmCell with the corresponding name.\n
+     * the lookup goes through the design name table and doesn't allocate memory.\n
+     * a module of a library (see addVerilogLibrary()) is built into its cell by the first lookup of its name.
      * @param name - the name of the wanted cell. 
      * @return pointer to hcmCell with the argument name\n
      *         Null if a hcm cell with the same name exists. 
      * @throws 
      */
-    hcmCell* getCell(string name);
+    hcmCell* getCell(string_view name);
+
+    /** @fn const map< string, hcmCell* >& getCells() const
+     * @brief gets a container of tuples of type (string, hcmCell*), the cells of the design by their name.\n
+     * library modules that were not used yet are not cells yet.
+     * @return a map object as described above.
+     */
+    const map< string, hcmCell* >& getCells() const;
+
+    /** @fn hcmNameTable& getNameTable()
+     * @brief gets the symbol table holding the names of all the design objects.
+     * @return reference to the design name table.
+     */
+    hcmNameTable& getNameTable();
+
+    /** @fn const hcmNameTable& getNameTable() const
+     * @brief gets the symbol table holding the names of all the design objects. this method doesn't change the state of the object.
+     * @return const reference to the design name table.
+     */
+    const hcmNameTable& getNameTable() const;
   
+    /** @fn hcmJournal& getJournal()
+     * @brief gets the change journal of the design, to read its generation or subscribe to its changes.
+     * @return reference to the design journal.
+     */
+    hcmJournal& getJournal();
+
+    /** @fn hcmMemoryReport memoryReport() const
+     * @brief counts the objects of the design and the bytes they hold, by type and by kind of storage.
+     * @return the report.
+     */
+    hcmMemoryReport memoryReport() const;
+
+    /** @fn hcmPropStore& getPropStore()
+     * @brief gets the property columns of the design objects.
+     * @return reference to the design property store.
+     */
+    hcmPropStore& getPropStore();
+
+    /** @fn hcmPropColumn<T>& getPropColumn(const hcmPropKey<T>& key)
+     * @brief gets the column holding the values of \a key for all the design objects.\n
+     * engines annotating many objects can index it by hcmObject::getObjId() directly.
+     * @param key - the typed key of the property.
+     * @return reference to the column of \a key.
+     */
+    template <typename T>
+    hcmPropColumn<T>& getPropColumn(const hcmPropKey<T>& key) {
+      return props.column(key);
+    }
+
     /** @fn void printInfo()
      * @brief print information about this object.
      * @return none
      */
     void printInfo();
   
-    /** @fn hcmRes parseStructuralVerilog(const char *fileName)
+    /** @fn hcmRes parseStructuralVerilog(const char *fileName, hcmVerilogReader reader = VLOG_READER_BISON)
      * @brief Parse Verilog file in to a design object.
      * @param fileName - the name of the verilog file to be parsed
+     * @param reader - the parser to read the file with, both build the same design
      * @return OK if the operation was successfull\n
      * BAD_PARAM if the parmeter supplied to the function is not valid
      */
-    hcmRes parseStructuralVerilog(const char *fileName);
+    hcmRes parseStructuralVerilog(const char *fileName, hcmVerilogReader reader = VLOG_READER_BISON);
+
+    /** @fn hcmRes parseStructuralVerilog(const vector<string>& fileNames, unsigned int numThreads = 0, hcmVerilogReader reader = VLOG_READER_BISON)
+     * @brief Parse Verilog files in to a design object.\n
+     * the files are parsed concurrently on up to \a numThreads threads, then linked together on the calling
+     * thread - a master may be defined in any of the files. the design is not touched until the link, so other
+     * designs may parse at the same time.
+     * @param fileNames - the names of the verilog files to be parsed
+     * @param numThreads - the most threads to parse on, 0 for the number of hardware threads
+     * @param reader - the parser to read the files with, both build the same design
+     * @return as the single file version, BAD_PARAM if all the files were read with no error\n
+     * OK if any of them can't be opened or has a syntax error, its modules before the error are still linked
+     */
+    hcmRes parseStructuralVerilog(const vector<string>& fileNames, unsigned int numThreads = 0,
+                                  hcmVerilogReader reader = VLOG_READER_BISON);
+
+    /** @fn void setParseCacheDir(const string& dir)
+     * @brief keeps the parsed form of the files read by parseStructuralVerilog() in the directory \a dir.\n
+     * an entry is named by the hash of the file text, so a file that did not change since any run that used the
+     * same cache is not parsed again, its modules are only linked. a file with a syntax error is never cached.
+     * @param dir - the cache directory, created if missing. empty to parse every file.
+     */
+    void setParseCacheDir(const string& dir);
+
+    /** @fn size_t getParseCacheHits() const
+     * @brief gets the number of files parseStructuralVerilog() read from the parse cache, over all its calls.
+     */
+    size_t getParseCacheHits() const;
+
+    /** @fn hcmRes addVerilogLibrary(const char *fileName)
+     * @brief indexes the modules of a Verilog library file without building them.\n
+     * a module of the library becomes a cell only when it is first used as a master or got by getCell(),
+     * so only the used part of a large library is read and built. a cell of the design, and the modules
+     * of libraries added before, take precedence over a module of the same name.
+     * @param fileName - the name of the verilog file holding only modules
+     * @return OK if the library was indexed\n
+     * BAD_PARAM if the file can't be read or holds anything but modules
+     */
+    hcmRes addVerilogLibrary(const char *fileName);
+
+    friend class hcmCell;
+    friend class hcmNode;
+    friend class hcmPort;
+    friend class hcmInstance;
+    friend class hcmInstPort;
 };
 
 
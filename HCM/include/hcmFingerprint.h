@@ -0,0 +1,79 @@
+#ifndef HCM_FINGERPRINT_H
+#define HCM_FINGERPRINT_H
+
+#include "hcm.h"
+#include <cstdint>
+#include <unordered_map>
+
+/*! \var typedef uint64_t hcmFingerprint
+    \brief a structural hash of a cell, equal for cells with the same structure.
+*/
+typedef uint64_t hcmFingerprint;
+
+/**
+ * A hcmFingerprinter computes a structural hash of cells, invariant to the names of the instances,
+ * the internal nodes and the cell itself.
+ * what a fingerprint does depend on:
+ *  - the names and directions of the ports and the names of the global nodes, they connect the cell
+ *    to the outside by name.
+ *  - the fingerprints of the masters of the instances and the master ports each node is connected to.
+ *  - the name of a leaf cell (a cell with no instances) - the function of a primitive is given by its name.
+ * nodes and instances are labeled by a few rounds of neighborhood refinement (Weisfeiler-Lehman style)
+ * with commutative sums, so a cell costs a linear pass over its nodes and instPorts.
+ * fingerprints are computed bottom-up and cached per cell. a cached fingerprint is reused as long as the
+ * generation of the cell and the fingerprints of its masters did not change, so an unchanged design
+ * costs one lookup per query and a change re-hashes only the changed cells and the cells above them.
+ * equal fingerprints mean equal structure with very high probability, different ones mean different structure.
+ * hcmFingerprinter is a mutable object.
+ */
+class hcmFingerprinter {
+  // RepInvariant:
+  	//  for each entry in cache - fp is the fingerprint of the cell at its generation gen with masters of mastersSig
+
+  // Abstraction Function:
+    //  design - the design the cells belong to.
+    //  globalNodes - names of nodes that are connected by name through the hierarchy.
+    //  cache - the last fingerprint computed for each cell.
+
+  private:
+    struct entry {
+      hcmFingerprint fp;
+      // gen - the generation of the cell when fp was computed.
+      hcmGeneration gen;
+      // mastersSig - a sum of the fingerprints of the masters fp was computed with.
+      hcmFingerprint mastersSig;
+      // checkedAt - the design generation fp was last verified at.
+      hcmGeneration checkedAt;
+    };
+
+    hcmDesign* design;
+    set<string> globalNodes;
+    unordered_map<const hcmCell*, entry> cache;
+
+    /** @fn hcmFingerprint compute(const hcmCell* cell)
+     * @brief hashes \a cell, the fingerprints of its masters must be in the cache.
+     */
+    hcmFingerprint compute(const hcmCell* cell);
+
+  public:
+    /** @fn hcmFingerprinter(hcmDesign* d, const set<string>& glbNodes)
+     * @brief constractor.
+     * @param d - the design of the cells to fingerprint.
+     * @param glbNodes - names of the global nodes (e.g VDD).
+     */
+    hcmFingerprinter(hcmDesign* d, const set<string>& glbNodes);
+
+    /** @fn hcmFingerprint getFingerprint(const hcmCell* cell)
+     * @brief gets the fingerprint of \a cell, computing it and the ones of the cells under it if needed.
+     * @return the fingerprint of the cell.
+     */
+    hcmFingerprint getFingerprint(const hcmCell* cell);
+
+    /** @fn map< hcmFingerprint, vector<const hcmCell*> > getClasses(const hcmCell* top)
+     * @brief groups \a top and all the cells under it by their fingerprint.
+     * @return a map from a fingerprint to the cells that have it, top first.
+     */
+    map< hcmFingerprint, vector<const hcmCell*> > getClasses(const hcmCell* top);
+};
+
+#endif
@@ -41,12 +41,37 @@ class hcmInstPort : public hcmObject {
      */
     ~hcmInstPort();  
 
+    /** @fn static void* operator new(size_t size, hcmDesign* design)
+     * @brief allocates a hcmInstPort from the instPortArena of \a design.
+     * @param size - the size of the object.
+     * @param design - the design owning the object.
+     * @return pointer to the memory of the object.
+     */
+    static void* operator new(size_t size, hcmDesign* design);
+
+    /** @fn static void operator delete(void* obj, hcmDesign* design)
+     * @brief returns the memory of a hcmInstPort which constructor failed.
+     */
+    static void operator delete(void* obj, hcmDesign* design);
+
+    /** @fn static void operator delete(void* obj)
+     * @brief returns the memory of a deleted hcmInstPort to its arena.
+     */
+    static void operator delete(void* obj);
+
     /** @fn void printInfo()
      * @brief print information about this hcmInstPort.
      * @return none
      */
     void printInfo();
 
+    /** @fn const string getName() const
+     * @brief gets the name of this hcmInstPort, <inst>%<port>, made from the names of its instance and port.\n
+     * the name is not interned, there is one per pin and it shares nothing with the other names.
+     * @return the name\n an empty string once the instPort is disconnected.
+     */
+    const string getName() const;
+
     /** @fn hcmNode *getNode() const
      * @brief gets a pointer to the connected node. this method doesn't change the state of the object
      * @return the pointer to ths connected node
@@ -74,6 +99,7 @@ class hcmInstPort : public hcmObject {
     void setConnectedNode(hcmNode *connectedNode);
 
     friend class hcmCell;
+    friend class hcmDesign;
 };
 
 #endif
@@ -22,6 +22,9 @@ class hcmInstance : public hcmObject {
 
     // instPorts - a mapping between the name of a instPort and the pointer to the hcmInstPort object
     map< string , hcmInstPort *> instPorts;
+    // instPortsByOrdinal - the instPorts indexed by the ordinal of their master port, NULL if not connected.
+    // may be shorter than the master port table if ports were added to the master later.
+    vector< hcmInstPort* > instPortsByOrdinal;
     // master - type of this instance (e.g AND2, NOR3...).
     hcmCell* master;
     // cell - the cell this instance is contained in, the owner (e.g Instance of AND2 is under Full-Adder cell).
@@ -35,6 +38,18 @@ class hcmInstance : public hcmObject {
      */
     void connectInstance(hcmCell* cell);
 
+    /** @fn const hcmPort* instPortMasterPort(string_view instPortName) const
+     * @brief gets the master port of the instPort named \a instPortName (e.g I1%A).
+     * @param instPortName - the name of the instPort.
+     * @return the port\n NULL if the name is not an instPort name of this instance.
+     */
+    const hcmPort* instPortMasterPort(string_view instPortName) const;
+
+    /** @fn void setInstPortByOrdinal(int ordinal, hcmInstPort* instPort)
+     * @brief sets the slot of master port \a ordinal in instPortsByOrdinal, growing it if needed.
+     */
+    void setInstPortByOrdinal(int ordinal, hcmInstPort* instPort);
+
   public:
 
     /** @fn hcmInstance(string instanceName, hcmCell* masterCell)
@@ -52,6 +67,24 @@ class hcmInstance : public hcmObject {
      */
     ~hcmInstance();
 
+    /** @fn static void* operator new(size_t size, hcmDesign* design)
+     * @brief allocates a hcmInstance from the instArena of \a design.
+     * @param size - the size of the object.
+     * @param design - the design owning the object.
+     * @return pointer to the memory of the object.
+     */
+    static void* operator new(size_t size, hcmDesign* design);
+
+    /** @fn static void operator delete(void* obj, hcmDesign* design)
+     * @brief returns the memory of a hcmInstance which constructor failed.
+     */
+    static void operator delete(void* obj, hcmDesign* design);
+
+    /** @fn static void operator delete(void* obj)
+     * @brief returns the memory of a deleted hcmInstance to its arena.
+     */
+    static void operator delete(void* obj);
+
     /** @fn void printInfo()
      * @brief print information about this object.
      * @return none
@@ -102,23 +135,47 @@ class hcmInstance : public hcmObject {
      */
     const map<string, hcmInstPort* >& getInstPorts() const;
 
-    /** @fn hcmInstPort* getInstPort(string name) 
-     * @brief gets a pointer of the port with identifier name
+    /** @fn hcmInstPort* getInstPort(string_view name) 
+     * @brief gets a pointer of the port with identifier name (e.g I1%A).\n
+     * the lookup goes through the design name table and doesn't allocate memory.
      * @param name - the name identifier of the desired port
      * @return pointer of the port with identifier name
      * @throws NullPointerException if the param is NULL
      */
-    hcmInstPort* getInstPort(string name);
+    hcmInstPort* getInstPort(string_view name);
 
-    /** @fn const hcmInstPort* getInstPort(string name) const
+    /** @fn const hcmInstPort* getInstPort(string_view name) const
      * @brief gets a const pointer of the port with identifier name
      * @param name - the name identifier of the desired port
      * @return const pointer of the port with identifier name
      * @throws NullPointerException if the param is NULL
      */
-    const hcmInstPort* getInstPort(string name) const;
+    const hcmInstPort* getInstPort(string_view name) const;
+
+    /** @fn hcmInstPort* getInstPort(const hcmPort* port)
+     * @brief gets the hcmInstPort connecting \a port of the master cell in this instance.\n
+     * the lookup is by the port ordinal and takes constant time.
+     * @param port - a port of the master cell.
+     * @return pointer to the hcmInstPort\n NULL if the port is not connected or is not a port of the master.
+     */
+    hcmInstPort* getInstPort(const hcmPort* port);
+
+    /** @fn const hcmInstPort* getInstPort(const hcmPort* port) const
+     * @brief gets the hcmInstPort connecting \a port of the master cell in this instance.
+     * @param port - a port of the master cell.
+     * @return const pointer to the hcmInstPort\n NULL if the port is not connected or is not a port of the master.
+     */
+    const hcmInstPort* getInstPort(const hcmPort* port) const;
+
+    /** @fn bool isConnected(const hcmPort* port) const
+     * @brief checks if \a port of the master cell is connected in this instance.
+     * @param port - a port of the master cell.
+     * @return true if there is a hcmInstPort for \a port.
+     */
+    bool isConnected(const hcmPort* port) const;
 
     friend class hcmCell;
+    friend class hcmDesign;
 };
 
 
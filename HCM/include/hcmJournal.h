@@ -0,0 +1,151 @@
+#ifndef HCM_JOURNAL_H
+#define HCM_JOURNAL_H
+
+#include "hcm_common.h"
+#include "hcmNameTable.h"
+#include <cstdint>
+
+class hcmCell;
+class hcmInstance;
+class hcmNode;
+class hcmPort;
+
+/*! \var typedef uint64_t hcmGeneration
+    \brief a counter of netlist changes, a larger value means a later change.
+*/
+typedef uint64_t hcmGeneration;
+
+/*! \var typedef enum hcmChangeTypes hcmChangeType
+    \brief the kinds of netlist changes reported by the hcmJournal.
+*/
+typedef enum hcmChangeTypes {
+  CELL_CREATED,       /**< a cell was added to the design.*/
+  CELL_DELETED,       /**< a cell is about to be deleted, after its content was.*/
+  NODE_CREATED,       /**< a node was added to a cell.*/
+  NODE_DELETED,       /**< a node is about to be deleted, after its instPorts and port were.*/
+  PORT_CREATED,       /**< a port was added to a node - the interface of the cell changed.*/
+  PORT_DELETED,       /**< a port is about to be deleted, after its instPorts were.*/
+  INST_CREATED,       /**< an instance was added to a cell.*/
+  INST_DELETED,       /**< an instance is about to be deleted, after its instPorts were.*/
+  CONNECTED,          /**< a port of an instance was connected to a node.*/
+  DISCONNECTED        /**< an instPort is about to be removed, it is still linked.*/
+} hcmChangeType;
+
+/**
+ * A hcmChange describes one netlist change as it happens.
+ * the pointers are valid during the notification only - the objects of a *_DELETED change are
+ * destroyed right after it. fields that don't apply to the change are NULL.
+ */
+struct hcmChange {
+  hcmChangeType type;
+  hcmGeneration generation;
+  hcmCell* cell;
+  hcmInstance* inst;
+  hcmNode* node;
+  hcmPort* port;
+};
+
+/**
+ * A hcmChangeRecord is a hcmChange kept in the journal log, the objects are kept by their name ids
+ * so the record stays meaningful after they are deleted.
+ */
+struct hcmChangeRecord {
+  hcmChangeType type;
+  hcmGeneration generation;
+  hcmNameId cell;
+  hcmNameId inst;
+  hcmNameId node;
+  hcmNameId port;
+};
+
+/**
+ * A hcmChangeListener is notified of every change of the design it is subscribed to.
+ * derived structures (a flat cell, a levelization, a CNF) use it to apply deltas instead of rebuilding.
+ */
+class hcmChangeListener {
+  public:
+    virtual ~hcmChangeListener() {}
+
+    /** @fn virtual void onChange(const hcmChange& change)
+     * @brief called after a creation or connection and before a deletion or disconnection.
+     * the listener must not change the netlist from the notification.
+     */
+    virtual void onChange(const hcmChange& change) = 0;
+};
+
+/**
+ * A hcmJournal counts the changes of a design and reports them.
+ * the generation counters are always kept - the design generation counts all the changes and each cell
+ * remembers the generation of its last change. listeners and the log are opt-in, with none of them
+ * a change costs two counter updates.
+ * changes done by the bulk teardown of the design are not reported.
+ * hcmJournal is a mutable object.
+ */
+class hcmJournal {
+  // RepInvariant:
+  	//  records are in increasing generation order
+
+  // Abstraction Function:
+    //  generation - the number of changes done to the design.
+    //  listeners - the subscribed listeners, notified in subscription order.
+    //  records - the changes done while recording.
+
+  private:
+    hcmGeneration generation;
+    vector<hcmChangeListener*> listeners;
+    bool recording;
+    vector<hcmChangeRecord> records;
+
+  public:
+    hcmJournal() : generation(0), recording(false) {}
+
+    /** @fn hcmGeneration getGeneration() const
+     * @brief gets the generation of the last change of the design.
+     */
+    hcmGeneration getGeneration() const { return generation; }
+
+    /** @fn void subscribe(hcmChangeListener* listener)
+     * @brief adds a listener, it is notified of all the changes from now on.
+     */
+    void subscribe(hcmChangeListener* listener);
+
+    /** @fn void unsubscribe(hcmChangeListener* listener)
+     * @brief removes a listener. must not be called from a notification.
+     */
+    void unsubscribe(hcmChangeListener* listener);
+
+    /** @fn void startRecording()
+     * @brief starts keeping the changes in the log.
+     */
+    void startRecording() { recording = true; }
+
+    /** @fn void stopRecording()
+     * @brief stops keeping the changes in the log, the log is kept.
+     */
+    void stopRecording() { recording = false; }
+
+    /** @fn const vector<hcmChangeRecord>& getRecords() const
+     * @brief gets the changes logged while recording.
+     */
+    const vector<hcmChangeRecord>& getRecords() const { return records; }
+
+    /** @fn size_t bytes() const
+     * @brief gets the heap bytes of the listeners and the log.
+     */
+    size_t bytes() const {
+      return listeners.capacity() * sizeof(hcmChangeListener*) + records.capacity() * sizeof(hcmChangeRecord);
+    }
+
+    /** @fn void clearRecords()
+     * @brief empties the log.
+     */
+    void clearRecords() { records.clear(); }
+
+    /** @fn void notify(hcmChangeType type, hcmCell* cell, hcmInstance* inst, hcmNode* node, hcmPort* port)
+     * @brief reports a change of the netlist in \a cell. called by the netlist objects.
+     * @return none
+     */
+    void notify(hcmChangeType type, hcmCell* cell, hcmInstance* inst, hcmNode* node, hcmPort* port);
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef HCM_MEMORY_H
+#define HCM_MEMORY_H
+
+#include "hcm_common.h"
+#include <cstddef>
+#include <ostream>
+
+// estimates of the heap bytes held by the standard containers (libstdc++ node layouts).
+
+/** @fn size_t hcmStringBytes(const string& s)
+ * @brief gets the heap payload of a string, 0 if it fits in the string itself.
+ */
+inline size_t hcmStringBytes(const string& s) {
+  return (s.capacity() > 15) ? s.capacity() + 1 : 0;
+}
+
+/** @fn size_t hcmMapBytes(const M& m)
+ * @brief gets the bytes of the tree nodes of a map or a set - color, parent and two children before the value.
+ */
+template <typename M>
+size_t hcmMapBytes(const M& m) {
+  return m.size() * (4 * sizeof(void*) + sizeof(typename M::value_type));
+}
+
+/** @fn size_t hcmHashBytes(const M& m)
+ * @brief gets the bytes of the buckets and nodes of an unordered map - next pointer and cached hash before the value.
+ */
+template <typename M>
+size_t hcmHashBytes(const M& m) {
+  return m.bucket_count() * sizeof(void*) + m.size() * (2 * sizeof(void*) + sizeof(typename M::value_type));
+}
+
+/** @fn size_t hcmVectorBytes(const V& v)
+ * @brief gets the bytes of the storage of a vector.
+ */
+template <typename V>
+size_t hcmVectorBytes(const V& v) {
+  return v.capacity() * sizeof(typename V::value_type);
+}
+
+/**
+ * A hcmMemoryUsage is the memory held by all the objects of one type.
+ */
+struct hcmMemoryUsage {
+  // count - the number of live objects.
+  size_t count;
+  // objectBytes - the objects themselves.
+  size_t objectBytes;
+  // containerBytes - the maps and vectors owned by the objects, but the instPorts maps.
+  size_t containerBytes;
+  // stringBytes - the heap payload of the names the objects keep. only the buses keep theirs, the names of
+  // the other objects are in the design name table (see hcmMemoryReport::nameTableBytes).
+  size_t stringBytes;
+  // instPortMapBytes - the instPorts maps of the nodes and instances.
+  size_t instPortMapBytes;
+
+  size_t total() const { return objectBytes + containerBytes + stringBytes + instPortMapBytes; }
+};
+
+/**
+ * A hcmMemoryReport is a snapshot of the memory held by a design, as returned by hcmDesign::memoryReport().
+ * the container sizes are estimates of the libstdc++ layouts and do not include the malloc overhead.
+ * property values are counted by their column storage, heap data held by the values themselves is not.
+ */
+struct hcmMemoryReport {
+  hcmMemoryUsage cells;
+  hcmMemoryUsage nodes;
+  hcmMemoryUsage ports;
+  hcmMemoryUsage instances;
+  hcmMemoryUsage instPorts;
+  hcmMemoryUsage buses;
+  // arenaOverheadBytes - slot headers, free slots and the unused tails of the arena chunks.
+  size_t arenaOverheadBytes;
+  // propertyBytes - the property columns and the object id free list.
+  size_t propertyBytes;
+  // nameTableBytes - the names and the lookup index of the design name table.
+  size_t nameTableBytes;
+  // nameTableNames/nameTableHitRate - the names in the table and the part of the interns that found their name.
+  // the names count the parent paths of the hierarchical names too (see hcmNameTable::size()), so there
+  // may be more names than named objects.
+  size_t nameTableNames;
+  double nameTableHitRate;
+  // designBytes - the design object, its cell indexes and the journal log.
+  size_t designBytes;
+
+  /** @fn size_t totalBytes() const
+   * @brief gets the bytes of the design.
+   */
+  size_t totalBytes() const;
+
+  /** @fn void print(ostream& os) const
+   * @brief prints the report, with the bytes per instance.
+   */
+  void print(ostream& os) const;
+};
+
+/**
+ * A hcmAllocStats counts the heap allocations done during an allocation phase.
+ */
+struct hcmAllocStats {
+  size_t allocs;
+  size_t bytes;
+};
+
+/**
+ * A hcmAllocPhase attributes the heap allocations done during its life time to a named phase
+ * (e.g parse, flatten, encode). phases nest - the inner phase gets the allocations until it ends.
+ * allocations are counted only when the library is built with HCM_ALLOC_HOOK defined
+ * (make HCM_DEFS=-DHCM_ALLOC_HOOK), which replaces the global operator new. otherwise phases count nothing.
+ * the current phase is kept per thread, several threads may count into the same phase at once.
+ * hcmAllocPhase is a mutable object.
+ */
+class hcmAllocPhase {
+  private:
+    hcmAllocStats* prev;
+
+  public:
+    /** @fn hcmAllocPhase(const string& name)
+     * @brief starts counting the allocations of this thread into phase \a name, adding to earlier counts of the phase.
+     */
+    hcmAllocPhase(const string& name);
+
+    /** @fn ~hcmAllocPhase()
+     * @brief goes back to counting into the enclosing phase.
+     */
+    ~hcmAllocPhase();
+
+    /** @fn static bool enabled()
+     * @brief checks if the library was built with the allocation hook.
+     */
+    static bool enabled();
+
+    /** @fn static map<string, hcmAllocStats> getStats()
+     * @brief gets the counters of all the phases by their name.
+     */
+    static map<string, hcmAllocStats> getStats();
+
+    /** @fn static void reset()
+     * @brief zeroes the counters of all the phases.
+     */
+    static void reset();
+};
+
+#endif
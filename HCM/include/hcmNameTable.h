@@ -0,0 +1,160 @@
+#ifndef HCM_NAME_TABLE_H
+#define HCM_NAME_TABLE_H
+
+#include "hcm_common.h"
+#include "hcmStringPool.h"
+
+/*! \var typedef int hcmNameId
+    \brief dense integer identifier of a name interned in a hcmNameTable.
+*/
+typedef int hcmNameId;
+
+/*! \def HCM_NO_NAME
+    \brief the hcmNameId of a name that was never interned.
+*/
+#define HCM_NO_NAME -1
+
+/**
+ * A hcmNameTable is the design-wide symbol table.
+ * every name used by the design objects is stored once and is given a dense integer id.
+ * a hierarchical name is stored as its parent path and its leaf - "u1/u2/n5" is the path "u1/u2" and the
+ * leaf "n5", and the leaves are stored once, so the flat names of an occurrence share their prefix and the
+ * names of the occurrences of a master share their leaves. the full string is only made by getName().
+ * the design objects keep only the id of their name, the cell, node and instance maps are keyed by the
+ * full names as a lookup index.
+ * the parent paths are names of their own, they take ids and are counted by size().
+ * ids are never reused - a name stays in the table for the life time of the design.
+ * hcmNameTable is a mutable object.
+ */
+class hcmNameTable {
+  // RepInvariant:
+  	//  names[i].parent < i, ids[key(names[i].parent, names[i].leaf)] == i for each 0 <= i < names.size()
+
+  // Abstraction Function:
+    //  leaves - the last segments of the names, after their last '/'.
+    //  names - the names by their id, the id of the parent path (HCM_NO_NAME if none) and the leaf id.
+    //  ids - a mapping between the parent path and leaf of a name and its id.
+    //  lastPath/lastPathId - the parent path of the last interned name, the next names are usually of the same path.
+    //  stats - the counters of the interned names, the bytes are the bytes of the leaves.
+  private:
+    struct pathName {
+      hcmNameId parent;
+      int leaf;
+    };
+
+    hcmStringPool leaves;
+    vector<pathName> names;
+    unordered_map<uint64_t, hcmNameId> ids;
+    string lastPath;
+    hcmNameId lastPathId;
+    hcmStringPoolStats stats;
+
+    /** @fn hcmNameId addName(hcmNameId parent, string_view leaf)
+     * @brief gets the id of \a leaf under \a parent, adding it if needed, not counted in the stats.
+     */
+    hcmNameId addName(hcmNameId parent, string_view leaf);
+
+    /** @fn hcmNameId internPath(string_view name)
+     * @brief gets the id of \a name, adding it and its parent paths if needed, not counted in the stats.
+     */
+    hcmNameId internPath(string_view name);
+
+    /** @fn void count(size_t numNames, hcmNameId id)
+     * @brief counts an intern that got \a id when the table had \a numNames names.
+     */
+    void count(size_t numNames, hcmNameId id);
+
+  public:
+    /** @fn hcmNameTable()
+     * @brief hcmNameTable constractor, the table is empty.
+     */
+    hcmNameTable();
+
+    /** @fn hcmNameId intern(string_view name)
+     * @brief gets the id of \a name, adding it to the table if it is not there yet.\n
+     * the parent paths of a hierarchical name are interned too, they are names of their own.
+     * @param name - the name to intern.
+     * @return the id of the name.
+     */
+    hcmNameId intern(string_view name);
+
+    /** @fn hcmNameId intern(hcmNameId parent, string_view leaf)
+     * @brief gets the id of the name \a leaf under the path \a parent, as intern() of "parent/leaf".
+     * @param parent - the id of the parent path, HCM_NO_NAME for a name with no path.
+     * @param leaf - the last segment of the name, without a '/'.
+     * @return the id of the name.
+     */
+    hcmNameId intern(hcmNameId parent, string_view leaf);
+
+    /** @fn hcmNameId find(string_view name) const
+     * @brief gets the id of \a name without adding it. this method doesn't allocate memory.
+     * @param name - the name to look for.
+     * @return the id of the name\n HCM_NO_NAME if the name was never interned.
+     */
+    hcmNameId find(string_view name) const;
+
+    /** @fn string getName(hcmNameId id) const
+     * @brief makes the full name represented by \a id, its path and leaf joined by '/'.\n
+     * the name is built on each call, it used to be a string_view into the table. use getLeaf() or
+     * appendName() where a copy of the name is not wanted.
+     * @param id - an id returned by intern().
+     * @return the name represented by \a id.
+     */
+    string getName(hcmNameId id) const;
+
+    /** @fn void appendName(hcmNameId id, string& out) const
+     * @brief appends the full name represented by \a id to \a out.
+     */
+    void appendName(hcmNameId id, string& out) const;
+
+    /** @fn size_t nameSize(hcmNameId id) const
+     * @brief gets the length of the full name represented by \a id, without making it.
+     */
+    size_t nameSize(hcmNameId id) const;
+
+    /** @fn bool isPrefixOf(hcmNameId id, string_view s) const
+     * @brief checks if \a s starts with the full name represented by \a id, without making it.
+     */
+    bool isPrefixOf(hcmNameId id, string_view s) const;
+
+    /** @fn hcmNameId getParent(hcmNameId id) const
+     * @brief gets the id of the parent path of the name \a id.
+     * @return the id of the path\n HCM_NO_NAME if the name has no '/'.
+     */
+    hcmNameId getParent(hcmNameId id) const { return names[id].parent; }
+
+    /** @fn string_view getLeaf(hcmNameId id) const
+     * @brief gets the last segment of the name \a id, it is valid for the life time of the table.
+     */
+    string_view getLeaf(hcmNameId id) const { return leaves.get(names[id].leaf); }
+
+    /** @fn bool isUnder(hcmNameId id, hcmNameId path) const
+     * @brief checks if the name \a id is \a path or a name below it, by the ids only.
+     */
+    bool isUnder(hcmNameId id, hcmNameId path) const;
+
+    /** @fn int compare(hcmNameId a, hcmNameId b) const
+     * @brief compares the full names of \a a and \a b as strings, without making them.
+     * @return a negative number, 0 or a positive number as the name of \a a is before, equal or after the name of \a b.
+     */
+    int compare(hcmNameId a, hcmNameId b) const;
+
+    /** @fn size_t size() const
+     * @brief gets the number of interned names, with the parent paths of the hierarchical names.\n
+     * interning "a/b/c" alone adds 3 names - "a", "a/b" and "a/b/c".
+     * @return the number of interned names.
+     */
+    size_t size() const;
+
+    /** @fn size_t bytes() const
+     * @brief gets an estimate of the heap bytes held by the table.
+     */
+    size_t bytes() const;
+
+    /** @fn const hcmStringPoolStats& getStats() const
+     * @brief gets the intern counters of the table - lookups, hits and the bytes of the leaves.
+     */
+    const hcmStringPoolStats& getStats() const;
+};
+
+#endif
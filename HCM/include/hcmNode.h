@@ -33,6 +33,10 @@ class hcmNode : public hcmObject {
     // cell represent the owner cell this hcmNode is contained in. cell can't be null.
     hcmCell* cell; 
 
+    // bus - the bus this node is a bit of, NULL for a scalar node. busIndex - the bit index in the bus.
+    hcmBus* bus;
+    int busIndex;
+
     /** @fn bool connectPort(hcmInstPort* instPort)
      * @brief connect this hcmNode port to the given instPort. doesn't change this hcmNode instPorts
      * @param instPort - the instPort to connect to this hcmNode port instPorts
@@ -63,6 +67,24 @@ class hcmNode : public hcmObject {
      */
     ~hcmNode();
 
+    /** @fn static void* operator new(size_t size, hcmDesign* design)
+     * @brief allocates a hcmNode from the nodeArena of \a design.
+     * @param size - the size of the object.
+     * @param design - the design owning the object.
+     * @return pointer to the memory of the object.
+     */
+    static void* operator new(size_t size, hcmDesign* design);
+
+    /** @fn static void operator delete(void* obj, hcmDesign* design)
+     * @brief returns the memory of a hcmNode which constructor failed.
+     */
+    static void operator delete(void* obj, hcmDesign* design);
+
+    /** @fn static void operator delete(void* obj)
+     * @brief returns the memory of a deleted hcmNode to its arena.
+     */
+    static void operator delete(void* obj);
+
     /** @fn void printInfo()
      * @brief print information about this port.
      * @return none
@@ -100,6 +122,17 @@ class hcmNode : public hcmObject {
      */ 
     const hcmPort* getPort() const;
 
+    /** @fn hcmBus* getBus() const
+     * @brief gets the bus this hcmNode is a bit of.
+     * @return the bus\n NULL if the node was not created as a bus bit.
+     */
+    hcmBus* getBus() const;
+
+    /** @fn int getBusIndex() const
+     * @brief gets the bit index of this hcmNode in its bus, meaningful only if getBus() is not NULL.
+     */
+    int getBusIndex() const;
+
     /** @fn map<string, hcmInstPort* > &getInstPorts()
      * @brief gets a pointer to the InstPorts map. each element in the map repersent a connection from the name (e.g CellA_I2/P7) to the instance of "hcmInstPort".
      * @return return a pointer to the InstPorts map
@@ -113,6 +146,7 @@ class hcmNode : public hcmObject {
     const map<string, hcmInstPort* >& getInstPorts() const;
 
     friend class hcmCell;
+    friend class hcmDesign;
 };
 
 
@@ -2,37 +2,51 @@
 #define HCM_OBJECT_H
 
 #include "hcm_common.h"
+#include "hcmNameTable.h"
+#include "hcmPropStore.h"
 
 /**
  * A hcmObject is prototype for all classes to inheritance from
- * holds a container of the object properties and the object name.
+ * holds the id of the object name in the name table of its design and its id in the property columns.
+ * the name is not kept as a string - getName() makes it from the table, where a hierarchical name is
+ * a shared parent path and a leaf.
  * hcmObject is a mutable object.
  */
 class hcmObject {
 
   // RepInvariant:
-  	// (name != null) 
+  	// (nameTable == NULL || nameId != HCM_NO_NAME)
 
   // Abstraction Function: 
-    // name repersent the name of this object                                 
+    // nameTable/nameId represent the name of this object
     // destructorCalled is a flag represent is the distractor was called 
 
-  private:
-    // props - container of tuples of type (string, hcmProperty*) - 
-    // for each tuple, the string repersent the name of the template class (e.g DelayClass) that hcmProperty* is built with,
-    // and the hcmProperty* is a reference for the hcmProperty class was build with that type corresponds to the name.
-    map< string, hcmProperty* > props;
-
-    // propNameToType - container of tuples of type (string, string) - 
-    // for each tuple, the first string represent the name of the property (e.g Delay), 
-    // and the second string represent the name of the type class this property is build from (e.g DelayClass).
-    map< string, string > propNameToType;
-    
   protected:
-    // name repersent the name of this object                                 
-    string name;
+    // nameTable - the name table of the design this object belongs to, NULL if the name is not interned.
+    const hcmNameTable* nameTable;
+    // nameId - the id of the name in nameTable, HCM_NO_NAME if not interned
+    hcmNameId nameId;
     // destructorCalled is a flag represent is the distractor was called 
     bool destructorCalled;
+    // propStore - the property columns of the design this object belongs to, NULL if not registered.
+    hcmPropStore* propStore;
+    // objId - the id of this object in propStore, HCM_NO_OBJ if not registered.
+    hcmObjId objId;
+
+    /** @fn void registerProps(hcmPropStore* store)
+     * @brief registers this object in the property store of its design and gets its object id.
+     * @param store - the property store of the design.
+     * @return none
+     */
+    void registerProps(hcmPropStore* store);
+
+    /** @fn void setName(hcmNameTable& table, string_view objName)
+     * @brief interns \a objName in the name table of the design and keeps its id as the name of this object.
+     * @param table - the name table of the design.
+     * @param objName - the name of this object.
+     * @return none
+     */
+    void setName(hcmNameTable& table, string_view objName);
 
   public:
     /** @fn hcmObject()
@@ -48,14 +62,76 @@ class hcmObject {
     ~hcmObject();
     
     /** @fn const string getName() const
-     * @brief gets the name of this hcmObject.
+     * @brief gets the name of this hcmObject, made from the design name table on each call.
      * @return a constant string represent the name of this hcmObject.
      */
     const string getName() const;
 
+    /** @fn hcmNameId getNameId() const
+     * @brief gets the id of the name of this hcmObject in the design name table.
+     * @return the id of the name\n HCM_NO_NAME if the name is not interned.
+     */
+    hcmNameId getNameId() const;
+
+    /** @fn hcmObjId getObjId() const
+     * @brief gets the id of this hcmObject in the property columns of its design.
+     * @return the object id\n HCM_NO_OBJ if the object is not registered in a design.
+     */
+    hcmObjId getObjId() const;
+
+    /** @fn hcmRes getProp(const hcmPropKey<T>& key, T& value) const
+     * @brief gets the value of the property \a key of this object.
+     * @param key - the typed key of the property.
+     * @param value - reference for value of type T to contain the desire value.
+     * @return OK if property was found\n
+     * NOT_FOUND if the object has no value for \a key.
+     */
+    template <typename T>
+    hcmRes getProp(const hcmPropKey<T>& key, T& value) const {
+      const hcmPropColumn<T>* col = propStore ? propStore->findColumn<T>(key.getId()) : NULL;
+      if(col == NULL || !col->has(objId)) {
+        return NOT_FOUND;
+      }
+      value = col->value(objId);
+      return OK;
+    }
+
+    /** @fn hcmRes setProp(const hcmPropKey<T>& key, T value)
+     * @brief sets the value of the property \a key of this object.
+     * @param key - the typed key of the property.
+     * @param value - the value to set.
+     * @return OK in case the value was set.\n
+     * NOT_FOUND if the object is not registered in a design.\n
+     * PROPERTY_EXISTS_WITH_DIFFERENT_TYPE - in case the object has the property name with diffrent type.
+     */
+    template <typename T>
+    hcmRes setProp(const hcmPropKey<T>& key, T value) {
+      if(propStore == NULL) {
+        return NOT_FOUND;
+      }
+      if(propStore->hasOtherType(key.getId(), objId)) {
+        return PROPERTY_EXISTS_WITH_DIFFERENT_TYPE;
+      }
+      propStore->column(key).set(objId, value);
+      return OK;
+    }
+
+    /** @fn hcmRes delProp(const hcmPropKey<T>& key)
+     * @brief removes the value of the property \a key of this object.
+     * @param key - the typed key of the property.
+     * @return OK in case the value was removed.\n
+     * NOT_FOUND in case the object has no value for \a key.\n
+     * PROPERTY_EXISTS_WITH_DIFFERENT_TYPE in case the object has the property name with diffrent type.
+     */
+    template <typename T>
+    hcmRes delProp(const hcmPropKey<T>& key) {
+      return delPropById<T>(key.getId());
+    }
+
     /** @fn hcmRes getProp(string name, T& value)
      * @brief tamplate method - finds the property if exist ,
-     *        and insert into the given parmter "value" the value of the typed property
+     *        and insert into the given parmter "value" the value of the typed property.\n
+     * compatibility form of getProp(const hcmPropKey<T>&, T&), the key is looked up by name and type.
      * @param name - name of type string, which represents the wanted property to get
      * @param value - reference for value of type T to contain the desire value. 
      * @return OK if property was found\n
@@ -63,24 +139,18 @@ class hcmObject {
      */
     template <typename T>
     hcmRes getProp(string name, T& value) {
-      // typeid(T).name() - built-in function that gets the name of the class T (e.g DelayClass).
-      if(props.count(typeid(T).name())) {
-        hcmTypedProperty<T>* typedProp = dynamic_cast<hcmTypedProperty<T>*>(props[typeid(T).name()]);
-        if(typedProp == NULL) {
-          cout << "ERROR: NULL TYPED PROP" << endl;
-          return NOT_FOUND;
-        }
-        T* r = typedProp->get(name);
-        if(r!= NULL) {
-          value = *r;
-          return OK;
-        }
+      int keyId = hcmPropKeyBase::findKey(name, typeid(T).name());
+      const hcmPropColumn<T>* col = (propStore && keyId != -1) ? propStore->findColumn<T>(keyId) : NULL;
+      if(col == NULL || !col->has(objId)) {
+        return NOT_FOUND;
       }
-      return NOT_FOUND;
+      value = col->value(objId);
+      return OK;
     }
 
     /** @fn hcmRes setProp(string name, T value)
-     * @brief Create and add hcmTypedProperty.
+     * @brief Create and add hcmTypedProperty.\n
+     * compatibility form of setProp(const hcmPropKey<T>&, T), the key is registered on first use.
      * @param name - name of the new hcmTypedProperty.
      * @param value - class type of the new hcmTypedProperty.
      * @return OK in case we were able to add the new hcmTypedProperty.\n 
@@ -88,22 +158,12 @@ class hcmObject {
      */
     template <typename T>
     hcmRes setProp(string name, T value) {
-      string typeName = typeid(T).name();
-      if(propNameToType.count(name) && propNameToType[name]!=typeName ) {
-      return PROPERTY_EXISTS_WITH_DIFFERENT_TYPE;
-      }
-      if(props.count(typeName)==0) {
-      props[typeName] = new hcmTypedProperty<T>();
-      }
-      hcmProperty* prop = props[typeName];
-      hcmTypedProperty<T>* typedProp = dynamic_cast<hcmTypedProperty<T>*>(prop);
-      typedProp->add(name,value);
-      propNameToType[name] = typeName;
-      return OK;
+      return setProp(hcmPropKey<T>(name), value);
     }
 
     /** @fn hcmRes delProp(string name)
-     * @brief remove the hcmTypedProperty represented by name.
+     * @brief remove the hcmTypedProperty represented by name.\n
+     * compatibility form of delProp(const hcmPropKey<T>&).
      * @param name - the name of the hcmTypedProperty.
      * @return OK in case we removed the hcmTypedProperty successfully.\n 
      * NOT_FOUND in case the hcmTypedProperty was not found.\n 
@@ -111,18 +171,34 @@ class hcmObject {
      */
     template <typename T>
     hcmRes delProp(string name) {
-      if(propNameToType.count(name) == 0) {
-      return NOT_FOUND;
+      int keyId = hcmPropKeyBase::findKey(name, typeid(T).name());
+      if(keyId == -1) {
+        // no key of type T, the name may still be set with another type
+        return propHasName(name) ? PROPERTY_EXISTS_WITH_DIFFERENT_TYPE : NOT_FOUND;
       }
-      if(propNameToType[name] != typeid(T).name()) {
-      return PROPERTY_EXISTS_WITH_DIFFERENT_TYPE;
+      return delPropById<T>(keyId);
+    }
+
+  private:
+    /** @fn hcmRes delPropById(int keyId)
+     * @brief removes the value of the key \a keyId of type T of this object.
+     */
+    template <typename T>
+    hcmRes delPropById(int keyId) {
+      hcmPropColumn<T>* col = propStore ? propStore->findColumn<T>(keyId) : NULL;
+      if(col && col->erase(objId)) {
+        return OK;
       }
-      hcmTypedProperty<T>* typedProp = 
-      dynamic_cast<hcmTypedProperty<T>*>(props[propNameToType[name]]);
-      typedProp->remove(name);
-      return OK;
+      if(propStore && propStore->hasOtherType(keyId, objId)) {
+        return PROPERTY_EXISTS_WITH_DIFFERENT_TYPE;
+      }
+      return NOT_FOUND;
     }
 
+    /** @fn bool propHasName(const string& name) const
+     * @brief checks if this object has a value for any key named \a name.
+     */
+    bool propHasName(const string& name) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,148 @@
+#ifndef HCM_OCC_ITERATOR_H
+#define HCM_OCC_ITERATOR_H
+
+#include "hcm.h"
+#include <unordered_map>
+
+/**
+ * A hcmOccNet is the top-most net an occurrence node resolves to.
+ * frame is the depth on the current path of the cell occurrence holding the net (0 for the top cell)
+ * and node is the node of that cell. frameSerial tells apart occurrences of the same cell at the same depth.
+ * a global node with no node of the same name in the top cell has global set, it is identified by its name.
+ */
+struct hcmOccNet {
+  int frame;
+  long frameSerial;
+  const hcmNode* node;
+  bool global;
+
+  bool operator==(const hcmOccNet& o) const {
+    return global == o.global && (global ? node->getName() == o.node->getName() :
+                                           frameSerial == o.frameSerial && node == o.node);
+  }
+  bool operator!=(const hcmOccNet& o) const { return !(*this == o); }
+};
+
+/**
+ * A hcmOccIterator walks the occurrences of a folded hierarchy without flattening it.
+ * it visits the cell occurrences (frames) in depth first order, instances of a cell in name order -
+ * the order hcmFlatten() creates the flat instances in.
+ * nextLeaf() visits the (instance path, leaf instance) occurrences, nextFrame() every cell occurrence,
+ * with the nodes of its cell giving the (instance path, node) occurrences.
+ * nodes are resolved to their top-most net the way hcmFlatten() names the flat nodes,
+ * and each (frame, node) resolution is computed once while its frame is on the path.
+ * the iterator holds pointers into the design - the hierarchy must not change while it is used.
+ * hcmOccIterator is a mutable object.
+ */
+class hcmOccIterator {
+  // RepInvariant:
+  	//  frames[0].cell == top
+  	//  frames[d].inst->masterCell() == frames[d].cell for d > 0
+
+  // Abstraction Function:
+    //  frames - the current path, frames[0] is the top cell and frames[d] is the occurrence of the
+    //           master of frames[d].inst under frames[d-1].
+    //  globalNodes - names of nodes that are connected by name at any level.
+
+  private:
+    struct frame {
+      const hcmInstance* inst;
+      const hcmCell* cell;
+      long serial;
+      // next - the next instance of cell to dive into.
+      map<string, hcmInstance*>::const_iterator next;
+      // memo - the nets of the nodes of cell already resolved in this occurrence.
+      unordered_map<const hcmNode*, hcmOccNet> memo;
+    };
+
+    const hcmCell* top;
+    const set<string>& globalNodes;
+    vector<frame> frames;
+    long serials;
+    bool started;
+
+    /** @fn void push(const hcmInstance* inst, const hcmCell* cell)
+     * @brief adds a frame for an occurrence of \a cell to the path.
+     */
+    void push(const hcmInstance* inst, const hcmCell* cell);
+
+    /** @fn bool resolve(int d, const hcmNode* node, hcmOccNet& net)
+     * @brief resolves \a node of the cell of frame \a d, memoized per frame.
+     * @return true on success\n false if the node reaches a port that is not connected on its instance.
+     */
+    bool resolve(int d, const hcmNode* node, hcmOccNet& net);
+
+    /** @fn void makeNet(int d, const hcmNode* node, hcmOccNet& net) const
+     * @brief fills \a net with \a node of frame \a d.
+     */
+    void makeNet(int d, const hcmNode* node, hcmOccNet& net) const;
+
+  public:
+    /** @fn hcmOccIterator(const hcmCell* topCell, const set<string>& globalNodes)
+     * @brief hcmOccIterator constractor. the iterator starts before the first occurrence.
+     * @param topCell - the top of the hierarchy to walk.
+     * @param globalNodes - names of the global nodes, kept by reference.
+     */
+    hcmOccIterator(const hcmCell* topCell, const set<string>& globalNodes);
+
+    /** @fn bool nextFrame()
+     * @brief moves to the next cell occurrence, the first call gives the top cell.
+     * @return true if there is one\n false when the walk is over.
+     */
+    bool nextFrame();
+
+    /** @fn bool nextLeaf()
+     * @brief moves to the next occurrence of a cell with no instances under the top cell.
+     * @return true if there is one\n false when the walk is over.
+     */
+    bool nextLeaf();
+
+    /** @fn int depth() const
+     * @brief gets the depth of the current occurrence, 0 for the top cell.
+     */
+    int depth() const { return frames.size() - 1; }
+
+    /** @fn const hcmCell* cell() const
+     * @brief gets the cell of the current occurrence.
+     */
+    const hcmCell* cell() const { return frames.back().cell; }
+
+    /** @fn const hcmInstance* inst(int d) const
+     * @brief gets the instance of level \a d of the current path, 1 <= d <= depth().
+     */
+    const hcmInstance* inst(int d) const { return frames[d].inst; }
+
+    /** @fn string getHName(int d) const
+     * @brief gets the hierarchical name of the path down to level \a d (e.g I1/I7).
+     */
+    string getHName(int d) const;
+
+    /** @fn string getHName() const
+     * @brief gets the hierarchical name of the current occurrence, the flat instance name of a leaf.
+     */
+    string getHName() const { return getHName(depth()); }
+
+    /** @fn bool getNodeNet(const hcmNode* node, hcmOccNet& net)
+     * @brief resolves a node of the current cell to its top-most net.
+     * @param node - a node of cell().
+     * @param net - filled with the net on success.
+     * @return true on success\n false if the node reaches a port that is not connected.
+     */
+    bool getNodeNet(const hcmNode* node, hcmOccNet& net);
+
+    /** @fn bool getPinNet(const hcmNode* node, hcmOccNet& net)
+     * @brief resolves a port node of the current leaf to the net its instance pin is on,
+     * the node hcmFlatten() connects the flat instance to.
+     * @param node - a node of cell().
+     * @param net - filled with the net on success.
+     * @return true on success\n false if the node has no port or the port is not connected.
+     */
+    bool getPinNet(const hcmNode* node, hcmOccNet& net);
+
+    /** @fn string getNetHName(const hcmOccNet& net) const
+     * @brief gets the flat name of a net resolved on the current path.
+     */
+    string getNetHName(const hcmOccNet& net) const;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef HCM_OCC_TREE_H
+#define HCM_OCC_TREE_H
+
+#include "hcm.h"
+#include <cstdint>
+#include <unordered_map>
+
+/*! \var typedef uint64_t hcmOccId
+    \brief dense identifier of an instance occurrence or a node occurrence in a hcmOccTree.
+*/
+typedef uint64_t hcmOccId;
+
+/*! \def HCM_NO_OCC
+    \brief the hcmOccId returned for a path that is not an occurrence of the tree.
+*/
+#define HCM_NO_OCC ((hcmOccId)-1)
+
+/**
+ * A hcmOccTree numbers all the instance occurrences and node occurrences under a top cell densely.
+ * only per cell data is kept - the number of occurrences under one occurrence of the cell and the
+ * prefix offsets of its instances - so the tree is as small as the folded design.
+ * instance occurrences are numbered depth first, instances of a cell in name order, the order
+ * hcmFlatten() creates the flat instances in. node occurrences are numbered the same way, the nodes
+ * of a cell occurrence (in name order) before the occurrences under its instances.
+ * converting between an id and its path takes one step per hierarchy level - a hash lookup from path
+ * to id, a binary search over the instances of the cell from id to path. names are built on request.
+ * the tree holds pointers into the design - it has to be rebuilt if the hierarchy changes.
+ * hcmOccTree is an immutable object.
+ */
+class hcmOccTree {
+  // RepInvariant:
+  	//  for each cell info - instPrefix.size() == nodePrefix.size() == insts.size() + 1
+  	//  instPrefix.back() == instCount && nodePrefix.back() == nodeCount
+
+  // Abstraction Function:
+    //  top - the root of the tree, its own nodes are node occurrences 0..|nodes|-1.
+    //  infos - the numbering data of every cell under top.
+
+  private:
+    struct cellInfo {
+      // insts/nodes - the instances and nodes of the cell in map order.
+      vector<const hcmInstance*> insts;
+      vector<const hcmNode*> nodes;
+      // instPrefix[k] - id of instance k relative to the first instance occurrence under the cell.
+      // the occurrences under instance k follow it, so instPrefix[k+1] = instPrefix[k] + 1 + count of its master.
+      vector<hcmOccId> instPrefix;
+      // nodePrefix[k] - first node occurrence under instance k relative to the first node of the cell,
+      // nodePrefix[0] == nodes.size().
+      vector<hcmOccId> nodePrefix;
+      // instCount/nodeCount - the number of occurrences under (and, for nodes, in) one occurrence of the cell.
+      hcmOccId instCount;
+      hcmOccId nodeCount;
+      unordered_map<const hcmInstance*, int> instIdx;
+      unordered_map<const hcmNode*, int> nodeIdx;
+    };
+
+    const hcmCell* top;
+    unordered_map<const hcmCell*, cellInfo> infos;
+
+    /** @fn const cellInfo& build(const hcmCell* cell)
+     * @brief computes the info of \a cell and of all the cells under it, once per cell.
+     */
+    const cellInfo& build(const hcmCell* cell);
+
+    /** @fn const cellInfo* step(const cellInfo* info, const hcmInstance* inst, hcmOccId& instBase, hcmOccId& nodeBase) const
+     * @brief moves from an occurrence of a cell down to its instance \a inst.
+     * @param instBase - the id of the first instance occurrence under the cell, updated to the one under inst.
+     * @param nodeBase - the id of the first node occurrence of the cell, updated to the one of the master.
+     * @return the info of the master of \a inst\n NULL if \a inst is not an instance of the cell.
+     */
+    const cellInfo* step(const cellInfo* info, const hcmInstance* inst, hcmOccId& instBase, hcmOccId& nodeBase) const;
+
+  public:
+    /** @fn hcmOccTree(const hcmCell* topCell)
+     * @brief builds the numbering of all the occurrences under \a topCell.
+     * @param topCell - the root of the tree.
+     */
+    hcmOccTree(const hcmCell* topCell);
+
+    /** @fn hcmOccId numInstOccs() const
+     * @brief gets the number of instance occurrences, ids are 0..numInstOccs()-1.
+     */
+    hcmOccId numInstOccs() const;
+
+    /** @fn hcmOccId numNodeOccs() const
+     * @brief gets the number of node occurrences, ids are 0..numNodeOccs()-1.
+     */
+    hcmOccId numNodeOccs() const;
+
+    /** @fn hcmOccId getInstOccId(It begin, It end) const
+     * @brief gets the id of the instance occurrence given by a path of instances from the top cell down.
+     * @return the id\n HCM_NO_OCC if the path is empty or is not a path of the tree.
+     */
+    template <typename It>
+    hcmOccId getInstOccId(It begin, It end) const {
+      if (begin == end) {
+        return HCM_NO_OCC;
+      }
+      const cellInfo* info = &infos.at(top);
+      hcmOccId instBase = 0, nodeBase = 0, id = HCM_NO_OCC;
+      for (It it = begin; it != end && info; ++it) {
+        info = step(info, *it, instBase, nodeBase);
+        // the occurrence itself is right before the ones under it
+        id = instBase - 1;
+      }
+      return info ? id : HCM_NO_OCC;
+    }
+
+    /** @fn hcmOccId getNodeOccId(It begin, It end, const hcmNode* node) const
+     * @brief gets the id of the occurrence of \a node under the path of instances [begin, end).
+     * @return the id\n HCM_NO_OCC if the path is not a path of the tree or the node is not in its cell.
+     */
+    template <typename It>
+    hcmOccId getNodeOccId(It begin, It end, const hcmNode* node) const {
+      const cellInfo* info = &infos.at(top);
+      hcmOccId instBase = 0, nodeBase = 0;
+      for (It it = begin; it != end && info; ++it) {
+        info = step(info, *it, instBase, nodeBase);
+      }
+      if (info == NULL) {
+        return HCM_NO_OCC;
+      }
+      auto nI = info->nodeIdx.find(node);
+      return (nI == info->nodeIdx.end()) ? HCM_NO_OCC : nodeBase + nI->second;
+    }
+
+    /** @fn bool getInstOccPath(hcmOccId id, vector<const hcmInstance*>& path) const
+     * @brief gets the path of instances from the top cell down to the instance occurrence \a id.
+     * @return true on success\n false if \a id is out of range.
+     */
+    bool getInstOccPath(hcmOccId id, vector<const hcmInstance*>& path) const;
+
+    /** @fn bool getNodeOccPath(hcmOccId id, vector<const hcmInstance*>& path, const hcmNode*& node) const
+     * @brief gets the path of instances and the node of the node occurrence \a id.
+     * @return true on success\n false if \a id is out of range.
+     */
+    bool getNodeOccPath(hcmOccId id, vector<const hcmInstance*>& path, const hcmNode*& node) const;
+
+    /** @fn string getInstOccName(hcmOccId id) const
+     * @brief gets the hierarchical name of an instance occurrence (e.g I1/I7), empty if out of range.
+     */
+    string getInstOccName(hcmOccId id) const;
+
+    /** @fn string getNodeOccName(hcmOccId id) const
+     * @brief gets the hierarchical name of a node occurrence (e.g I1/I7/N3), empty if out of range.
+     */
+    string getNodeOccName(hcmOccId id) const;
+};
+
+#endif
@@ -27,6 +27,8 @@ class hcmPort : public hcmObject {
     hcmNode* node;
     // dir - a enum representing the direction of this port.
     hcmPortDir dir;
+    // ordinal - the index of this port in the port table of its cell, stable for the life time of the port.
+    int ordinal;
 
   public:
     /** @fn hcmRes delProp(string name)
@@ -45,6 +47,24 @@ class hcmPort : public hcmObject {
      */
     ~hcmPort();
 
+    /** @fn static void* operator new(size_t size, hcmDesign* design)
+     * @brief allocates a hcmPort from the portArena of \a design.
+     * @param size - the size of the object.
+     * @param design - the design owning the object.
+     * @return pointer to the memory of the object.
+     */
+    static void* operator new(size_t size, hcmDesign* design);
+
+    /** @fn static void operator delete(void* obj, hcmDesign* design)
+     * @brief returns the memory of a hcmPort which constructor failed.
+     */
+    static void operator delete(void* obj, hcmDesign* design);
+
+    /** @fn static void operator delete(void* obj)
+     * @brief returns the memory of a deleted hcmPort to its arena.
+     */
+    static void operator delete(void* obj);
+
     /** @fn void printInfo()
      * @brief print information about this port.
      * @return none
@@ -63,7 +83,14 @@ class hcmPort : public hcmObject {
      */
     hcmNode* owner();
 
+    /** @fn int getOrdinal() const
+     * @brief gets the index of this port in the port table of its cell.
+     * @return the ordinal of the port.
+     */
+    int getOrdinal() const;
+
     friend class hcmNode;
+    friend class hcmDesign;
 };
 
 
@@ -0,0 +1,314 @@
+#ifndef HCM_PROP_STORE_H
+#define HCM_PROP_STORE_H
+
+#include "hcm_common.h"
+#include <deque>
+#include <unordered_map>
+
+/*! \var typedef int hcmObjId
+    \brief dense integer identifier of an object within its design, used to index the property columns.
+*/
+typedef int hcmObjId;
+
+/*! \def HCM_NO_OBJ
+    \brief the hcmObjId of an object that is not registered in a design.
+*/
+#define HCM_NO_OBJ -1
+
+/**
+ * A hcmPropKeyBase is the untyped part of a hcmPropKey.
+ * every (name, type) pair is registered once in a process wide registry and is given a dense id,
+ * constructing a second key with the same name and type gives the same id.
+ * the registry is indexed by name and guarded by a lock, so keys can be made and looked up from any thread.
+ * hcmPropKeyBase is an immutable object.
+ */
+class hcmPropKeyBase {
+  // RepInvariant:
+  	//  0 <= id < number of registered keys
+
+  // Abstraction Function:
+    //  id - the index of the key in the registry and of its column in each hcmPropStore.
+
+  protected:
+    // keyInfo - the registry record of a key, it never changes once registered.
+    struct keyInfo {
+      string name;
+      string typeName;
+    };
+
+    // keyRegistry - the keys by their id, a deque so a record stays in place as keys are added,
+    // and the ids of the keys of each name.
+    struct keyRegistry {
+      deque<keyInfo> keys;
+      unordered_map<string, vector<int>> byName;
+    };
+
+    int id;
+
+    /** @fn static keyRegistry& registry()
+     * @brief gets the registry of all the keys, to be used under the registry lock only.
+     */
+    static keyRegistry& registry();
+
+    /** @fn static const keyInfo& getKeyInfo(int keyId)
+     * @brief gets the record of a registered key.
+     */
+    static const keyInfo& getKeyInfo(int keyId);
+
+    /** @fn static int lookupKey(const keyRegistry& reg, const string& name, const char* typeName)
+     * @brief gets the id of the key (name, typeName) in \a reg, the caller holds the registry lock.
+     * @return the id of the key\n -1 if it is not registered.
+     */
+    static int lookupKey(const keyRegistry& reg, const string& name, const char* typeName);
+
+    /** @fn static int registerKey(const string& name, const char* typeName)
+     * @brief gets the id of the key (name, typeName), registering it if it is new.
+     */
+    static int registerKey(const string& name, const char* typeName);
+
+    hcmPropKeyBase(int keyId) : id(keyId) {}
+
+  public:
+    /** @fn int getId() const
+     * @brief gets the id of this key.
+     */
+    int getId() const { return id; }
+
+    /** @fn const string& getName() const
+     * @brief gets the property name of this key.
+     */
+    const string& getName() const { return getKeyInfo(id).name; }
+
+    /** @fn static int findKey(const string& name, const char* typeName)
+     * @brief gets the id of a registered key without registering it.
+     * @return the id of the key\n -1 if no key with this name and type was registered.
+     */
+    static int findKey(const string& name, const char* typeName);
+
+    /** @fn static vector<int> findKeys(const string& name)
+     * @brief gets the ids of all the keys registered with \a name, of any type.
+     */
+    static vector<int> findKeys(const string& name);
+
+    /** @fn static vector<int> sameNameKeys(int keyId)
+     * @brief gets the ids of the keys with the name of \a keyId and a different type.
+     */
+    static vector<int> sameNameKeys(int keyId);
+
+    // the registered keys, for walking all the properties of a design.
+    static int numKeys();
+    static const string& getKeyName(int keyId) { return getKeyInfo(keyId).name; }
+    static const string& getKeyTypeName(int keyId) { return getKeyInfo(keyId).typeName; }
+};
+
+/**
+ * A hcmPropKey is a typed handle of a property, registered once and used for every access.
+ * example: static hcmPropKey<double> delayKey("delay");
+ * a key made by name with the same type as a setProp(string, T) call refers to the same property.
+ * hcmPropKey is an immutable object.
+ */
+template <typename T>
+class hcmPropKey : public hcmPropKeyBase {
+  public:
+    /** @fn hcmPropKey(const string& name)
+     * @brief registers (or looks up) the property \a name of type T.
+     * @param name - the name of the property.
+     */
+    hcmPropKey(const string& name) : hcmPropKeyBase(registerKey(name, typeid(T).name())) {}
+};
+
+/**
+ * A hcmPropColumnBase is the untyped part of a property column.
+ */
+class hcmPropColumnBase {
+  public:
+    virtual ~hcmPropColumnBase() {}
+
+    /** @fn virtual bool has(hcmObjId obj) const
+     * @brief checks if object \a obj has a value in this column.
+     */
+    virtual bool has(hcmObjId obj) const = 0;
+
+    /** @fn virtual bool erase(hcmObjId obj)
+     * @brief removes the value of object \a obj.
+     * @return true if the object had a value.
+     */
+    virtual bool erase(hcmObjId obj) = 0;
+
+    /** @fn virtual size_t bytes() const
+     * @brief gets the heap bytes of the column storage.
+     */
+    virtual size_t bytes() const = 0;
+};
+
+/**
+ * A hcmPropColumn holds the values of one property for all the objects of a design.
+ * the values are stored densely by hcmObjId with a presence flag per object.
+ * hcmPropColumn is a mutable object.
+ */
+template <typename T>
+class hcmPropColumn : public hcmPropColumnBase {
+  // RepInvariant:
+  	//  values.size() == present.size()
+  	//  count == number of set entries of present
+
+  private:
+    vector<T> values;
+    vector<char> present;
+    size_t count;
+
+  public:
+    hcmPropColumn() : count(0) {}
+
+    bool has(hcmObjId obj) const {
+      return (size_t)obj < present.size() && present[obj];
+    }
+
+    /** @fn const T* get(hcmObjId obj) const
+     * @brief gets the value of object \a obj.
+     * @return pointer to the value\n NULL if the object has no value in this column.
+     */
+    const T* get(hcmObjId obj) const {
+      return has(obj) ? &values[obj] : NULL;
+    }
+
+    /** @fn T value(hcmObjId obj) const
+     * @brief gets a copy of the value of object \a obj, T() if it has none. unlike get() it works for bool columns too.
+     */
+    T value(hcmObjId obj) const {
+      return has(obj) ? T(values[obj]) : T();
+    }
+
+    /** @fn void set(hcmObjId obj, const T& value)
+     * @brief sets the value of object \a obj, growing the column if needed.
+     */
+    void set(hcmObjId obj, const T& value) {
+      if ((size_t)obj >= values.size()) {
+        values.resize(obj + 1);
+        present.resize(obj + 1, 0);
+      }
+      if (!present[obj]) {
+        present[obj] = 1;
+        count++;
+      }
+      values[obj] = value;
+    }
+
+    bool erase(hcmObjId obj) {
+      if (!has(obj)) {
+        return false;
+      }
+      present[obj] = 0;
+      values[obj] = T();
+      count--;
+      return true;
+    }
+
+    /** @fn size_t size() const
+     * @brief gets the number of objects with a value in this column.
+     */
+    size_t size() const { return count; }
+
+    size_t bytes() const { return sizeof(*this) + values.capacity() * sizeof(T) + present.capacity(); }
+};
+
+/**
+ * A hcmPropStore holds the property columns of a design and hands out the object ids.
+ * the column of a key is created on first use and is indexed by the id of its key.
+ * ids of destroyed objects are reused, so their values are erased from all the columns first.
+ * hcmPropStore is a mutable object.
+ */
+class hcmPropStore {
+  // RepInvariant:
+  	//  columns[k] is NULL or a hcmPropColumn of the type key k was registered with
+  	//  every key with a column is linked, and otherKeys of a linked key holds all the other linked keys with its name
+
+  // Abstraction Function:
+    //  columns - the property columns by key id.
+    //  freeIds - ids of destroyed objects, ready for reuse.
+    //  linked - keys already used with this store, by key id.
+    //  otherKeys - for a linked key, the linked keys with its name and a different type.
+
+  private:
+    vector<hcmPropColumnBase*> columns;
+    vector<hcmObjId> freeIds;
+    vector<char> linked;
+    vector<vector<int> > otherKeys;
+    hcmObjId nextId;
+    // releasing - set while the whole design is torn down, objects skip erasing their values.
+    bool releasing;
+
+    /** @fn void linkKey(int keyId)
+     * @brief records the keys with the name of \a keyId once, so hasOtherType() needs no registry lookup.
+     */
+    void linkKey(int keyId);
+
+  public:
+    hcmPropStore() : nextId(0), releasing(false) {}
+
+    /** @fn ~hcmPropStore()
+     * @brief hcmPropStore distractor. deletes all the columns.
+     */
+    ~hcmPropStore();
+
+    /** @fn size_t bytes() const
+     * @brief gets the heap bytes of all the columns and the id free list.
+     */
+    size_t bytes() const;
+
+    /** @fn hcmObjId newObject()
+     * @brief gets an id for a new object.
+     */
+    hcmObjId newObject();
+
+    /** @fn void releaseObject(hcmObjId obj)
+     * @brief erases the values of \a obj from all the columns and recycles its id.
+     */
+    void releaseObject(hcmObjId obj);
+
+    /** @fn void setReleasing(bool r)
+     * @brief marks the store as being torn down with its design, releaseObject() does nothing then.
+     */
+    void setReleasing(bool r) { releasing = r; }
+
+    /** @fn bool has(int keyId, hcmObjId obj) const
+     * @brief checks if \a obj has a value for the key \a keyId.
+     */
+    bool has(int keyId, hcmObjId obj) const;
+
+    /** @fn bool hasOtherType(int keyId, hcmObjId obj)
+     * @brief checks if \a obj has a value for a key with the name of \a keyId and a different type.
+     * only the first call for a key reads the key registry.
+     */
+    bool hasOtherType(int keyId, hcmObjId obj);
+
+    /** @fn hcmPropColumn<T>* findColumn(int keyId) const
+     * @brief gets the column of a key if it was created.
+     * @return pointer to the column\n NULL if no value was ever set for the key.
+     */
+    template <typename T>
+    hcmPropColumn<T>* findColumn(int keyId) const {
+      if ((size_t)keyId >= columns.size()) {
+        return NULL;
+      }
+      return static_cast<hcmPropColumn<T>*>(columns[keyId]);
+    }
+
+    /** @fn hcmPropColumn<T>& column(const hcmPropKey<T>& key)
+     * @brief gets the column of \a key, creating it on first use.
+     */
+    template <typename T>
+    hcmPropColumn<T>& column(const hcmPropKey<T>& key) {
+      int keyId = key.getId();
+      if ((size_t)keyId >= columns.size()) {
+        columns.resize(keyId + 1, NULL);
+      }
+      if (columns[keyId] == NULL) {
+        linkKey(keyId);
+        columns[keyId] = new hcmPropColumn<T>();
+      }
+      return *static_cast<hcmPropColumn<T>*>(columns[keyId]);
+    }
+};
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef HCM_SNAPSHOT_H
+#define HCM_SNAPSHOT_H
+
+#include "hcm.h"
+#include <cstdint>
+
+/*! \def HCM_SNAP_NONE
+    \brief an index field of a snapshot record that refers to nothing.
+*/
+#define HCM_SNAP_NONE 0xffffffffu
+
+// the sections of a snapshot file, each one is an array of fixed size records.
+typedef enum hcmSnapSections {
+  SNAP_STRINGS,     /**< the names, NUL terminated chars. a name is referred to by its offset.*/
+  SNAP_CELLS,       /**< hcmSnapCell, masters before the cells instantiating them.*/
+  SNAP_NODES,       /**< hcmSnapNode, the nodes of each cell in name order.*/
+  SNAP_INSTS,       /**< hcmSnapInst, the instances of each cell in name order.*/
+  SNAP_PINS,        /**< hcmSnapPin, the connected instPorts of each instance.*/
+  SNAP_NODE_PINS,   /**< uint32_t, the pins of each node.*/
+  SNAP_BUSES,       /**< hcmSnapBus, the buses of each cell.*/
+  SNAP_BUS_BITS,    /**< uint32_t, the node of each bit of each bus from low to high.*/
+  SNAP_PORT_ORDER,  /**< uint32_t, the port names of the header of each cell in order, as string offsets.*/
+  SNAP_PROP_KEYS,   /**< hcmSnapPropKey, the saved property keys.*/
+  SNAP_PROPS,       /**< hcmSnapProp, the saved property values.*/
+  SNAP_NUM_SECTIONS
+} hcmSnapSection;
+
+// the types of the saved properties.
+typedef enum hcmSnapPropTypes { SNAP_INT, SNAP_DOUBLE, SNAP_BOOL, SNAP_STRING } hcmSnapPropType;
+
+// the kinds of objects a property value belongs to, the index is in the table of that kind.
+// a port is given by the index of its node and an instPort by the index of its pin.
+typedef enum hcmSnapObjKinds { SNAP_DESIGN, SNAP_CELL, SNAP_NODE, SNAP_PORT, SNAP_INST, SNAP_INST_PORT } hcmSnapObjKind;
+
+struct hcmSnapHeader {
+  char magic[8];
+  uint32_t version;
+  // byteOrder - 0x01020304 as written, a file of another byte order is rejected.
+  uint32_t byteOrder;
+  uint64_t fileSize;
+  uint32_t designName;
+  uint32_t pad;
+  struct {
+    uint64_t offset;
+    uint64_t count;
+  } sections[SNAP_NUM_SECTIONS];
+};
+
+struct hcmSnapCell {
+  uint32_t name;
+  uint32_t firstNode, numNodes;
+  uint32_t firstInst, numInsts;
+  uint32_t firstBus, numBuses;
+  // firstPortName/numPortNames - the range of the cell header in SNAP_PORT_ORDER, firstPortName is HCM_SNAP_NONE with no header.
+  uint32_t firstPortName, numPortNames;
+};
+
+struct hcmSnapNode {
+  uint32_t name;
+  // dir - the hcmPortDir of the port of the node, NOT_PORT if it has none.
+  int32_t dir;
+  // firstPin/numPins - the range of the node in SNAP_NODE_PINS.
+  uint32_t firstPin, numPins;
+  // ordinal - the ordinal of the port of the node, HCM_SNAP_NONE if it has none.
+  uint32_t ordinal;
+};
+
+struct hcmSnapInst {
+  uint32_t name;
+  uint32_t master;
+  // firstPin/numPins - the range of the instance in SNAP_PINS.
+  uint32_t firstPin, numPins;
+};
+
+struct hcmSnapPin {
+  uint32_t inst;
+  uint32_t node;
+  // port - the node of the master port.
+  uint32_t port;
+};
+
+struct hcmSnapBus {
+  uint32_t name;
+  int32_t from, to;
+  int32_t dir;
+  // firstBit - the first bit of the bus in SNAP_BUS_BITS, there are |from - to| + 1 of them.
+  uint32_t firstBit;
+  uint32_t pad;
+};
+
+struct hcmSnapPropKey {
+  uint32_t name;
+  uint32_t type;
+};
+
+struct hcmSnapProp {
+  uint32_t key;
+  uint32_t kind;
+  uint32_t index;
+  uint32_t pad;
+  union {
+    int64_t i;
+    double d;
+    // s - the offset of a string value in SNAP_STRINGS.
+    uint64_t s;
+  } value;
+};
+
+/**
+ * A hcmSnapshot is a binary image of a design laid out as flat arrays of fixed size records
+ * that refer to each other by index, with all the names in one string section.
+ * write() saves a design. open() maps a file read only - the records are used in place, so
+ * opening costs no parsing and processes opening the same file share its pages.
+ * the tables can be walked directly through the accessors, or load() builds a hcmDesign from them
+ * without going through the verilog parser.
+ * properties of type int, double, bool and string are saved, properties of other types are not.
+ * hcmSnapshot is a mutable object.
+ */
+class hcmSnapshot {
+  // RepInvariant:
+  	//  base == NULL || (header == base && every section lies inside [base, base + size))
+
+  // Abstraction Function:
+    //  base/size - the mapped file, NULL if none is open.
+    //  error - the reason the last open() or load() failed.
+
+  private:
+    const char* base;
+    size_t size;
+    const hcmSnapHeader* header;
+    string error;
+
+    /** @fn const T* section(hcmSnapSection s) const
+     * @brief gets the records of section \a s.
+     */
+    template <typename T>
+    const T* section(hcmSnapSection s) const {
+      return (const T*)(base + header->sections[s].offset);
+    }
+
+    /** @fn bool check()
+     * @brief validates the header and the section bounds of the mapped file, sets error if not valid.
+     */
+    bool check();
+
+    /** @fn bool checkRecords()
+     * @brief validates every index and string offset of the records against the sections, sets error if not valid.
+     */
+    bool checkRecords();
+
+  public:
+    /** @fn hcmSnapshot()
+     * @brief constractor, no file is open.
+     */
+    hcmSnapshot();
+
+    /** @fn ~hcmSnapshot()
+     * @brief distractor, unmaps the file.
+     */
+    ~hcmSnapshot();
+
+    /** @fn static hcmRes write(hcmDesign* design, const string& fileName)
+     * @brief saves \a design into the file \a fileName.
+     * @return OK on success\n BAD_PARAM if the file could not be written.
+     */
+    static hcmRes write(hcmDesign* design, const string& fileName);
+
+    /** @fn hcmRes open(const string& fileName)
+     * @brief maps the snapshot file \a fileName read only, closing the current one.
+     * @return OK on success\n BAD_PARAM if the file can't be mapped or is not a valid snapshot, getError() tells why.
+     */
+    hcmRes open(const string& fileName);
+
+    /** @fn void close()
+     * @brief unmaps the file, the records got from it are not valid anymore.
+     */
+    void close();
+
+    /** @fn const string& getError() const
+     * @brief gets the reason the last open() or load() failed.
+     */
+    const string& getError() const { return error; }
+
+    // the tables of the open snapshot.
+    const char* getString(uint64_t offset) const { return section<char>(SNAP_STRINGS) + offset; }
+    const char* getDesignName() const { return getString(header->designName); }
+    uint32_t numCells() const { return header->sections[SNAP_CELLS].count; }
+    uint32_t numNodes() const { return header->sections[SNAP_NODES].count; }
+    uint32_t numInsts() const { return header->sections[SNAP_INSTS].count; }
+    uint32_t numPins() const { return header->sections[SNAP_PINS].count; }
+    uint32_t numBuses() const { return header->sections[SNAP_BUSES].count; }
+    const hcmSnapCell& getCell(uint32_t i) const { return section<hcmSnapCell>(SNAP_CELLS)[i]; }
+    const hcmSnapNode& getNode(uint32_t i) const { return section<hcmSnapNode>(SNAP_NODES)[i]; }
+    const hcmSnapInst& getInst(uint32_t i) const { return section<hcmSnapInst>(SNAP_INSTS)[i]; }
+    const hcmSnapPin& getPin(uint32_t i) const { return section<hcmSnapPin>(SNAP_PINS)[i]; }
+    const hcmSnapBus& getBus(uint32_t i) const { return section<hcmSnapBus>(SNAP_BUSES)[i]; }
+    const uint32_t* nodePinsBegin(uint32_t i) const { return section<uint32_t>(SNAP_NODE_PINS) + getNode(i).firstPin; }
+    const uint32_t* nodePinsEnd(uint32_t i) const { return nodePinsBegin(i) + getNode(i).numPins; }
+    uint32_t getBusBit(const hcmSnapBus& bus, uint32_t k) const { return section<uint32_t>(SNAP_BUS_BITS)[bus.firstBit + k]; }
+    uint32_t getPortName(const hcmSnapCell& cell, uint32_t k) const { return section<uint32_t>(SNAP_PORT_ORDER)[cell.firstPortName + k]; }
+
+    /** @fn uint32_t findCell(const string& name) const
+     * @brief gets the index of the cell named \a name.
+     * @return the index\n HCM_SNAP_NONE if there is no such cell.
+     */
+    uint32_t findCell(const string& name) const;
+
+    /** @fn hcmDesign* load()
+     * @brief builds a new design from the open snapshot, after validating all its records.\n
+     * the accessors above use the records as they are, a damaged file is only caught by load().
+     * the ports are created in ordinal order, so they keep their order but not the gaps of deleted ports.
+     * @return the new design, owned by the caller\n NULL on failure, getError() tells why.
+     */
+    hcmDesign* load();
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef HCM_STRING_POOL_H
+#define HCM_STRING_POOL_H
+
+#include "hcm_common.h"
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * A hcmStringPoolStats counts the work of a hcmStringPool.
+ */
+struct hcmStringPoolStats {
+  // lookups/hits - the interned strings, and the ones that were in the pool already.
+  size_t lookups;
+  size_t hits;
+  // bytes - the bytes of the stored strings, with their terminating NUL.
+  size_t bytes;
+  // chunkBytes - the bytes of the arena chunks holding them.
+  size_t chunkBytes;
+
+  /** @fn double hitRate() const
+   * @brief gets the part of the lookups that found their string, 0 if there were none.
+   */
+  double hitRate() const { return lookups ? (double)hits / lookups : 0; }
+};
+
+/**
+ * A hcmStringPool stores each of its strings once and gives it a dense integer id.
+ * the strings are kept NUL terminated in large arena chunks that never move, so views and
+ * pointers to them stay valid for the life time of the pool. nothing is freed before that.
+ * hcmStringPool is a mutable object.
+ */
+class hcmStringPool {
+  // RepInvariant:
+  	//  ids[strings[i]] == i for each 0 <= i < strings.size()
+  	//  each strings[i] points into chunks and is followed by a NUL
+
+  // Abstraction Function:
+    //  strings - the stored strings by their id.
+    //  ids - a mapping between a stored string and its id.
+    //  chunks - the arena, chunkPtr/chunkLeft - the free tail of the last chunk.
+  private:
+    vector<unique_ptr<char[]> > chunks;
+    char* chunkPtr;
+    size_t chunkLeft;
+    vector<string_view> strings;
+    unordered_map<string_view, int> ids;
+    hcmStringPoolStats stats;
+
+    /** @fn string_view store(string_view s)
+     * @brief copies \a s into the arena.
+     * @return the view of the copy.
+     */
+    string_view store(string_view s);
+
+  public:
+    /** @fn hcmStringPool()
+     * @brief hcmStringPool constractor, the pool is empty.
+     */
+    hcmStringPool();
+
+    /** @fn int intern(string_view s)
+     * @brief gets the id of \a s, storing it if it is not in the pool yet.\n
+     * only the first lookup of a string copies it, \a s may point into a buffer that goes away.
+     * @return the id of the string.
+     */
+    int intern(string_view s);
+
+    /** @fn int find(string_view s) const
+     * @brief gets the id of \a s without storing it. this method doesn't allocate memory.
+     * @return the id of the string\n -1 if it is not in the pool.
+     */
+    int find(string_view s) const;
+
+    /** @fn string_view get(int id) const
+     * @brief gets the string of \a id, its data() is NUL terminated.
+     */
+    string_view get(int id) const { return strings[id]; }
+
+    /** @fn void reserve(size_t numStrings)
+     * @brief makes room for \a numStrings strings without rehashing.
+     */
+    void reserve(size_t numStrings);
+
+    /** @fn size_t size() const
+     * @brief gets the number of stored strings.
+     */
+    size_t size() const { return strings.size(); }
+
+    /** @fn const hcmStringPoolStats& getStats() const
+     * @brief gets the counters of the pool.
+     */
+    const hcmStringPoolStats& getStats() const { return stats; }
+
+    /** @fn size_t bytes() const
+     * @brief gets an estimate of the heap bytes held by the pool.
+     */
+    size_t bytes() const;
+};
+
+#endif
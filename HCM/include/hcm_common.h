@@ -14,61 +14,36 @@
 
 #define HIER_SEPARATOR "/"
 
+// new_string - interns \a name in a table shared by the whole program, the result is never freed.
 const char *new_string(const char *name);
 void delete_string(char *_name);
 
 using namespace std;
 
 
-struct eqstr {  
-  bool operator()(const char* s1, const char* s2) const {
-    return strcmp(s1, s2);  
-  }
-};
-
-#define DictType       map<const char*, int, eqstr>
-
-extern DictType dict;
-
-inline const char *new_string(const char *name){
-  DictType::iterator i;
-  char *_name;
-  i = dict.find(name);
-  if(i!=dict.end()) {
-    _name = (char*)i->first;
-    i->second++;
-  } 
-  
-  else {
-    _name = strdup(name);
-    dict[_name] = 1;
-  }
-
-  return _name;
-}
-
-inline void delete_string(char *_name){
-  DictType::iterator i;
-  //      cout << "Delete "<< _name << endl;
-  i = dict.find(_name);
-  if(i==dict.end()) {
-    cerr << "Over delete "<< _name << endl;
-    return;
-  }
-
-  i->second--;
-  if(i->second == 0) {
-    // delete i->first;
-    // dict.erase(i);
-  }
-}
-
+// CharBuf - a growing text buffer, its room doubles so appending a long token is linear.
 class CharBuf{
   char *charbuf,*charbuf_ptr;
   unsigned int charbuf_len;
+
+  // makes room for new_len bytes, text and NUL
+  void reserve(unsigned int new_len){
+    if(new_len<=charbuf_len){
+      return;
+    }
+    unsigned int old_len=charbuf_ptr-charbuf;
+    unsigned int len=charbuf_len ? charbuf_len : 32;
+    while(len<new_len){
+      len*=2;
+    }
+    charbuf=(char*)realloc(charbuf,len);
+    charbuf_len=len;
+    charbuf_ptr=charbuf+old_len;
+  }
  public:
   CharBuf(){
     charbuf=NULL;
+    charbuf_ptr=NULL;
     charbuf_len=0;
   }
   ~CharBuf(){
@@ -76,20 +51,16 @@ class CharBuf{
     if(charbuf)free(charbuf);
   }
   void init(){
+    reserve(1);
     charbuf_ptr = charbuf;  
+    *charbuf_ptr='\0';
   }
   char *str(){ return charbuf;}
 
   char *append_str(const char *s){
     unsigned int old_len=charbuf_ptr-charbuf;  
     unsigned int delta_len=strlen(s);
-    unsigned int new_len=old_len+delta_len+1;
-    if(new_len>charbuf_len){
-      charbuf=(char*)realloc(charbuf,new_len);
-      charbuf_len=new_len;
-      charbuf_ptr=charbuf+old_len;
-    }
-    
+    reserve(old_len+delta_len+1);
     strcpy(charbuf_ptr,s);
     charbuf_ptr+=delta_len;
     return charbuf;
@@ -97,13 +68,7 @@ class CharBuf{
 
   char *append_char(char c){
     unsigned int old_len=charbuf_ptr-charbuf;  
-    unsigned int new_len=old_len+2;
-    if(new_len>charbuf_len){
-      charbuf=(char*)realloc(charbuf,new_len);
-      charbuf_len=new_len;
-      charbuf_ptr=charbuf+old_len;
-    }
-    
+    reserve(old_len+2);
     *charbuf_ptr++=c;
     *charbuf_ptr='\0';
     return charbuf;
@@ -159,6 +124,15 @@ typedef enum hcmPortTypes {
   IN_OUT                                /**< .*/
 } hcmPortDir;
 
+// verilog readers:
+/*! \var typedef enum hcmVerilogReaders hcmVerilogReader
+    \brief Object representing the reader used to parse structural verilog.
+*/
+typedef enum hcmVerilogReaders {
+  VLOG_READER_BISON,                    /**< The flex/bison parser.*/
+  VLOG_READER_FAST                      /**< The hand written reader of a mapped file, same language and results.*/
+} hcmVerilogReader;
+
 /**! \struct Range hcm.h
  * \brief this struct represent a wire with direction, type and boundaries
  * 
@@ -177,5 +151,6 @@ class hcmInstance;
 class hcmNode;
 class hcmInstPort;
 class hcmPort;
+class hcmBus;
 
 #endif
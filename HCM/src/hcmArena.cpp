@@ -0,0 +1,77 @@
+#include "hcm.h"
+
+hcmArenaBase::hcmArenaBase(size_t objSize){
+	slotSize = headerSize + ((objSize + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1));
+	usedInLastChunk = 0;
+	freeList = NULL;
+	liveCount = 0;
+	releasing = false;
+}
+
+hcmArenaBase::~hcmArenaBase(){
+	freeChunks();
+}
+
+void hcmArenaBase::freeChunks(){
+	for(auto it = chunks.begin(); it != chunks.end(); ++it) {
+		free(*it);
+	}
+	chunks.clear();
+	usedInLastChunk = 0;
+	freeList = NULL;
+	liveCount = 0;
+}
+
+void* hcmArenaBase::allocate(hcmArenaBase* arena, size_t size){
+	slotHeader* slot;
+	if(arena == NULL) {
+		slot = (slotHeader*)malloc(headerSize + size);
+		if(slot == NULL) {
+			throw bad_alloc();
+		}
+	}
+	else {
+		assert(headerSize + size <= arena->slotSize);
+		if(arena->freeList) {
+			slot = arena->freeList;
+			arena->freeList = slot->nextFree;
+		}
+		else {
+			if(arena->chunks.empty() || arena->usedInLastChunk == slotsPerChunk) {
+				char* chunk = (char*)malloc(slotsPerChunk * arena->slotSize);
+				if(chunk == NULL) {
+					throw bad_alloc();
+				}
+				arena->chunks.push_back(chunk);
+				arena->usedInLastChunk = 0;
+			}
+			slot = arena->slotAt(arena->chunks.size() - 1, arena->usedInLastChunk++);
+		}
+		arena->liveCount++;
+	}
+	slot->arena = arena;
+	slot->nextFree = NULL;
+	slot->live = true;
+	return (char*)slot + headerSize;
+}
+
+void hcmArenaBase::deallocate(void* obj){
+	if(obj == NULL) {
+		return;
+	}
+	slotHeader* slot = (slotHeader*)((char*)obj - headerSize);
+	hcmArenaBase* arena = slot->arena;
+	if(arena == NULL) {
+		free(slot);
+		return;
+	}
+	slot->live = false;
+	slot->nextFree = arena->freeList;
+	arena->freeList = slot;
+	arena->liveCount--;
+}
+
+bool hcmArenaBase::isReleasing(const void* obj){
+	const slotHeader* slot = (const slotHeader*)((const char*)obj - headerSize);
+	return slot->arena && slot->arena->releasing;
+}
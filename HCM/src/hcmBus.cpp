@@ -0,0 +1,32 @@
+#include "hcm.h"
+
+hcmBus::hcmBus(string busName, hcmNameId id, int fromIdx, int toIdx, hcmPortDir direction){
+	name = busName;
+	nameId = id;
+	from = fromIdx;
+	to = toIdx;
+	dir = direction;
+	bits.assign(getWidth(), NULL);
+}
+
+hcmPort* hcmBus::getPort(int index) const{
+	hcmNode* node = getNode(index);
+	return node ? node->getPort() : NULL;
+}
+
+vector<hcmPort*> hcmBus::getPorts() const{
+	vector<hcmPort*> ports;
+	ports.reserve(bits.size());
+	int step = (from <= to) ? 1 : -1;
+	for(int i = from; i != to + step; i += step) {
+		hcmPort* port = getPort(i);
+		if(port) {
+			ports.push_back(port);
+		}
+	}
+	return ports;
+}
+
+string hcmBus::getBitName(int index) const{
+	return busNodeName(name, index);
+}
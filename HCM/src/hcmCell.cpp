@@ -5,16 +5,16 @@ extern string busNodeName(string busName, int index);
 
 void hcmCell::printInfo(){
   cout << "------------------------" << endl;
-  cout << "Cell " + name << endl;
-  cout << "Cell " + name + "'s nodes:" << endl;
+  cout << "Cell " + getName() << endl;
+  cout << "Cell " + getName() + "'s nodes:" << endl;
   for (auto it = nodes.begin(); it != nodes.end(); ++it) {
     it->second->printInfo();
   }
-  cout << "Cell " + name + "'s cells:" << endl;
+  cout << "Cell " + getName() + "'s cells:" << endl;
   for (auto it = cells.begin(); it != cells.end(); ++it) {
     it->second->printInfo();
   }
-  cout << "Cell " + name + "'s instances:" << endl;
+  cout << "Cell " + getName() + "'s instances:" << endl;
   for (auto it = myInstances.begin(); it != myInstances.end(); ++it) {
     it->second->printInfo();
   }
@@ -22,17 +22,28 @@ void hcmCell::printInfo(){
 
 hcmCell::hcmCell(string cellName, hcmDesign* d) {
   design = d;
-  this->name = cellName;
+  setName(design->getNameTable(), cellName);
+  generation = 0;
+  hasPortOrder = false;
+  portOrderGeneration = 0;
+  portOrderCompiled = false;
+  registerProps(&design->props);
 }
 
 hcmCell::~hcmCell() {
   destructorCalled = true;
-  design->deleteCell(name);
+  if (design->releasing) {
+    // the design already released all the objects of the cell in bulk
+    design = NULL;
+    return;
+  }
+  design->deleteCell(getName());
 
 
   cleanAndDestroy(nodes);
   cleanAndDestroy(cells);
   cleanAndDestroy(myInstances);
+  design->journal.notify(CELL_DELETED, this, NULL, NULL, NULL);
   // set<string> names;
 
   // delete the nodes map
@@ -80,10 +91,16 @@ hcmInstance* hcmCell::createInst(string name, hcmCell* masterCell){
   if(masterCell == NULL || cells.count(name) > 0){
     return NULL;
   }
-  hcmInstance* instance = new hcmInstance(name,masterCell);
+  return addInstUnchecked(name, masterCell);
+}
+
+hcmInstance* hcmCell::addInstUnchecked(string name, hcmCell* masterCell){
+  hcmInstance* instance = new (design) hcmInstance(name,masterCell);
   instance->connectInstance(this);
   cells[name] = instance;
+  cellsById[instance->nameId] = instance;
   masterCell->myInstances[name] = instance;
+  design->journal.notify(INST_CREATED, this, instance, NULL, NULL);
   return instance;
 }
 
@@ -107,6 +124,7 @@ hcmRes hcmCell::deleteInst(string name){
     //  cleanAndDestroy(inst->instPorts);
     inst->master->myInstances.erase(name); // equal? this->myInstances.erase(name) ???
     cells.erase(name);
+    cellsById.erase(inst->nameId);
     inst->cell = NULL;
     inst->master = NULL;
   }
@@ -119,10 +137,12 @@ hcmRes hcmCell::deleteNode(string name){
     return BAD_PARAM;
   }
   hcmNode* node = nodes[name];
+  hcmNameId id = node->nameId;
   if(!(node->destructorCalled)){
     delete node;
   }
   nodes.erase(name);
+  nodesById.erase(id);
   return OK;
 }
 
@@ -131,58 +151,68 @@ hcmNode* hcmCell::createNode(string name){
     cout << "Warning: Node: " + name + " already exists" << endl;
     return NULL;
   }
-  hcmNode* node = new hcmNode(name,this);
+  return addNodeUnchecked(name);
+}
+
+hcmNode* hcmCell::addNodeUnchecked(string name){
+  hcmNode* node = new (design) hcmNode(name,this);
   nodes[name] = node;
+  nodesById[node->nameId] = node;
+  design->journal.notify(NODE_CREATED, this, NULL, node, NULL);
   return node;
 }
 
-hcmInstance* hcmCell::getInst(string name){
-  if(cells.find(name) != cells.end()){
-    return cells[name];
+hcmInstance* hcmCell::getInst(string_view name){
+  auto iI = cellsById.find(design->getNameTable().find(name));
+  if(iI != cellsById.end()){
+    return iI->second;
   } 
   else {
     return NULL;
   }
 }
 
-hcmNode* hcmCell::getNode(string name) {
-  if(nodes.count(name) > 0) {
-    return nodes[name];
+hcmNode* hcmCell::getNode(string_view name) {
+  auto nI = nodesById.find(design->getNameTable().find(name));
+  if(nI != nodesById.end()) {
+    return nI->second;
   } 
   else {
     return NULL;
   }
 }
 
-hcmPort* hcmCell::getPort(string name) {
-  if(nodes.count(name) > 0){
-    return nodes[name]->getPort();
+hcmPort* hcmCell::getPort(string_view name) {
+  hcmNode *node = getNode(name);
+  if(node) {
+    return node->getPort();
   } 
   else {
     return NULL;
   }
 }
 
-const hcmInstance* hcmCell::getInst(string name) const{
-  if(cells.count(name) > 0){
-    return cells.find(name)->second;
+const hcmInstance* hcmCell::getInst(string_view name) const{
+  auto iI = cellsById.find(design->getNameTable().find(name));
+  if(iI != cellsById.end()){
+    return iI->second;
   } 
   else {
     return NULL;
   }
 }
 
-const hcmNode* hcmCell::getNode(string name) const{
-  map< string, hcmNode* >::const_iterator nI = nodes.find(name);
-  if(nI != nodes.end()){
-    return (*nI).second;
+const hcmNode* hcmCell::getNode(string_view name) const{
+  auto nI = nodesById.find(design->getNameTable().find(name));
+  if(nI != nodesById.end()){
+    return nI->second;
   } 
   else {
     return NULL;
   }
 }
 
-const hcmPort* hcmCell::getPort(string name) const{
+const hcmPort* hcmCell::getPort(string_view name) const{
   const hcmNode *node = getNode(name);
   if(node) {
     return node->getPort();
@@ -216,12 +246,14 @@ bool hcmCell::instPortParametersValid(hcmInstance* inst, hcmNode* node, hcmPort*
   if (anyError) 
     return false;
 
-  if(nodes.count(node->name) == 0 || nodes[node->name] != node ){
-    cout << "Error: " + node->name + "is not a node in the cell: " + name << endl;
+  auto nI = nodesById.find(node->nameId);
+  if(nI == nodesById.end() || nI->second != node ){
+    cout << "Error: " + node->getName() + "is not a node in the cell: " + getName() << endl;
     return false;
   }
-  if(cells.count(inst->name) == 0 || cells[inst->name] != inst ){
-    cout << "Error: " + inst->name + "is not an instance in the cell: " + name << endl;
+  auto iI = cellsById.find(inst->nameId);
+  if(iI == cellsById.end() || iI->second != inst ){
+    cout << "Error: " + inst->getName() + "is not an instance in the cell: " + getName() << endl;
     return false;
   }
   return true;
@@ -231,10 +263,21 @@ hcmInstPort* hcmCell::connect(hcmInstance* inst, hcmNode* node, hcmPort* port){
   if(!instPortParametersValid(inst,node,port)){
     return NULL;
   }
-  hcmInstPort* instPort = new hcmInstPort(inst,node, port);
-  node->instPorts[instPort->getName()] = instPort;
-  inst->instPorts[instPort->getName()] = instPort;
+  if(inst->isConnected(port)) {
+    cout << "Error: port: " << port->getName() << " of instance: " << inst->getName() << " is already connected" << endl;
+    return NULL;
+  }
+  return connectUnchecked(inst, node, port);
+}
+
+hcmInstPort* hcmCell::connectUnchecked(hcmInstance* inst, hcmNode* node, hcmPort* port){
+  hcmInstPort* instPort = new (design) hcmInstPort(inst,node, port);
+  const string ipName = instPort->getName();
+  node->instPorts[ipName] = instPort;
+  inst->instPorts[ipName] = instPort;
+  inst->setInstPortByOrdinal(port->getOrdinal(), instPort);
   port->owner()->connectPort(instPort);
+  design->journal.notify(CONNECTED, this, inst, node, port);
   return instPort;
 }
 
@@ -278,6 +321,61 @@ vector<hcmPort*> hcmCell::getPorts(){
   return ports;
 }
 
+const vector<hcmPort*>& hcmCell::getPortTable() const{
+  return portTable;
+}
+
+hcmGeneration hcmCell::getGeneration() const{
+  return generation;
+}
+
+void hcmCell::setPortOrder(const vector<string>& names){
+  portOrder = names;
+  hasPortOrder = true;
+  portOrderCompiled = false;
+}
+
+const vector<string>* hcmCell::getPortOrder() const{
+  return hasPortOrder ? &portOrder : NULL;
+}
+
+void hcmCell::compilePortOrder(){
+  portOrderTable.assign(portOrder.size(), vector<hcmPort*>());
+  for(size_t i = 0; i < portOrder.size(); i++) {
+    const hcmBus* bus = getBus(portOrder[i]);
+    if (bus) {
+      portOrderTable[i] = bus->getPorts();
+    }
+    else {
+      hcmPort* port = getPort(portOrder[i]);
+      if (port) {
+        portOrderTable[i].push_back(port);
+      }
+    }
+  }
+  portOrderGeneration = generation;
+  portOrderCompiled = true;
+}
+
+const vector<hcmPort*>* hcmCell::getOrderedPorts(size_t idx){
+  if (!hasPortOrder || idx >= portOrder.size()) {
+    return NULL;
+  }
+  if (!portOrderCompiled || portOrderGeneration != generation) {
+    compilePortOrder();
+  }
+  return &portOrderTable[idx];
+}
+
+int hcmCell::registerPort(hcmPort* port){
+  portTable.push_back(port);
+  return portTable.size() - 1;
+}
+
+void hcmCell::unregisterPort(hcmPort* port){
+  portTable[port->getOrdinal()] = NULL;
+}
+
 map< string, hcmInstance* >& hcmCell::getInstances()
 {
   return cells;
@@ -308,9 +406,10 @@ hcmRes hcmCell::disConnect(hcmInstPort* instPort){
     delete instPort;
   } 
   else {
-    string instPortName = instPort->name;
+    string instPortName = instPort->getName();
     instPort->connectedNode->instPorts.erase(instPortName);
     instPort->connectedNode = NULL;
+    instPort->inst->setInstPortByOrdinal(instPort->connectedPort->getOrdinal(), NULL);
     if (instPort->connectedPort->owner()) 
       instPort->connectedPort->owner()->disconnectPort(instPort);
     instPort->connectedPort = NULL;
@@ -323,44 +422,66 @@ hcmRes hcmCell::disConnect(hcmInstPort* instPort){
 
 }
 
-void hcmCell::createBus(string name, int from , int to, hcmPortDir dir){
+hcmBus* hcmCell::createBus(string name, int from , int to, hcmPortDir dir){
   if(from < 0 || to < 0) {
     cout << "Cannot add bus: " << name << ". Reason: Bad Parameters from: "
 	  << from << " to: " << to << endl;
-    return;
+    return NULL;
   }
   if(nodes.count(name)>0 || buses.count(name)>0) {
     cout << "Warning: Node: " + name + " already exists!" << endl;
-    return;
+    return NULL;
   }
-  int low = (from < to) ? from : to;
-  int high = (from < to) ? to : from;
+  hcmNameId id = design->getNameTable().intern(name);
+  hcmBus* bus = &buses.emplace(name, hcmBus(name, id, from, to, dir)).first->second;
+  busesById[id] = bus;
 
+  int low = bus->getLow();
+  int high = bus->getHigh();
   for(int i = low ; i <= high; i++) {
     hcmNode* node = createNode(busNodeName(name,i));
     if(node == NULL) {
       cout << "Failed to create node: "+ name << '[' << i << ']' << endl;
       continue;
     }
+    node->bus = bus;
+    node->busIndex = i;
+    bus->bits[i - low] = node;
     if (dir != NOT_PORT){
       node->createPort(dir);
     }
   }
-  buses[name] = make_pair(from,to);
+  return bus;
 }
 
 void hcmCell::deleteBus(string name){
-  if(buses.count(name) == 0 ) {
+  auto bI = buses.find(name);
+  if(bI == buses.end()) {
     cout << "DeleteBus: bus " + name + " not found!" << endl;
     return;
   }
-  for(int i = buses[name].second ; i<= buses[name].first ; i++ ) {
-    deleteNode(busNodeName(name,i));
+  // deleting a bit clears its slot in the bus
+  vector<hcmNode*> bits = bI->second.bits;
+  for(auto it = bits.begin(); it != bits.end(); ++it) {
+    if(*it) {
+      delete *it;
+    }
   }
-  buses.erase(name);
+  busesById.erase(bI->second.nameId);
+  buses.erase(bI);
+}
+
+hcmBus* hcmCell::getBus(string_view name){
+  auto bI = busesById.find(design->getNameTable().find(name));
+  return (bI != busesById.end()) ? bI->second : NULL;
+}
+
+const hcmBus* hcmCell::getBus(string_view name) const{
+  auto bI = busesById.find(design->getNameTable().find(name));
+  return (bI != busesById.end()) ? bI->second : NULL;
 }
 
-const map< string, pair<int,int> >& hcmCell::getBuses() const{
+const map< string, hcmBus >& hcmCell::getBuses() const{
   return buses;
 }
 
@@ -0,0 +1,156 @@
+#include "hcm.h"
+#include "hcmCellBuilder.h"
+#include <unordered_map>
+#include <unordered_set>
+
+hcmCellBuilder::hcmCellBuilder(hcmCell* c){
+	assert(c != NULL);
+	cell = c;
+	committedNodes = 0;
+	committedInsts = 0;
+}
+
+void hcmCellBuilder::reserve(size_t numNodes, size_t numInsts, size_t numPins){
+	nodes.reserve(nodes.size() + numNodes);
+	insts.reserve(insts.size() + numInsts);
+	pins.reserve(pins.size() + numPins);
+	cell->nodesById.reserve(cell->nodesById.size() + numNodes);
+	cell->cellsById.reserve(cell->cellsById.size() + numInsts);
+}
+
+int hcmCellBuilder::addNode(string name, hcmPortDir dir){
+	nodes.push_back(nodeRec{move(name), dir, NULL});
+	return nodes.size() - 1;
+}
+
+int hcmCellBuilder::addNodes(const vector<string>& names, hcmPortDir dir){
+	int first = nodes.size();
+	for(auto it = names.begin(); it != names.end(); ++it) {
+		nodes.push_back(nodeRec{*it, dir, NULL});
+	}
+	return first;
+}
+
+int hcmCellBuilder::useNode(hcmNode* node){
+	nodes.push_back(nodeRec{string(), NOT_PORT, node});
+	return nodes.size() - 1;
+}
+
+int hcmCellBuilder::addInst(string name, hcmCell* master){
+	insts.push_back(instRec{move(name), master, NULL});
+	return insts.size() - 1;
+}
+
+int hcmCellBuilder::addInsts(const vector<string>& names, const vector<hcmCell*>& masters){
+	assert(names.size() == masters.size());
+	int first = insts.size();
+	for(size_t i = 0; i < names.size(); i++) {
+		insts.push_back(instRec{names[i], masters[i], NULL});
+	}
+	return first;
+}
+
+int hcmCellBuilder::useInst(hcmInstance* inst){
+	insts.push_back(instRec{string(), inst ? inst->masterCell() : NULL, inst});
+	return insts.size() - 1;
+}
+
+void hcmCellBuilder::addPin(int inst, int node, hcmPort* port){
+	pins.push_back(hcmBuilderPin{inst, node, port});
+}
+
+void hcmCellBuilder::addPins(const vector<hcmBuilderPin>& batch){
+	pins.insert(pins.end(), batch.begin(), batch.end());
+}
+
+bool hcmCellBuilder::validate(){
+	errors.clear();
+
+	// new nodes must have free names, existing ones must belong to the cell
+	unordered_set<string_view> names;
+	names.reserve(nodes.size() - committedNodes);
+	for(size_t n = committedNodes; n < nodes.size(); n++) {
+		nodeRec& rec = nodes[n];
+		if(rec.obj) {
+			if(rec.obj->owner() != cell) {
+				errors.push_back("node: " + rec.obj->getName() + " is not a node in the cell: " + cell->getName());
+			}
+		}
+		else if(rec.name.empty() || cell->getNode(rec.name) || cell->buses.count(rec.name) || !names.insert(rec.name).second) {
+			errors.push_back("node: " + rec.name + " already exists");
+		}
+	}
+
+	names.clear();
+	for(size_t i = committedInsts; i < insts.size(); i++) {
+		instRec& rec = insts[i];
+		if(rec.obj) {
+			if(rec.obj->owner() != cell) {
+				errors.push_back("instance: " + rec.obj->getName() + " is not an instance in the cell: " + cell->getName());
+			}
+		}
+		else if(rec.master == NULL || rec.master->owner() != cell->owner()) {
+			errors.push_back("instance: " + rec.name + " has no master cell in the design");
+		}
+		else if(rec.name.empty() || cell->getInst(rec.name) || !names.insert(rec.name).second) {
+			errors.push_back("instance: " + rec.name + " already exists");
+		}
+	}
+
+	// each master port may be connected once per instance. an instance in the cell may have several handles,
+	// so its pins are counted by the first handle they use for it
+	unordered_set<long long> used;
+	used.reserve(pins.size());
+	unordered_map<const hcmInstance*, int> objHandles;
+	for(size_t p = 0; p < pins.size(); p++) {
+		const hcmBuilderPin& pin = pins[p];
+		if(pin.inst < 0 || (size_t)pin.inst >= insts.size() || pin.node < 0 || (size_t)pin.node >= nodes.size()) {
+			errors.push_back("pin " + to_string(p) + " refers to an unknown node or instance");
+			continue;
+		}
+		const instRec& rec = insts[pin.inst];
+		if(rec.master == NULL) {
+			continue;
+		}
+		const vector<hcmPort*>& portTable = rec.master->getPortTable();
+		if(pin.port == NULL || (size_t)pin.port->getOrdinal() >= portTable.size() || portTable[pin.port->getOrdinal()] != pin.port) {
+			errors.push_back("pin " + to_string(p) + " is not a port of the master: " + rec.master->getName());
+			continue;
+		}
+		long long handle = rec.obj ? objHandles.emplace(rec.obj, pin.inst).first->second : pin.inst;
+		if((rec.obj && rec.obj->isConnected(pin.port)) ||
+		   !used.insert((handle << 32) | pin.port->getOrdinal()).second) {
+			errors.push_back("port: " + pin.port->getName() + " is already connected on instance: " + 
+			                 (rec.obj ? rec.obj->getName() : rec.name));
+		}
+	}
+	return errors.empty();
+}
+
+hcmRes hcmCellBuilder::commit(){
+	if(!validate()) {
+		return BAD_PARAM;
+	}
+	for(size_t n = committedNodes; n < nodes.size(); n++) {
+		nodeRec& rec = nodes[n];
+		if(rec.obj == NULL) {
+			rec.obj = cell->addNodeUnchecked(rec.name);
+			if(rec.dir != NOT_PORT) {
+				rec.obj->createPort(rec.dir);
+			}
+		}
+	}
+	for(size_t i = committedInsts; i < insts.size(); i++) {
+		instRec& rec = insts[i];
+		if(rec.obj == NULL) {
+			rec.obj = cell->addInstUnchecked(rec.name, rec.master);
+		}
+	}
+	for(auto it = pins.begin(); it != pins.end(); ++it) {
+		cell->connectUnchecked(insts[it->inst].obj, nodes[it->node].obj, it->port);
+	}
+	committedNodes = nodes.size();
+	committedInsts = insts.size();
+	pins.clear();
+	return OK;
+}
@@ -0,0 +1,94 @@
+#include "hcm.h"
+#include "hcmCompactNetlist.h"
+
+hcmCompactNetlist::hcmCompactNetlist(hcmCell* flatCell){
+	cell = flatCell;
+	builtGeneration = flatCell->getGeneration();
+
+	// nets
+	const map<string, hcmNode*>& nodes = flatCell->getNodes();
+	nets.reserve(nodes.size());
+	netPortDir.reserve(nodes.size());
+	netIdx.reserve(nodes.size());
+	for(auto it = nodes.begin(); it != nodes.end(); ++it) {
+		hcmNode* node = it->second;
+		netIdx[node] = nets.size();
+		nets.push_back(node);
+		const hcmPort* port = node->getPort();
+		netPortDir.push_back(port ? port->getDirection() : NOT_PORT);
+	}
+
+	// instances and their pins
+	const map<string, hcmInstance*>& cellInsts = flatCell->getInstances();
+	unordered_map<const hcmCell*, int> masterIdx;
+	insts.reserve(cellInsts.size());
+	instMaster.reserve(cellInsts.size());
+	instPinOffset.reserve(cellInsts.size() + 1);
+	instIdx.reserve(cellInsts.size());
+	for(auto it = cellInsts.begin(); it != cellInsts.end(); ++it) {
+		hcmInstance* inst = it->second;
+		hcmCell* master = inst->masterCell();
+		auto mI = masterIdx.find(master);
+		if(mI == masterIdx.end()) {
+			mI = masterIdx.emplace(master, masters.size()).first;
+			masters.push_back(master);
+		}
+		int i = insts.size();
+		instIdx[inst] = i;
+		insts.push_back(inst);
+		instMaster.push_back(mI->second);
+		instPinOffset.push_back(pins.size());
+
+		const map<string, hcmInstPort*>& ips = inst->getInstPorts();
+		for(auto ipI = ips.begin(); ipI != ips.end(); ++ipI) {
+			hcmInstPort* ip = ipI->second;
+			auto nI = netIdx.find(ip->getNode());
+			pins.push_back(ip);
+			pinInst.push_back(i);
+			pinNet.push_back(nI == netIdx.end() ? -1 : nI->second);
+			pinDir.push_back(ip->getPort() ? ip->getPort()->getDirection() : NOT_PORT);
+		}
+	}
+	instPinOffset.push_back(pins.size());
+
+	// fanin / fanout CSRs by direction
+	int numP = pins.size();
+	vector<char> isIn(numP), isOut(numP);
+	for(int p = 0; p < numP; p++) {
+		isIn[p] = (pinDir[p] == IN || pinDir[p] == IN_OUT) && pinNet[p] >= 0;
+		isOut[p] = (pinDir[p] == OUT || pinDir[p] == IN_OUT) && pinNet[p] >= 0;
+	}
+	buildCSR(nets.size(), pinNet, isOut, netFaninOffset, netFaninPins);
+	buildCSR(nets.size(), pinNet, isIn, netFanoutOffset, netFanoutPins);
+	buildCSR(insts.size(), pinInst, isIn, instFaninOffset, instFaninPins);
+	buildCSR(insts.size(), pinInst, isOut, instFanoutOffset, instFanoutPins);
+}
+
+void hcmCompactNetlist::buildCSR(int n, const vector<int>& key, const vector<char>& take, vector<int>& offset, vector<int>& items){
+	offset.assign(n + 1, 0);
+	for(size_t p = 0; p < key.size(); p++) {
+		if(take[p]) {
+			offset[key[p] + 1]++;
+		}
+	}
+	for(int i = 0; i < n; i++) {
+		offset[i + 1] += offset[i];
+	}
+	items.resize(offset[n]);
+	vector<int> fill(offset.begin(), offset.end() - 1);
+	for(size_t p = 0; p < key.size(); p++) {
+		if(take[p]) {
+			items[fill[key[p]]++] = p;
+		}
+	}
+}
+
+int hcmCompactNetlist::getInstIndex(const hcmInstance* inst) const{
+	auto it = instIdx.find(inst);
+	return it == instIdx.end() ? -1 : it->second;
+}
+
+int hcmCompactNetlist::getNetIndex(const hcmNode* node) const{
+	auto it = netIdx.find(node);
+	return it == netIdx.end() ? -1 : it->second;
+}
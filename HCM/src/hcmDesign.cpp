@@ -1,7 +1,11 @@
 #include "hcm.h"
+#include "hcmVerilogIR.h"
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 void hcmDesign::printInfo(){
-	cout << "Design " + name + " info:" <<endl;
+	cout << "Design " + getName() + " info:" <<endl;
 	for(auto it = cells.begin(); it != cells.end(); ++it) {
 		it->second->printInfo();
 	}
@@ -9,7 +13,11 @@ void hcmDesign::printInfo(){
 }
 
 hcmDesign::hcmDesign(string designName){
-	name = designName;
+	setName(nameTable, designName);
+	library = NULL;
+	parseCacheHits = 0;
+	releasing = false;
+	registerProps(&props);
 }
 
 hcmCell *hcmDesign::createCell(string name){
@@ -18,9 +26,11 @@ hcmCell *hcmDesign::createCell(string name){
 		return NULL;
 	}
 	hcmCell* cell = new hcmCell(name,this);
+	journal.notify(CELL_CREATED, cell, NULL, NULL, NULL);
 	cell->createNode("VDD");
 	cell->createNode("VSS");
 	cells[name] =cell;
+	cellsById[cell->nameId] = cell;
 	return cell;
 }
 
@@ -35,35 +45,179 @@ void hcmDesign::deleteCell(string name){
 	} 
 	else {
 		cells.erase(name);
+		cellsById.erase(cell->nameId);
 	}
 }
 
-hcmCell *hcmDesign::getCell(string name){
-	if(cells.count(name) == 0 ) {
-			return NULL;
+hcmCell *hcmDesign::getCell(string_view name){
+	auto cI = cellsById.find(nameTable.find(name));
+	if(cI == cellsById.end()) {
+		// a library module is built on its first use
+		return library ? library->build(name) : NULL;
 	}
-	return cells[name];
+	return cI->second;
+}
+
+const map< string, hcmCell* >& hcmDesign::getCells() const{
+	return cells;
+}
+
+hcmNameTable& hcmDesign::getNameTable(){
+	return nameTable;
+}
+
+const hcmNameTable& hcmDesign::getNameTable() const{
+	return nameTable;
+}
+
+// adds the map and the heap payload of its string keys
+template <typename M>
+static size_t namedMapBytes(const M& m) {
+	size_t res = hcmMapBytes(m);
+	for(auto it = m.begin(); it != m.end(); ++it) {
+		res += hcmStringBytes(it->first);
+	}
+	return res;
+}
+
+hcmMemoryReport hcmDesign::memoryReport() const{
+	hcmMemoryReport r = {};
+	r.cells.count = cells.size();
+	r.nodes.count = nodeArena.size();
+	r.ports.count = portArena.size();
+	r.instances.count = instArena.size();
+	r.instPorts.count = instPortArena.size();
+	r.cells.objectBytes = cells.size() * sizeof(hcmCell);
+	r.nodes.objectBytes = r.nodes.count * sizeof(hcmNode);
+	r.ports.objectBytes = r.ports.count * sizeof(hcmPort);
+	r.instances.objectBytes = r.instances.count * sizeof(hcmInstance);
+	r.instPorts.objectBytes = r.instPorts.count * sizeof(hcmInstPort);
+	r.arenaOverheadBytes = nodeArena.bytes() + portArena.bytes() + instArena.bytes() + instPortArena.bytes() -
+	                       r.nodes.objectBytes - r.ports.objectBytes - r.instances.objectBytes - r.instPorts.objectBytes;
+
+	for(auto cI = cells.begin(); cI != cells.end(); ++cI) {
+		const hcmCell* cell = cI->second;
+		r.cells.containerBytes += namedMapBytes(cell->cells) + namedMapBytes(cell->myInstances) + namedMapBytes(cell->nodes) +
+		                          namedMapBytes(cell->buses) + hcmHashBytes(cell->cellsById) + hcmHashBytes(cell->nodesById) +
+		                          hcmHashBytes(cell->busesById) + hcmVectorBytes(cell->portTable);
+		for(auto nI = cell->nodes.begin(); nI != cell->nodes.end(); ++nI) {
+			const hcmNode* node = nI->second;
+			r.nodes.instPortMapBytes += namedMapBytes(node->instPorts);
+		}
+		for(auto iI = cell->cells.begin(); iI != cell->cells.end(); ++iI) {
+			const hcmInstance* inst = iI->second;
+			r.instances.containerBytes += hcmVectorBytes(inst->instPortsByOrdinal);
+			r.instances.instPortMapBytes += namedMapBytes(inst->instPorts);
+		}
+		for(auto bI = cell->buses.begin(); bI != cell->buses.end(); ++bI) {
+			r.buses.count++;
+			r.buses.stringBytes += hcmStringBytes(bI->second.getName());
+			r.buses.containerBytes += bI->second.getWidth() * sizeof(hcmNode*);
+		}
+	}
+
+	r.propertyBytes = props.bytes();
+	r.nameTableBytes = nameTable.bytes();
+	r.nameTableNames = nameTable.size();
+	r.nameTableHitRate = nameTable.getStats().hitRate();
+	r.designBytes = sizeof(hcmDesign) + namedMapBytes(cells) + hcmHashBytes(cellsById) + journal.bytes() +
+	                (library ? library->bytes() : 0);
+	return r;
+}
+
+hcmJournal& hcmDesign::getJournal(){
+	return journal;
+}
+
+hcmPropStore& hcmDesign::getPropStore(){
+	return props;
 }
 
 hcmDesign::~hcmDesign(){
-	set<string> names;
+	bulkRelease();
+	delete library;
+	// the store is a member and is gone before ~hcmObject runs
+	propStore = NULL;
+}
+
+void hcmDesign::bulkRelease(){
+	releasing = true;
+	props.setReleasing(true);
+	// the objects point at each other, so none of them may unlink while any is gone
+	instPortArena.release();
+	portArena.release();
+	nodeArena.release();
+	instArena.release();
 	for(auto it = cells.begin(); it != cells.end(); ++it) {
-		names.insert(it->first);
+		delete it->second;
 	}
-	for(auto it = names.begin(); it != names.end() ; ++it){
-		hcmCell* elemToDelete = cells[*it];
-		cells.erase(*it);
-		if (elemToDelete){
-      		delete elemToDelete;
-    	}
+	cells.clear();
+	cellsById.clear();
+	props.setReleasing(false);
+	releasing = false;
+}
+
+hcmRes hcmDesign::parseStructuralVerilog(const char *fileName, hcmVerilogReader reader){
+	return parseStructuralVerilog(vector<string>(1, fileName), 1, reader);
+}
+
+hcmRes hcmDesign::parseStructuralVerilog(const vector<string>& fileNames, unsigned int numThreads, hcmVerilogReader reader){
+	vector<hcmParsedFile*> files(fileNames.size(), NULL);
+	vector<char> hits(fileNames.size(), false);
+	if(numThreads == 0) {
+		numThreads = max(1u, thread::hardware_concurrency());
 	}
+	numThreads = min(numThreads, (unsigned int)fileNames.size());
+
+	// the parse touches no shared state, each thread takes the next file until all are read
+	hcmParsedFile* (*readFile)(const char*) = (reader == VLOG_READER_FAST) ? read_verilog_file_fast : read_verilog_file;
+	atomic<size_t> next(0);
+	auto parseFiles = [&]() {
+		for(size_t i = next++; i < fileNames.size(); i = next++) {
+			const char* fn = fileNames[i].c_str();
+			bool hit = false;
+			files[i] = parseCacheDir.empty() ? readFile(fn) : read_verilog_file_cached(fn, parseCacheDir, readFile, hit);
+			hits[i] = hit;
+		}
+	};
+	vector<thread> threads;
+	for(unsigned int t = 1; t < numThreads; t++) {
+		threads.emplace_back(parseFiles);
+	}
+	parseFiles();
+	for(auto tI = threads.begin(); tI != threads.end(); ++tI) {
+		tI->join();
+	}
+
+	parseCacheHits += count(hits.begin(), hits.end(), true);
+	bool ok = true;
+	vector<hcmParsedFile*> parsed;
+	for(auto fI = files.begin(); fI != files.end(); ++fI) {
+		if(*fI == NULL) {
+			ok = false;
+			continue;
+		}
+		ok = ok && (*fI)->ok;
+		parsed.push_back(*fI);
+	}
+	hcmVerilogLinker(this).link(parsed);
+	for(auto fI = parsed.begin(); fI != parsed.end(); ++fI) {
+		delete *fI;
+	}
+	return ok ? BAD_PARAM : OK;
 }
 
-hcmRes hcmDesign::parseStructuralVerilog(const char *fileName){
-	extern int read_verilog(hcmDesign* design, const char *fn);
-	if (read_verilog(this,fileName)) {
-	  return BAD_PARAM;
+hcmRes hcmDesign::addVerilogLibrary(const char *fileName){
+	if(!library) {
+		library = new hcmVerilogLibrary(this);
 	}
-	return OK;
+	return library->addFile(fileName) ? OK : BAD_PARAM;
+}
+
+void hcmDesign::setParseCacheDir(const string& dir){
+	parseCacheDir = dir;
 }
 
+size_t hcmDesign::getParseCacheHits() const{
+	return parseCacheHits;
+}
@@ -0,0 +1,153 @@
+#include "hcm.h"
+#include "hcmFingerprint.h"
+
+// number of neighborhood refinement rounds, a label sees the structure this many pins away.
+#define HCM_FP_ROUNDS 3
+
+static inline uint64_t mix(uint64_t x) {
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+static inline uint64_t combine(uint64_t a, uint64_t b) {
+	return mix(a ^ (b + 0x9e3779b97f4a7c15ULL + (a << 6) + (a >> 2)));
+}
+
+// FNV-1a, names must hash the same in every run and every design
+static uint64_t hashName(const string& name) {
+	uint64_t h = 0xcbf29ce484222325ULL;
+	for(size_t i = 0; i < name.size(); i++) {
+		h ^= (unsigned char)name[i];
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+hcmFingerprinter::hcmFingerprinter(hcmDesign* d, const set<string>& glbNodes)
+	: design(d), globalNodes(glbNodes) {
+}
+
+hcmFingerprint hcmFingerprinter::getFingerprint(const hcmCell* cell){
+	hcmGeneration current = design->getJournal().getGeneration();
+	auto cI = cache.find(cell);
+	if(cI != cache.end() && cI->second.checkedAt == current) {
+		return cI->second.fp;
+	}
+
+	// bring the masters up to date first, each one is checked once per design generation
+	hcmFingerprint mastersSig = 0;
+	const map<string, hcmInstance*>& insts = cell->getInstances();
+	for(auto iI = insts.begin(); iI != insts.end(); ++iI) {
+		mastersSig += mix(getFingerprint(iI->second->masterCell()));
+	}
+
+	entry& e = cache[cell];
+	if(e.checkedAt != 0 && e.gen == cell->getGeneration() && e.mastersSig == mastersSig) {
+		e.checkedAt = current;
+		return e.fp;
+	}
+	e.fp = compute(cell);
+	e.gen = cell->getGeneration();
+	e.mastersSig = mastersSig;
+	e.checkedAt = current;
+	return e.fp;
+}
+
+hcmFingerprint hcmFingerprinter::compute(const hcmCell* cell){
+	// initial labels - nodes by their connection to the outside, instances by their master
+	const map<string, hcmNode*>& nodes = cell->getNodes();
+	vector<uint64_t> netLabel;
+	netLabel.reserve(nodes.size());
+	unordered_map<const hcmNode*, int> netIdx;
+	for(auto nI = nodes.begin(); nI != nodes.end(); ++nI) {
+		const hcmNode* node = nI->second;
+		const hcmPort* port = node->getPort();
+		uint64_t label;
+		if(port) {
+			label = combine(combine(1, port->getDirection()), hashName(nI->first));
+		}
+		else if(globalNodes.find(nI->first) != globalNodes.end()) {
+			label = combine(2, hashName(nI->first));
+		}
+		else {
+			label = 3;
+		}
+		netIdx[node] = netLabel.size();
+		netLabel.push_back(label);
+	}
+
+	const map<string, hcmInstance*>& insts = cell->getInstances();
+	vector<uint64_t> instLabel;
+	instLabel.reserve(insts.size());
+	vector<int> pinInst, pinNet;
+	vector<uint64_t> pinKey;
+	for(auto iI = insts.begin(); iI != insts.end(); ++iI) {
+		const hcmInstance* inst = iI->second;
+		int i = instLabel.size();
+		instLabel.push_back(cache.at(inst->masterCell()).fp);
+		const map<string, hcmInstPort*>& instPorts = inst->getInstPorts();
+		for(auto pI = instPorts.begin(); pI != instPorts.end(); ++pI) {
+			const hcmInstPort* instPort = pI->second;
+			if(instPort->getNode() == NULL) {
+				continue;
+			}
+			pinInst.push_back(i);
+			pinNet.push_back(netIdx.at(instPort->getNode()));
+			pinKey.push_back(hashName(instPort->getPort()->getName()));
+		}
+	}
+
+	// refinement - each label absorbs the multiset of (master port, neighbor label) of its pins
+	vector<uint64_t> instAcc(instLabel.size()), netAcc(netLabel.size());
+	for(int r = 0; r < HCM_FP_ROUNDS; r++) {
+		fill(instAcc.begin(), instAcc.end(), 0);
+		fill(netAcc.begin(), netAcc.end(), 0);
+		for(size_t p = 0; p < pinKey.size(); p++) {
+			instAcc[pinInst[p]] += mix(combine(pinKey[p], netLabel[pinNet[p]]));
+			netAcc[pinNet[p]] += mix(combine(pinKey[p], instLabel[pinInst[p]]));
+		}
+		for(size_t i = 0; i < instLabel.size(); i++) {
+			instLabel[i] = combine(instLabel[i], instAcc[i]);
+		}
+		for(size_t n = 0; n < netLabel.size(); n++) {
+			netLabel[n] = combine(netLabel[n], netAcc[n]);
+		}
+	}
+
+	uint64_t instSum = 0, netSum = 0;
+	for(size_t i = 0; i < instLabel.size(); i++) {
+		instSum += mix(instLabel[i]);
+	}
+	for(size_t n = 0; n < netLabel.size(); n++) {
+		netSum += mix(netLabel[n]);
+	}
+	uint64_t h = combine(combine(instLabel.size(), netLabel.size()), combine(instSum, netSum));
+	if(insts.empty()) {
+		h = combine(h, hashName(cell->getName()));
+	}
+	return h;
+}
+
+map< hcmFingerprint, vector<const hcmCell*> > hcmFingerprinter::getClasses(const hcmCell* top){
+	map< hcmFingerprint, vector<const hcmCell*> > classes;
+	set<const hcmCell*> visited;
+	vector<const hcmCell*> stack(1, top);
+	visited.insert(top);
+	while(!stack.empty()) {
+		const hcmCell* cell = stack.back();
+		stack.pop_back();
+		classes[getFingerprint(cell)].push_back(cell);
+		const map<string, hcmInstance*>& insts = cell->getInstances();
+		for(auto iI = insts.begin(); iI != insts.end(); ++iI) {
+			const hcmCell* master = iI->second->masterCell();
+			if(visited.insert(master).second) {
+				stack.push_back(master);
+			}
+		}
+	}
+	return classes;
+}
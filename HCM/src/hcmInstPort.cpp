@@ -1,7 +1,7 @@
 #include "hcm.h"
 
 void hcmInstPort::printInfo(){
-  cout << "\t\tInstPort: " +name; 
+  cout << "\t\tInstPort: " + getName(); 
   if (connectedNode) 
     cout << " Node: " << connectedNode->getName();
   cout << endl;
@@ -11,19 +11,31 @@ hcmInstPort::hcmInstPort(hcmInstance* instance, hcmNode* node, hcmPort* port){
 	inst = instance;
 	connectedNode = node;
 	connectedPort = port;
-	// required to be unique name as node instPort is map by name !!!
-	name = inst->getName()+'%'+port->getName();
+	registerProps(&inst->owner()->owner()->props);
 }
 
 hcmInstPort::~hcmInstPort(){
 	destructorCalled = true;
+	if (hcmArenaBase::isReleasing(this)) {
+		return;
+	}
 
+	hcmCell* cell = inst->owner();
+	cell->owner()->journal.notify(DISCONNECTED, cell, inst, connectedNode, connectedPort);
 	hcmCell::disConnect(this);
 	inst = NULL;
 	connectedNode = NULL;
 	connectedPort = NULL;
 }
 
+const string hcmInstPort::getName() const {
+	// required to be unique name as node instPort is map by name !!!
+	if (inst == NULL || connectedPort == NULL) {
+		return string();
+	}
+	return inst->getName()+'%'+connectedPort->getName();
+}
+
 hcmNode* hcmInstPort::getNode() const {
 	return connectedNode;
 }
@@ -38,4 +50,16 @@ hcmInstance* hcmInstPort::getInst() const {
 
 void hcmInstPort::setConnectedNode(hcmNode *connectedNode) {
 	this->connectedNode = connectedNode;
-}
\ No newline at end of file
+}
+
+void* hcmInstPort::operator new(size_t size, hcmDesign* design){
+	return hcmArenaBase::allocate(&design->instPortArena, size);
+}
+
+void hcmInstPort::operator delete(void* obj, hcmDesign* design){
+	hcmArenaBase::deallocate(obj);
+}
+
+void hcmInstPort::operator delete(void* obj){
+	hcmArenaBase::deallocate(obj);
+}
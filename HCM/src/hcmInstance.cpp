@@ -5,21 +5,24 @@ bool startsWith(string source, string prefix) {
 }
 
 void hcmInstance::printInfo(){
-  cout << "\tInstance " + name + " owner: " + cell->getName() + " master: " + master->getName() << endl;
+  cout << "\tInstance " + getName() + " owner: " + cell->getName() + " master: " + master->getName() << endl;
   for(auto it = instPorts.begin(); it != instPorts.end(); ++it) {
     it->second->printInfo();
   }
 }
 
 hcmInstance::hcmInstance(string instanceName, hcmCell* masterCell){
-  name = instanceName;
   master = masterCell;
   cell = NULL;
+  setName(master->owner()->getNameTable(), instanceName);
+  registerProps(&master->owner()->props);
 }
 
 hcmInstance::~hcmInstance(){
   destructorCalled = true;
-  cell->deleteInst(name);
+  if (hcmArenaBase::isReleasing(this)) {
+    return;
+  }
 
   set<string> names;
 	// delete the instPorts map
@@ -33,6 +36,9 @@ hcmInstance::~hcmInstance(){
       delete elemToDelete;
     }
 	}
+  // unlinked from the cell after the instPorts, their removal is reported in the cell
+  cell->owner()->journal.notify(INST_DELETED, cell, this, NULL, NULL);
+  cell->deleteInst(getName());
 
   master = NULL;
   cell = NULL;
@@ -54,47 +60,25 @@ hcmCell* hcmInstance::masterCell(){
 }
 
 vector<hcmPort*> hcmInstance::getAvailablePorts(){
-  vector<hcmPort*> allPorts = master->getPorts();
   vector<hcmPort*> availablePorts;
-  for(auto it = allPorts.begin(); it != allPorts.end() ; it++) {
-    bool found = false;
-    for(auto ipit = instPorts.begin(); ipit != instPorts.end(); ++ipit) {
-      if((*it)->getName() == ipit->second->getPort()->getName()) {
-        found = true;
-        break;
-      }
-    }
-    if(!found) { 
-      availablePorts.push_back(*it); 
+  // walk the master nodes directly to keep the name order of getPorts()
+  const map<string, hcmNode*>& masterNodes = master->getNodes();
+  for(auto it = masterNodes.begin(); it != masterNodes.end() ; it++) {
+    hcmPort* port = it->second->getPort();
+    if(port != NULL && !isConnected(port)) { 
+      availablePorts.push_back(port); 
     }
   }
   return availablePorts;
 }
 
 vector<hcmPort*> hcmInstance::getAvailablePorts(string nodeName){
-  vector<hcmPort*> allPorts = master->getPorts();
   vector<hcmPort*> availablePorts;
 
-  // if the node name is a known bus
-  map< string, pair<int,int> > buses = master->getBuses();
-  if (buses.find(nodeName) != buses.end()) {
-    int from = buses[nodeName].first;
-    int to = buses[nodeName].second;
-    // loop over all bus nodes and add to available port if they are ports...
-    if (from <= to) {
-      for (int i = from; i <= to; i++) {
-	      hcmPort *port = master->getPort(busNodeName(nodeName, i));
-	      if (port) 
-	        availablePorts.push_back(port);
-      }
-    }
-    else {
-      for (int i = from; i >= to; i--) {
-        hcmPort *port = master->getPort(busNodeName(nodeName, i));
-        if (port) 
-          availablePorts.push_back(port);
-      }
-    }
+  // if the node name is a known bus take its bit ports by index
+  const hcmBus* bus = master->getBus(nodeName);
+  if (bus) {
+    availablePorts = bus->getPorts();
   } 
   else {
     hcmPort *port = master->getPort(nodeName);
@@ -105,35 +89,68 @@ vector<hcmPort*> hcmInstance::getAvailablePorts(string nodeName){
 
   // making sure not ALREADY CONNECTED
   for(auto it = availablePorts.begin(); it != availablePorts.end() ; it++) {
-    for(auto ipit = instPorts.begin(); ipit != instPorts.end(); ++ipit) {
-      if((*it)->getName() == ipit->second->getPort()->getName()) {
-        //This bus is in use!
-        availablePorts.clear();
-        return availablePorts;
-      }
+    if(isConnected(*it)) {
+      //This bus is in use!
+      availablePorts.clear();
+      return availablePorts;
     }
   }
   return availablePorts;
 }
 
-hcmInstPort* hcmInstance::getInstPort(string name)
+hcmInstPort* hcmInstance::getInstPort(string_view name)
 {
-  auto iI = instPorts.find(name);
-  if (iI == instPorts.end()) {
+  return getInstPort(instPortMasterPort(name));
+}
+
+const hcmInstPort* hcmInstance::getInstPort(string_view name) const
+{
+  return getInstPort(instPortMasterPort(name));
+}
+
+hcmInstPort* hcmInstance::getInstPort(const hcmPort* port)
+{
+  if (!port || (size_t)port->getOrdinal() >= instPortsByOrdinal.size()) {
+    return NULL;
+  }
+  hcmInstPort* instPort = instPortsByOrdinal[port->getOrdinal()];
+  // an ordinal of a port of another cell may hit an unrelated slot
+  if (instPort == NULL || instPort->getPort() != port) {
     return NULL;
-  } else {
-    return (*iI).second;
   }
+  return instPort;
+}
+
+const hcmInstPort* hcmInstance::getInstPort(const hcmPort* port) const
+{
+  return const_cast<hcmInstance*>(this)->getInstPort(port);
+}
+
+bool hcmInstance::isConnected(const hcmPort* port) const
+{
+  return getInstPort(port) != NULL;
+}
+
+void hcmInstance::setInstPortByOrdinal(int ordinal, hcmInstPort* instPort)
+{
+  if ((size_t)ordinal >= instPortsByOrdinal.size()) {
+    if (instPort == NULL) {
+      return;
+    }
+    // size for all the ports the master has now, so later connects do not grow it again
+    instPortsByOrdinal.resize(max((size_t)ordinal + 1, master->getPortTable().size()), NULL);
+  }
+  instPortsByOrdinal[ordinal] = instPort;
 }
 
-const hcmInstPort* hcmInstance::getInstPort(string name) const
+const hcmPort* hcmInstance::instPortMasterPort(string_view instPortName) const
 {
-  map< string , hcmInstPort *>::const_iterator iI = instPorts.find(name);
-  if (iI == instPorts.end()) {
+  // instPort names are <inst>%<port> - strip our own name and look up the port name
+  size_t len = nameTable->nameSize(nameId);
+  if (instPortName.size() <= len || !nameTable->isPrefixOf(nameId, instPortName) || instPortName[len] != '%') {
     return NULL;
-  } else {
-    return (*iI).second;
   }
+  return ((const hcmCell*)master)->getPort(instPortName.substr(len + 1));
 }
 
 map<string, hcmInstPort* >& hcmInstance::getInstPorts()
@@ -148,4 +165,16 @@ const map<string, hcmInstPort* >& hcmInstance::getInstPorts() const
 
 const hcmCell* hcmInstance::masterCell() const { 
   return master; 
-}
\ No newline at end of file
+}
+
+void* hcmInstance::operator new(size_t size, hcmDesign* design){
+  return hcmArenaBase::allocate(&design->instArena, size);
+}
+
+void hcmInstance::operator delete(void* obj, hcmDesign* design){
+  hcmArenaBase::deallocate(obj);
+}
+
+void hcmInstance::operator delete(void* obj){
+  hcmArenaBase::deallocate(obj);
+}
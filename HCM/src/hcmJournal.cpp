@@ -0,0 +1,27 @@
+#include "hcm.h"
+#include <algorithm>
+
+void hcmJournal::subscribe(hcmChangeListener* listener){
+	listeners.push_back(listener);
+}
+
+void hcmJournal::unsubscribe(hcmChangeListener* listener){
+	listeners.erase(remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+void hcmJournal::notify(hcmChangeType type, hcmCell* cell, hcmInstance* inst, hcmNode* node, hcmPort* port){
+	generation++;
+	cell->generation = generation;
+	if(recording) {
+		records.push_back(hcmChangeRecord{type, generation, cell->getNameId(),
+		                                  inst ? inst->getNameId() : HCM_NO_NAME,
+		                                  node ? node->getNameId() : HCM_NO_NAME,
+		                                  port ? port->getNameId() : HCM_NO_NAME});
+	}
+	if(!listeners.empty()) {
+		hcmChange change = {type, generation, cell, inst, node, port};
+		for(auto it = listeners.begin(); it != listeners.end(); ++it) {
+			(*it)->onChange(change);
+		}
+	}
+}
@@ -0,0 +1,113 @@
+#include "hcm.h"
+#include <iomanip>
+#include <mutex>
+#include <new>
+
+size_t hcmMemoryReport::totalBytes() const{
+	return cells.total() + nodes.total() + ports.total() + instances.total() + instPorts.total() + buses.total() +
+	       arenaOverheadBytes + propertyBytes + nameTableBytes + designBytes;
+}
+
+static void printUsage(ostream& os, const char* type, const hcmMemoryUsage& u) {
+	os << "  " << left << setw(10) << type << right
+	   << setw(10) << u.count << setw(12) << u.objectBytes << setw(12) << u.containerBytes
+	   << setw(12) << u.stringBytes << setw(12) << u.instPortMapBytes << setw(12) << u.total() << endl;
+}
+
+void hcmMemoryReport::print(ostream& os) const{
+	os << "  " << left << setw(10) << "type" << right
+	   << setw(10) << "count" << setw(12) << "objects" << setw(12) << "containers"
+	   << setw(12) << "strings" << setw(12) << "instPortMap" << setw(12) << "total" << endl;
+	printUsage(os, "cell", cells);
+	printUsage(os, "node", nodes);
+	printUsage(os, "port", ports);
+	printUsage(os, "instance", instances);
+	printUsage(os, "instPort", instPorts);
+	printUsage(os, "bus", buses);
+	os << "  arena overhead: " << arenaOverheadBytes << endl;
+	os << "  properties: " << propertyBytes << endl;
+	os << "  name table: " << nameTableBytes << " (" << nameTableNames << " names, hit rate " << nameTableHitRate << ")" << endl;
+	os << "  design: " << designBytes << endl;
+	os << "  total: " << totalBytes() << " bytes";
+	if(instances.count) {
+		os << ", " << totalBytes() / instances.count << " bytes per instance";
+	}
+	os << endl;
+}
+
+// the phase the allocations of this thread are counted into, NULL for none.
+static thread_local hcmAllocStats* currentPhase = NULL;
+
+static map<string, hcmAllocStats>& allocPhases() {
+	static map<string, hcmAllocStats> phases;
+	return phases;
+}
+// phases are started from several threads, the counters of a phase are updated atomically
+static mutex allocPhasesLock;
+
+hcmAllocPhase::hcmAllocPhase(const string& name){
+	prev = currentPhase;
+	// the map node is allocated into the enclosing phase, before switching
+	lock_guard<mutex> guard(allocPhasesLock);
+	hcmAllocStats* stats = &allocPhases()[name];
+	currentPhase = stats;
+}
+
+hcmAllocPhase::~hcmAllocPhase(){
+	currentPhase = prev;
+}
+
+map<string, hcmAllocStats> hcmAllocPhase::getStats(){
+	lock_guard<mutex> guard(allocPhasesLock);
+	map<string, hcmAllocStats> stats;
+	const map<string, hcmAllocStats>& phases = allocPhases();
+	for(auto it = phases.begin(); it != phases.end(); ++it) {
+		hcmAllocStats& phase = stats[it->first];
+		phase.allocs = __atomic_load_n(&it->second.allocs, __ATOMIC_RELAXED);
+		phase.bytes = __atomic_load_n(&it->second.bytes, __ATOMIC_RELAXED);
+	}
+	return stats;
+}
+
+void hcmAllocPhase::reset(){
+	lock_guard<mutex> guard(allocPhasesLock);
+	map<string, hcmAllocStats>& phases = allocPhases();
+	for(auto it = phases.begin(); it != phases.end(); ++it) {
+		__atomic_store_n(&it->second.allocs, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&it->second.bytes, 0, __ATOMIC_RELAXED);
+	}
+}
+
+#ifdef HCM_ALLOC_HOOK
+
+bool hcmAllocPhase::enabled(){
+	return true;
+}
+
+void* operator new(size_t size){
+	if(currentPhase) {
+		__atomic_fetch_add(&currentPhase->allocs, 1, __ATOMIC_RELAXED);
+		__atomic_fetch_add(&currentPhase->bytes, size, __ATOMIC_RELAXED);
+	}
+	void* p = malloc(size ? size : 1);
+	if(p == NULL) {
+		throw bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void* p) noexcept{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept{
+	free(p);
+}
+
+#else
+
+bool hcmAllocPhase::enabled(){
+	return false;
+}
+
+#endif
@@ -0,0 +1,183 @@
+#include "hcm.h"
+
+// the key of a name in the index - its parent path and its leaf
+static inline uint64_t pathKey(hcmNameId parent, int leaf){
+	return ((uint64_t)(uint32_t)(parent + 1) << 32) | (uint32_t)leaf;
+}
+
+hcmNameTable::hcmNameTable(){
+	lastPathId = HCM_NO_NAME;
+	stats = hcmStringPoolStats();
+}
+
+hcmNameId hcmNameTable::addName(hcmNameId parent, string_view leaf){
+	int leafId = leaves.intern(leaf);
+	auto res = ids.emplace(pathKey(parent, leafId), (hcmNameId)names.size());
+	if(res.second) {
+		names.push_back(pathName{parent, leafId});
+	}
+	return res.first->second;
+}
+
+hcmNameId hcmNameTable::internPath(string_view name){
+	size_t slash = name.rfind('/');
+	if(slash == string_view::npos) {
+		return addName(HCM_NO_NAME, name);
+	}
+	// the names of an occurrence come together, so the path is usually the one of the last name
+	string_view path = name.substr(0, slash);
+	if(lastPathId == HCM_NO_NAME || path != lastPath) {
+		hcmNameId pathId = internPath(path);
+		lastPath.assign(path.data(), path.size());
+		lastPathId = pathId;
+	}
+	return addName(lastPathId, name.substr(slash + 1));
+}
+
+void hcmNameTable::count(size_t numNames, hcmNameId id){
+	stats.lookups++;
+	if(id < (hcmNameId)numNames) {
+		stats.hits++;
+	}
+	stats.bytes = leaves.getStats().bytes;
+	stats.chunkBytes = leaves.getStats().chunkBytes;
+}
+
+hcmNameId hcmNameTable::intern(string_view name){
+	size_t numNames = names.size();
+	hcmNameId id = internPath(name);
+	count(numNames, id);
+	return id;
+}
+
+hcmNameId hcmNameTable::intern(hcmNameId parent, string_view leaf){
+	size_t numNames = names.size();
+	hcmNameId id = addName(parent, leaf);
+	count(numNames, id);
+	return id;
+}
+
+hcmNameId hcmNameTable::find(string_view name) const{
+	hcmNameId id = HCM_NO_NAME;
+	size_t begin = 0;
+	while(true) {
+		size_t slash = name.find('/', begin);
+		int leafId = leaves.find(name.substr(begin, slash == string_view::npos ? string_view::npos : slash - begin));
+		if(leafId < 0) {
+			return HCM_NO_NAME;
+		}
+		auto it = ids.find(pathKey(id, leafId));
+		if(it == ids.end()) {
+			return HCM_NO_NAME;
+		}
+		id = it->second;
+		if(slash == string_view::npos) {
+			return id;
+		}
+		begin = slash + 1;
+	}
+}
+
+size_t hcmNameTable::nameSize(hcmNameId id) const{
+	size_t len = 0;
+	for(hcmNameId p = id; p != HCM_NO_NAME; p = names[p].parent) {
+		len += getLeaf(p).size() + (names[p].parent != HCM_NO_NAME);
+	}
+	return len;
+}
+
+bool hcmNameTable::isPrefixOf(hcmNameId id, string_view s) const{
+	// match the segments from the leaf back
+	size_t end = nameSize(id);
+	if(end > s.size()) {
+		return false;
+	}
+	for(hcmNameId p = id; p != HCM_NO_NAME; p = names[p].parent) {
+		string_view leaf = getLeaf(p);
+		end -= leaf.size();
+		if(s.compare(end, leaf.size(), leaf) != 0) {
+			return false;
+		}
+		if(names[p].parent != HCM_NO_NAME && s[--end] != '/') {
+			return false;
+		}
+	}
+	return true;
+}
+
+void hcmNameTable::appendName(hcmNameId id, string& out) const{
+	// size the name by its segments, then fill it from its leaf back
+	size_t end = out.size() + nameSize(id);
+	out.resize(end);
+	for(hcmNameId p = id; p != HCM_NO_NAME; p = names[p].parent) {
+		string_view leaf = getLeaf(p);
+		end -= leaf.size();
+		memcpy(&out[end], leaf.data(), leaf.size());
+		if(names[p].parent != HCM_NO_NAME) {
+			out[--end] = '/';
+		}
+	}
+}
+
+string hcmNameTable::getName(hcmNameId id) const{
+	string res;
+	appendName(id, res);
+	return res;
+}
+
+bool hcmNameTable::isUnder(hcmNameId id, hcmNameId path) const{
+	// a parent is always interned before its names
+	for(hcmNameId p = id; p != HCM_NO_NAME && p >= path; p = names[p].parent) {
+		if(p == path) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int hcmNameTable::compare(hcmNameId a, hcmNameId b) const{
+	if(a == b) {
+		return 0;
+	}
+	if(names[a].parent == names[b].parent) {
+		return getLeaf(a).compare(getLeaf(b));
+	}
+	// compare the segments from the root, a name ending before the other is followed by nothing, else by '/'
+	vector<string_view> segsA, segsB;
+	for(hcmNameId p = a; p != HCM_NO_NAME; p = names[p].parent) {
+		segsA.push_back(getLeaf(p));
+	}
+	for(hcmNameId p = b; p != HCM_NO_NAME; p = names[p].parent) {
+		segsB.push_back(getLeaf(p));
+	}
+	auto sA = segsA.rbegin(), sB = segsB.rbegin();
+	for(; sA != segsA.rend() && sB != segsB.rend(); ++sA, ++sB) {
+		size_t common = min(sA->size(), sB->size());
+		int res = sA->substr(0, common).compare(sB->substr(0, common));
+		if(res) {
+			return res;
+		}
+		if(sA->size() == sB->size()) {
+			continue;
+		}
+		bool aShort = sA->size() < sB->size();
+		bool moreA = (sA + 1) != segsA.rend(), moreB = (sB + 1) != segsB.rend();
+		if(aShort) {
+			return moreA ? (int)(unsigned char)'/' - (int)(unsigned char)(*sB)[common] : -1;
+		}
+		return moreB ? (int)(unsigned char)(*sA)[common] - (int)(unsigned char)'/' : 1;
+	}
+	return (sA != segsA.rend()) - (sB != segsB.rend());
+}
+
+size_t hcmNameTable::size() const{
+	return names.size();
+}
+
+size_t hcmNameTable::bytes() const{
+	return leaves.bytes() + hcmVectorBytes(names) + hcmHashBytes(ids) + hcmStringBytes(lastPath);
+}
+
+const hcmStringPoolStats& hcmNameTable::getStats() const{
+	return stats;
+}
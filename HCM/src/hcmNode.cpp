@@ -15,20 +15,26 @@ void hcmNode::printInfo(){
 	if(port == NULL){
 		hasPort = "NO";
 	}
-	cout << "\tNode: " + name + " ownerCell: " +cell->getName() + " has port: " + hasPort << endl;
+	cout << "\tNode: " + getName() + " ownerCell: " +cell->getName() + " has port: " + hasPort << endl;
 	for(auto it = instPorts.begin(); it != instPorts.end(); ++it) {
 				it->second->printInfo();
 	}
 }
 
 hcmNode::hcmNode(string nodeName, hcmCell *ownerCell){
-	name = nodeName;
 	cell = ownerCell;
 	port = NULL;
+	bus = NULL;
+	busIndex = 0;
+	setName(cell->owner()->getNameTable(), nodeName);
+	registerProps(&cell->owner()->props);
 }
 
 hcmNode::~hcmNode(){
 	destructorCalled = true;
+	if (hcmArenaBase::isReleasing(this)) {
+		return;
+	}
 
 	set<string> names;
 	// delete the instPorts map
@@ -44,12 +50,17 @@ hcmNode::~hcmNode(){
 	}
 
 	deletePort();
-	cell->deleteNode(name);
+	if(bus) {
+		bus->bits[busIndex - bus->getLow()] = NULL;
+	}
+	cell->owner()->journal.notify(NODE_DELETED, cell, NULL, this, NULL);
+	cell->deleteNode(getName());
 }
 
 hcmPort* hcmNode::createPort(hcmPortDir dir){
 	//port = new hcmPort(name+'_'+hcmPortDirNames[dir], this,dir);
-	port = new hcmPort(name, this,dir);
+	port = new (cell->owner()) hcmPort(getName(), this,dir);
+	cell->owner()->journal.notify(PORT_CREATED, cell, NULL, this, port);
 	return port;
 }
 
@@ -80,7 +91,7 @@ const hcmPort* hcmNode::getPort() const{
 
 bool hcmNode::connectPort(hcmInstPort* instPort){
 	if(port == NULL){
-		cout << "Cannot connect port in node: " + name + " because it doesn't have a port." << endl;
+		cout << "Cannot connect port in node: " + getName() + " because it doesn't have a port." << endl;
 		return false;
 	}
 	port->instPorts[instPort->getName()] = instPort;
@@ -104,3 +115,22 @@ const map<string, hcmInstPort* > &hcmNode::getInstPorts() const{
 	return instPorts;
 }
 
+void* hcmNode::operator new(size_t size, hcmDesign* design){
+	return hcmArenaBase::allocate(&design->nodeArena, size);
+}
+
+void hcmNode::operator delete(void* obj, hcmDesign* design){
+	hcmArenaBase::deallocate(obj);
+}
+
+void hcmNode::operator delete(void* obj){
+	hcmArenaBase::deallocate(obj);
+}
+
+hcmBus* hcmNode::getBus() const {
+	return bus;
+}
+
+int hcmNode::getBusIndex() const {
+	return busIndex;
+}
@@ -2,25 +2,52 @@
 
 hcmObject::hcmObject(){
 	destructorCalled = false;
+	nameTable = NULL;
+	nameId = HCM_NO_NAME;
+	propStore = NULL;
+	objId = HCM_NO_OBJ;
 }
 
 hcmObject::~hcmObject(){
 	destructorCalled = true;
-	set<string> names;
-	for(auto it = props.begin(); it != props.end(); ++it) {
-		names.insert(it->first);
-	}
-	for(auto it = names.begin(); it != names.end() ; ++it){
-		hcmProperty* elemToDelete = props[*it];
-		props.erase(*it);
-		if (elemToDelete){
-			delete elemToDelete;
-		}
+	if(propStore) {
+		propStore->releaseObject(objId);
 	}
 }
 
+void hcmObject::registerProps(hcmPropStore* store){
+	propStore = store;
+	objId = store->newObject();
+}
+
+void hcmObject::setName(hcmNameTable& table, string_view objName){
+	nameTable = &table;
+	nameId = table.intern(objName);
+}
+
 const string hcmObject::getName() const {
-	return name;
+	return nameTable ? nameTable->getName(nameId) : string();
+}
+
+hcmNameId hcmObject::getNameId() const {
+	return nameId;
+}
+
+hcmObjId hcmObject::getObjId() const {
+	return objId;
+}
+
+bool hcmObject::propHasName(const string& name) const {
+	if(propStore == NULL) {
+		return false;
+	}
+	vector<int> keys = hcmPropKeyBase::findKeys(name);
+	for(auto it = keys.begin(); it != keys.end(); ++it) {
+		if(propStore->has(*it, objId)) {
+			return true;
+		}
+	}
+	return false;
 }
 
 
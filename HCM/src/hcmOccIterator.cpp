@@ -0,0 +1,137 @@
+#include "hcm.h"
+#include "hcmOccIterator.h"
+
+hcmOccIterator::hcmOccIterator(const hcmCell* topCell, const set<string>& glbNodes)
+	: top(topCell), globalNodes(glbNodes) {
+	serials = 0;
+	started = false;
+}
+
+void hcmOccIterator::push(const hcmInstance* inst, const hcmCell* cell){
+	frames.emplace_back();
+	frame& f = frames.back();
+	f.inst = inst;
+	f.cell = cell;
+	f.serial = serials++;
+	f.next = cell->getInstances().begin();
+}
+
+bool hcmOccIterator::nextFrame(){
+	if(!started) {
+		started = true;
+		push(NULL, top);
+		return true;
+	}
+	while(!frames.empty()) {
+		frame& f = frames.back();
+		if(f.next != f.cell->getInstances().end()) {
+			const hcmInstance* inst = f.next->second;
+			++f.next;
+			push(inst, inst->masterCell());
+			return true;
+		}
+		frames.pop_back();
+	}
+	return false;
+}
+
+bool hcmOccIterator::nextLeaf(){
+	while(nextFrame()) {
+		if(depth() > 0 && cell()->getInstances().empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+string hcmOccIterator::getHName(int d) const{
+	string res;
+	for(int i = 1; i <= d; i++) {
+		if(i > 1) {
+			res += HIER_SEPARATOR;
+		}
+		res += frames[i].inst->getName();
+	}
+	return res;
+}
+
+void hcmOccIterator::makeNet(int d, const hcmNode* node, hcmOccNet& net) const{
+	net.frame = d;
+	net.frameSerial = frames[d].serial;
+	net.node = node;
+	net.global = false;
+}
+
+bool hcmOccIterator::resolve(int d, const hcmNode* node, hcmOccNet& net){
+	frame& f = frames[d];
+	auto mI = f.memo.find(node);
+	if(mI != f.memo.end()) {
+		net = mI->second;
+		return net.frame >= 0;
+	}
+
+	bool ok = true;
+	const hcmPort* port = node->getPort();
+	if(d == 0) {
+		makeNet(0, node, net);
+	}
+	else if(port == NULL) {
+		// stopped inside the hierarchy - may be a global node connected by name
+		if(globalNodes.find(node->getName()) != globalNodes.end()) {
+			const hcmNode* topNode = top->getNode(node->getName());
+			if(topNode) {
+				makeNet(0, topNode, net);
+			}
+			else {
+				makeNet(0, node, net);
+				net.global = true;
+			}
+		}
+		else {
+			makeNet(d, node, net);
+		}
+	}
+	else {
+		const hcmInstPort* instPort = f.inst->getInstPort(port);
+		if(instPort == NULL) {
+			net.frame = -1;
+			ok = false;
+		}
+		else if(instPort->getNode() == NULL) {
+			makeNet(d, node, net);
+		}
+		else {
+			ok = resolve(d - 1, instPort->getNode(), net);
+		}
+	}
+	f.memo.emplace(node, net);
+	return ok;
+}
+
+bool hcmOccIterator::getNodeNet(const hcmNode* node, hcmOccNet& net){
+	return resolve(depth(), node, net);
+}
+
+bool hcmOccIterator::getPinNet(const hcmNode* node, hcmOccNet& net){
+	int d = depth();
+	const hcmPort* port = node->getPort();
+	if(d == 0 || port == NULL) {
+		return false;
+	}
+	const hcmInstPort* instPort = frames[d].inst->getInstPort(port);
+	if(instPort == NULL) {
+		return false;
+	}
+	if(instPort->getNode() == NULL) {
+		makeNet(d, node, net);
+		return true;
+	}
+	return resolve(d - 1, instPort->getNode(), net);
+}
+
+string hcmOccIterator::getNetHName(const hcmOccNet& net) const{
+	if(net.global || net.frame == 0) {
+		return net.node->getName();
+	}
+	return getHName(net.frame) + HIER_SEPARATOR + net.node->getName();
+}
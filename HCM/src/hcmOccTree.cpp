@@ -0,0 +1,138 @@
+#include "hcm.h"
+#include "hcmOccTree.h"
+#include <algorithm>
+
+hcmOccTree::hcmOccTree(const hcmCell* topCell){
+	top = topCell;
+	build(top);
+}
+
+const hcmOccTree::cellInfo& hcmOccTree::build(const hcmCell* cell){
+	auto iI = infos.find(cell);
+	if(iI != infos.end()) {
+		return iI->second;
+	}
+	cellInfo& info = infos[cell];
+
+	const map<string, hcmNode*>& nodes = cell->getNodes();
+	info.nodes.reserve(nodes.size());
+	for(auto nI = nodes.begin(); nI != nodes.end(); ++nI) {
+		info.nodeIdx[nI->second] = info.nodes.size();
+		info.nodes.push_back(nI->second);
+	}
+
+	const map<string, hcmInstance*>& insts = cell->getInstances();
+	info.insts.reserve(insts.size());
+	info.instPrefix.reserve(insts.size() + 1);
+	info.nodePrefix.reserve(insts.size() + 1);
+	hcmOccId instSum = 0;
+	hcmOccId nodeSum = info.nodes.size();
+	for(auto it = insts.begin(); it != insts.end(); ++it) {
+		const hcmInstance* inst = it->second;
+		// infos is node based so info stays valid while the masters are added
+		const cellInfo& master = build(inst->masterCell());
+		info.instIdx[inst] = info.insts.size();
+		info.insts.push_back(inst);
+		info.instPrefix.push_back(instSum);
+		info.nodePrefix.push_back(nodeSum);
+		instSum += 1 + master.instCount;
+		nodeSum += master.nodeCount;
+	}
+	info.instPrefix.push_back(instSum);
+	info.nodePrefix.push_back(nodeSum);
+	info.instCount = instSum;
+	info.nodeCount = nodeSum;
+	return info;
+}
+
+const hcmOccTree::cellInfo* hcmOccTree::step(const cellInfo* info, const hcmInstance* inst, hcmOccId& instBase, hcmOccId& nodeBase) const{
+	auto iI = info->instIdx.find(inst);
+	if(iI == info->instIdx.end()) {
+		return NULL;
+	}
+	int k = iI->second;
+	instBase += info->instPrefix[k] + 1;
+	nodeBase += info->nodePrefix[k];
+	return &infos.at(inst->masterCell());
+}
+
+hcmOccId hcmOccTree::numInstOccs() const{
+	return infos.at(top).instCount;
+}
+
+hcmOccId hcmOccTree::numNodeOccs() const{
+	return infos.at(top).nodeCount;
+}
+
+bool hcmOccTree::getInstOccPath(hcmOccId id, vector<const hcmInstance*>& path) const{
+	path.clear();
+	const cellInfo* info = &infos.at(top);
+	if(id >= info->instCount) {
+		return false;
+	}
+	hcmOccId base = 0;
+	while(true) {
+		hcmOccId rel = id - base;
+		// the last instance starting at or before rel holds the occurrence
+		int k = upper_bound(info->instPrefix.begin(), info->instPrefix.end() - 1, rel) - info->instPrefix.begin() - 1;
+		const hcmInstance* inst = info->insts[k];
+		path.push_back(inst);
+		if(rel == info->instPrefix[k]) {
+			return true;
+		}
+		base += info->instPrefix[k] + 1;
+		info = &infos.at(inst->masterCell());
+	}
+}
+
+bool hcmOccTree::getNodeOccPath(hcmOccId id, vector<const hcmInstance*>& path, const hcmNode*& node) const{
+	path.clear();
+	const cellInfo* info = &infos.at(top);
+	if(id >= info->nodeCount) {
+		return false;
+	}
+	hcmOccId base = 0;
+	while(true) {
+		hcmOccId rel = id - base;
+		if(rel < info->nodes.size()) {
+			node = info->nodes[rel];
+			return true;
+		}
+		// instances with no nodes under them share their prefix with the next one, the last one is taken
+		int k = upper_bound(info->nodePrefix.begin(), info->nodePrefix.end() - 1, rel) - info->nodePrefix.begin() - 1;
+		const hcmInstance* inst = info->insts[k];
+		path.push_back(inst);
+		base += info->nodePrefix[k];
+		info = &infos.at(inst->masterCell());
+	}
+}
+
+string hcmOccTree::getInstOccName(hcmOccId id) const{
+	vector<const hcmInstance*> path;
+	string res;
+	if(!getInstOccPath(id, path)) {
+		return res;
+	}
+	for(size_t i = 0; i < path.size(); i++) {
+		if(i) {
+			res += HIER_SEPARATOR;
+		}
+		res += path[i]->getName();
+	}
+	return res;
+}
+
+string hcmOccTree::getNodeOccName(hcmOccId id) const{
+	vector<const hcmInstance*> path;
+	const hcmNode* node;
+	string res;
+	if(!getNodeOccPath(id, path, node)) {
+		return res;
+	}
+	for(size_t i = 0; i < path.size(); i++) {
+		res += path[i]->getName();
+		res += HIER_SEPARATOR;
+	}
+	res += node->getName();
+	return res;
+}
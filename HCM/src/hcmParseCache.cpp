@@ -0,0 +1,332 @@
+#include "hcm.h"
+#include "hcmVerilogIR.h"
+#include <fstream>
+#include <thread>
+#include <functional>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// the parse cache keeps the parsed modules of each file in a file of its own, named by the hash of the
+// verilog text. an entry is only used by the same version of the parsed form, so bump the version
+// whenever the parser or the records of hcmVerilogIR.h change what a file reads into.
+#define HCM_PARSE_CACHE_MAGIC "HCMPCACH"
+#define HCM_PARSE_CACHE_VERSION 1
+#define HCM_PARSE_CACHE_BYTE_ORDER 0x01020304u
+#define HCM_PARSE_CACHE_NONE 0xffffffffu
+
+struct hcmParseCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  // textHash/textSize - the verilog text the entry was parsed from.
+  uint64_t textHash;
+  uint64_t textSize;
+  // numStrings/stringBytes - the NUL terminated strings after the header, referred to by their index.
+  uint32_t numStrings;
+  uint32_t numWords;
+  uint64_t stringBytes;
+};
+
+// FNV-1a, the entry of a text must be named the same in every run
+static uint64_t hashText(const char* text, size_t size) {
+	uint64_t h = 0xcbf29ce484222325ull;
+	for(size_t i = 0; i < size; i++) {
+		h = (h ^ (unsigned char)text[i]) * 0x100000001b3ull;
+	}
+	return h;
+}
+
+// the modules of a parsed file as words, the strings as indexes into their table
+class parseCacheWriter {
+  public:
+    vector<uint32_t> words;
+    string strings;
+    uint32_t numStrings;
+
+    parseCacheWriter() : numStrings(0) {}
+
+    void add(uint32_t w) {
+      words.push_back(w);
+    }
+
+    void addString(const char* s) {
+      if(!s) {
+        add(HCM_PARSE_CACHE_NONE);
+        return;
+      }
+      // the strings of a parsed file are interned, so a pointer stands for its text
+      auto it = ids.find(s);
+      if(it == ids.end()) {
+        it = ids.emplace(s, numStrings++).first;
+        strings.append(s);
+        strings.push_back('\0');
+      }
+      add(it->second);
+    }
+
+    void addModule(const hcmParsedModule& m);
+
+  private:
+    unordered_map<const char*, uint32_t> ids;
+};
+
+void parseCacheWriter::addModule(const hcmParsedModule& m){
+	addString(m.name);
+	add(m.line);
+	add(m.ports.size());
+	for(auto pI = m.ports.begin(); pI != m.ports.end(); ++pI) {
+		addString(*pI);
+	}
+	add(m.stmts.size());
+	for(auto sI = m.stmts.begin(); sI != m.stmts.end(); ++sI) {
+		add(sI->kind);
+		add(sI->line);
+		addString(sI->name);
+		addString(sI->master);
+		add(sI->upper);
+		add(sI->lower);
+		add(sI->dir);
+		add(sI->firstPin);
+		add(sI->numPins);
+	}
+	add(m.pins.size());
+	for(auto pI = m.pins.begin(); pI != m.pins.end(); ++pI) {
+		addString(pI->port);
+		add(pI->bit);
+		add(pI->line);
+		add(pI->firstNet);
+		add(pI->numNets);
+	}
+	add(m.nets.size());
+	for(auto nI = m.nets.begin(); nI != m.nets.end(); ++nI) {
+		addString(nI->name);
+		add(nI->left);
+		add(nI->right);
+		add(nI->constant);
+	}
+}
+
+// reads the words written by parseCacheWriter, a read past the end or a bad string index fails it
+class parseCacheReader {
+  private:
+    const uint32_t* p;
+    const uint32_t* end;
+    const vector<const char*>& strings;
+
+  public:
+    bool ok;
+
+    parseCacheReader(const uint32_t* words, size_t numWords, const vector<const char*>& s) :
+      p(words), end(words + numWords), strings(s), ok(true) {}
+
+    bool atEnd() const { return p == end; }
+
+    uint32_t word() {
+      if(p == end) {
+        ok = false;
+        return 0;
+      }
+      return *p++;
+    }
+
+    int integer() {
+      return (int32_t)word();
+    }
+
+    const char* str() {
+      uint32_t i = word();
+      if(i == HCM_PARSE_CACHE_NONE) {
+        return NULL;
+      }
+      if(i >= strings.size()) {
+        ok = false;
+        return "";
+      }
+      return strings[i];
+    }
+
+    // a count of records of \a recordWords words each, 0 if they don't fit
+    uint32_t count(size_t recordWords) {
+      uint32_t n = word();
+      if((size_t)(end - p) < n * recordWords) {
+        ok = false;
+        return 0;
+      }
+      return n;
+    }
+
+    void readModule(hcmParsedModule& m);
+};
+
+void parseCacheReader::readModule(hcmParsedModule& m){
+	m.name = str();
+	m.line = integer();
+	m.ports.resize(count(1));
+	for(auto pI = m.ports.begin(); pI != m.ports.end(); ++pI) {
+		*pI = str();
+		ok = ok && *pI;
+	}
+	m.stmts.resize(count(9));
+	for(auto sI = m.stmts.begin(); sI != m.stmts.end(); ++sI) {
+		sI->kind = (hcmParsedStmtKind)word();
+		sI->line = integer();
+		sI->name = str();
+		sI->master = str();
+		sI->upper = integer();
+		sI->lower = integer();
+		sI->dir = (hcmPortDir)word();
+		sI->firstPin = word();
+		sI->numPins = word();
+		ok = ok && sI->name && sI->kind <= STMT_INST && sI->firstPin + sI->numPins >= sI->firstPin;
+	}
+	m.pins.resize(count(5));
+	for(auto pI = m.pins.begin(); pI != m.pins.end(); ++pI) {
+		pI->port = str();
+		pI->bit = integer();
+		pI->line = integer();
+		pI->firstNet = word();
+		pI->numNets = word();
+	}
+	m.nets.resize(count(4));
+	for(auto nI = m.nets.begin(); nI != m.nets.end(); ++nI) {
+		nI->name = str();
+		nI->left = integer();
+		nI->right = integer();
+		nI->constant = word();
+		ok = ok && nI->name;
+	}
+	// the names the linker uses are all there, and the ranges refer to records of the module only
+	for(auto sI = m.stmts.begin(); ok && sI != m.stmts.end(); ++sI) {
+		ok = (sI->kind != STMT_INST) || (sI->master && sI->firstPin + sI->numPins <= m.pins.size());
+	}
+	for(auto pI = m.pins.begin(); ok && pI != m.pins.end(); ++pI) {
+		ok = pI->firstNet + pI->numNets >= pI->firstNet && pI->firstNet + pI->numNets <= m.nets.size();
+	}
+	ok = ok && m.name;
+}
+
+// the parsed file of the cache entry \a path of the text, NULL if there is no good entry
+static hcmParsedFile* loadEntry(const string& path, const char* fn, uint64_t textHash, uint64_t textSize) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0) {
+		return NULL;
+	}
+	struct stat st;
+	if(fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(hcmParseCacheHeader)) {
+		close(fd);
+		return NULL;
+	}
+	size_t size = st.st_size;
+	void* m = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(m == MAP_FAILED) {
+		return NULL;
+	}
+	const char* base = (const char*)m;
+	const hcmParseCacheHeader* header = (const hcmParseCacheHeader*)base;
+	size_t wordsOffset = sizeof(hcmParseCacheHeader) + ((header->stringBytes + 3) & ~(uint64_t)3);
+	hcmParsedFile* file = NULL;
+	if(memcmp(header->magic, HCM_PARSE_CACHE_MAGIC, sizeof(header->magic)) == 0 &&
+	   header->version == HCM_PARSE_CACHE_VERSION && header->byteOrder == HCM_PARSE_CACHE_BYTE_ORDER &&
+	   header->textHash == textHash && header->textSize == textSize && header->stringBytes <= size &&
+	   wordsOffset + (uint64_t)header->numWords * sizeof(uint32_t) == size) {
+		file = new hcmParsedFile();
+		file->fileName = fn;
+		file->reserveStrings(header->numStrings);
+		vector<const char*> strings;
+		strings.reserve(header->numStrings);
+		const char* s = base + sizeof(hcmParseCacheHeader);
+		const char* sEnd = s + header->stringBytes;
+		while(s < sEnd) {
+			const char* nul = (const char*)memchr(s, '\0', sEnd - s);
+			if(!nul) {
+				break;
+			}
+			strings.push_back(file->newString(string_view(s, nul - s)));
+			s = nul + 1;
+		}
+		parseCacheReader reader((const uint32_t*)(base + wordsOffset), header->numWords, strings);
+		reader.ok = (s == sEnd && strings.size() == header->numStrings);
+		while(reader.ok && !reader.atEnd()) {
+			file->modules.emplace_back();
+			reader.readModule(file->modules.back());
+		}
+		file->ok = true;
+		if(!reader.ok) {
+			delete file;
+			file = NULL;
+		}
+	}
+	munmap(m, size);
+	return file;
+}
+
+// writes the entry of \a file next to \a path and moves it in place, so a reader sees all of it or none
+static void storeEntry(const string& path, const hcmParsedFile* file, uint64_t textHash, uint64_t textSize) {
+	parseCacheWriter w;
+	for(auto mI = file->modules.begin(); mI != file->modules.end(); ++mI) {
+		w.addModule(*mI);
+	}
+	hcmParseCacheHeader header = {};
+	memcpy(header.magic, HCM_PARSE_CACHE_MAGIC, sizeof(header.magic));
+	header.version = HCM_PARSE_CACHE_VERSION;
+	header.byteOrder = HCM_PARSE_CACHE_BYTE_ORDER;
+	header.textHash = textHash;
+	header.textSize = textSize;
+	header.numStrings = w.numStrings;
+	header.numWords = w.words.size();
+	header.stringBytes = w.strings.size();
+
+	string tmpPath = path + "." + to_string(getpid()) + "." + to_string(hash<thread::id>()(this_thread::get_id()));
+	ofstream out(tmpPath.c_str(), ios::binary | ios::trunc);
+	if(!out.good()) {
+		return;
+	}
+	static const char zeros[4] = {0};
+	out.write((const char*)&header, sizeof(header));
+	out.write(w.strings.data(), w.strings.size());
+	out.write(zeros, ((w.strings.size() + 3) & ~(size_t)3) - w.strings.size());
+	out.write((const char*)w.words.data(), w.words.size() * sizeof(uint32_t));
+	out.close();
+	if(!out.good() || rename(tmpPath.c_str(), path.c_str()) != 0) {
+		remove(tmpPath.c_str());
+	}
+}
+
+hcmParsedFile* read_verilog_file_cached(const char *fn, const string& cacheDir, hcmParsedFile* (*readFile)(const char*),
+                                        bool& hit)
+{
+	hit = false;
+	string text;
+	ifstream in(fn, ios::binary);
+	if(!in.good()) {
+		return readFile(fn);
+	}
+	in.seekg(0, ios::end);
+	text.resize(max((streamoff)0, (streamoff)in.tellg()));
+	in.seekg(0, ios::beg);
+	in.read(&text[0], text.size());
+	if(!in.good()) {
+		// not a regular file, the reader reads it as it is
+		return readFile(fn);
+	}
+	uint64_t textHash = hashText(text.data(), text.size());
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.hpc", (unsigned long long)textHash);
+	string path = cacheDir + "/" + name;
+
+	hcmParsedFile* file = loadEntry(path, fn, textHash, text.size());
+	if(file) {
+		hit = true;
+		return file;
+	}
+	file = readFile(fn);
+	// only a file read with no error is kept, a file with errors is read again for its messages
+	if(file && file->ok) {
+		mkdir(cacheDir.c_str(), 0777);
+		storeEntry(path, file, textHash, text.size());
+	}
+	return file;
+}
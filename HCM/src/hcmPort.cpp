@@ -3,13 +3,18 @@
 void hcmPort::printInfo(){}
 
 hcmPort::hcmPort(string portName, hcmNode* ownerNode , hcmPortDir direction){
-	name = portName;
 	dir = direction;
 	node = ownerNode;
+	ordinal = node->owner()->registerPort(this);
+	setName(node->owner()->owner()->getNameTable(), portName);
+	registerProps(&node->owner()->owner()->props);
 }
 
 hcmPort::~hcmPort() {
 	destructorCalled = true;
+	if (hcmArenaBase::isReleasing(this)) {
+		return;
+	}
 
 	set<string> names;
 	// delete the instPorts map
@@ -24,6 +29,8 @@ hcmPort::~hcmPort() {
     	}
 	}
 
+	node->owner()->owner()->journal.notify(PORT_DELETED, node->owner(), NULL, node, this);
+	node->owner()->unregisterPort(this);
 	node->deletePort();
 	node = NULL;
 }
@@ -32,6 +39,22 @@ hcmNode* hcmPort::owner(){
 	return node;
 }
 
+int hcmPort::getOrdinal() const{
+	return ordinal;
+}
+
 hcmPortDir hcmPort::getDirection() const{
 	return dir;
 }
+
+void* hcmPort::operator new(size_t size, hcmDesign* design){
+	return hcmArenaBase::allocate(&design->portArena, size);
+}
+
+void hcmPort::operator delete(void* obj, hcmDesign* design){
+	hcmArenaBase::deallocate(obj);
+}
+
+void hcmPort::operator delete(void* obj){
+	hcmArenaBase::deallocate(obj);
+}
@@ -0,0 +1,146 @@
+#include "hcm.h"
+#include <mutex>
+
+hcmPropKeyBase::keyRegistry& hcmPropKeyBase::registry(){
+	static keyRegistry reg;
+	return reg;
+}
+
+// keys are made by static objects and by name from any thread
+static mutex registryLock;
+
+const hcmPropKeyBase::keyInfo& hcmPropKeyBase::getKeyInfo(int keyId){
+	lock_guard<mutex> guard(registryLock);
+	return registry().keys[keyId];
+}
+
+int hcmPropKeyBase::numKeys(){
+	lock_guard<mutex> guard(registryLock);
+	return registry().keys.size();
+}
+
+int hcmPropKeyBase::lookupKey(const keyRegistry& reg, const string& name, const char* typeName){
+	auto nI = reg.byName.find(name);
+	if(nI == reg.byName.end()) {
+		return -1;
+	}
+	for(int k : nI->second) {
+		if(reg.keys[k].typeName == typeName) {
+			return k;
+		}
+	}
+	return -1;
+}
+
+int hcmPropKeyBase::findKey(const string& name, const char* typeName){
+	lock_guard<mutex> guard(registryLock);
+	return lookupKey(registry(), name, typeName);
+}
+
+vector<int> hcmPropKeyBase::findKeys(const string& name){
+	lock_guard<mutex> guard(registryLock);
+	auto nI = registry().byName.find(name);
+	return nI == registry().byName.end() ? vector<int>() : nI->second;
+}
+
+vector<int> hcmPropKeyBase::sameNameKeys(int keyId){
+	lock_guard<mutex> guard(registryLock);
+	keyRegistry& reg = registry();
+	vector<int> found;
+	for(int k : reg.byName[reg.keys[keyId].name]) {
+		if(k != keyId) {
+			found.push_back(k);
+		}
+	}
+	return found;
+}
+
+int hcmPropKeyBase::registerKey(const string& name, const char* typeName){
+	lock_guard<mutex> guard(registryLock);
+	keyRegistry& reg = registry();
+	int found = lookupKey(reg, name, typeName);
+	if(found != -1) {
+		return found;
+	}
+	int id = reg.keys.size();
+	reg.keys.push_back(keyInfo());
+	reg.keys.back().name = name;
+	reg.keys.back().typeName = typeName;
+	reg.byName[name].push_back(id);
+	return id;
+}
+
+hcmPropStore::~hcmPropStore(){
+	for(auto it = columns.begin(); it != columns.end(); ++it) {
+		delete *it;
+	}
+}
+
+size_t hcmPropStore::bytes() const{
+	size_t res = hcmVectorBytes(columns) + hcmVectorBytes(freeIds) +
+		hcmVectorBytes(linked) + hcmVectorBytes(otherKeys);
+	for(auto it = otherKeys.begin(); it != otherKeys.end(); ++it) {
+		res += hcmVectorBytes(*it);
+	}
+	for(auto it = columns.begin(); it != columns.end(); ++it) {
+		if(*it) {
+			res += (*it)->bytes();
+		}
+	}
+	return res;
+}
+
+hcmObjId hcmPropStore::newObject(){
+	if(!freeIds.empty()) {
+		hcmObjId obj = freeIds.back();
+		freeIds.pop_back();
+		return obj;
+	}
+	return nextId++;
+}
+
+void hcmPropStore::releaseObject(hcmObjId obj){
+	if(releasing || obj == HCM_NO_OBJ) {
+		return;
+	}
+	for(auto it = columns.begin(); it != columns.end(); ++it) {
+		if(*it) {
+			(*it)->erase(obj);
+		}
+	}
+	freeIds.push_back(obj);
+}
+
+bool hcmPropStore::has(int keyId, hcmObjId obj) const{
+	return (size_t)keyId < columns.size() && columns[keyId] && columns[keyId]->has(obj);
+}
+
+void hcmPropStore::linkKey(int keyId){
+	if((size_t)keyId < linked.size() && linked[keyId]) {
+		return;
+	}
+	if((size_t)keyId >= linked.size()) {
+		linked.resize(keyId + 1, 0);
+		otherKeys.resize(keyId + 1);
+	}
+	linked[keyId] = 1;
+	// keys not linked yet have no values here, they add themselves when first used.
+	vector<int> others = hcmPropKeyBase::sameNameKeys(keyId);
+	for(auto it = others.begin(); it != others.end(); ++it) {
+		if((size_t)*it < linked.size() && linked[*it]) {
+			otherKeys[keyId].push_back(*it);
+			otherKeys[*it].push_back(keyId);
+		}
+	}
+}
+
+bool hcmPropStore::hasOtherType(int keyId, hcmObjId obj){
+	linkKey(keyId);
+	const vector<int>& others = otherKeys[keyId];
+	for(auto it = others.begin(); it != others.end(); ++it) {
+		if(has(*it, obj)) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,619 @@
+#include "hcm.h"
+#include "hcmSnapshot.h"
+#include "hcmCellBuilder.h"
+#include <fstream>
+#include <unordered_set>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define HCM_SNAP_MAGIC "HCMSNAP"
+#define HCM_SNAP_VERSION 2
+#define HCM_SNAP_BYTE_ORDER 0x01020304u
+
+// the size of the records of each section
+static const size_t recordSize[SNAP_NUM_SECTIONS] = {
+	sizeof(char), sizeof(hcmSnapCell), sizeof(hcmSnapNode), sizeof(hcmSnapInst), sizeof(hcmSnapPin),
+	sizeof(uint32_t), sizeof(hcmSnapBus), sizeof(uint32_t), sizeof(uint32_t), sizeof(hcmSnapPropKey), sizeof(hcmSnapProp)
+};
+
+static uint64_t align8(uint64_t n) {
+	return (n + 7) & ~(uint64_t)7;
+}
+
+// the string section being written, each name is stored once
+struct snapStrings {
+	vector<char> chars;
+	unordered_map<string, uint32_t> ids;
+
+	uint32_t add(const string& s) {
+		auto it = ids.find(s);
+		if(it != ids.end()) {
+			return it->second;
+		}
+		uint32_t offset = chars.size();
+		chars.insert(chars.end(), s.begin(), s.end());
+		chars.push_back('\0');
+		ids.emplace(s, offset);
+		return offset;
+	}
+};
+
+static void setValue(hcmSnapProp& p, int v, snapStrings&) { p.value.i = v; }
+static void setValue(hcmSnapProp& p, double v, snapStrings&) { p.value.d = v; }
+static void setValue(hcmSnapProp& p, bool v, snapStrings&) { p.value.i = v; }
+static void setValue(hcmSnapProp& p, const string& v, snapStrings& strs) { p.value.s = strs.add(v); }
+
+/** @fn static void saveColumn(hcmPropStore& store, int keyId, uint32_t key, vector<hcmObject*>* tables, vector<hcmSnapProp>& props, snapStrings& strs)
+ * @brief adds the values of the column of \a keyId for the objects of all the tables, tables[kind][index].
+ */
+template <typename T>
+static void saveColumn(hcmPropStore& store, int keyId, uint32_t key, vector<hcmObject*>* tables,
+                       vector<hcmSnapProp>& props, snapStrings& strs) {
+	const hcmPropColumn<T>* col = store.findColumn<T>(keyId);
+	if(col == NULL || col->size() == 0) {
+		return;
+	}
+	for(uint32_t kind = SNAP_DESIGN; kind <= SNAP_INST_PORT; kind++) {
+		const vector<hcmObject*>& objs = tables[kind];
+		for(uint32_t i = 0; i < objs.size(); i++) {
+			if(objs[i] && col->has(objs[i]->getObjId())) {
+				hcmSnapProp p = {};
+				p.key = key;
+				p.kind = kind;
+				p.index = i;
+				setValue(p, col->value(objs[i]->getObjId()), strs);
+				props.push_back(p);
+			}
+		}
+	}
+}
+
+// adds the cells under cell, masters first
+static void orderCells(hcmCell* cell, unordered_set<const hcmCell*>& visited, vector<hcmCell*>& order) {
+	if(!visited.insert(cell).second) {
+		return;
+	}
+	const map<string, hcmInstance*>& insts = cell->getInstances();
+	for(auto iI = insts.begin(); iI != insts.end(); ++iI) {
+		orderCells(iI->second->masterCell(), visited, order);
+	}
+	order.push_back(cell);
+}
+
+hcmRes hcmSnapshot::write(hcmDesign* design, const string& fileName){
+	vector<hcmCell*> order;
+	unordered_set<const hcmCell*> visited;
+	const map<string, hcmCell*>& designCells = design->getCells();
+	for(auto cI = designCells.begin(); cI != designCells.end(); ++cI) {
+		orderCells(cI->second, visited, order);
+	}
+
+	snapStrings strs;
+	vector<hcmSnapCell> cells;
+	vector<hcmSnapNode> nodes;
+	vector<hcmSnapInst> insts;
+	vector<hcmSnapPin> pins;
+	vector<hcmSnapBus> buses;
+	vector<uint32_t> busBits;
+	vector<uint32_t> portNames;
+	unordered_map<const hcmCell*, uint32_t> cellIdx;
+	unordered_map<const hcmNode*, uint32_t> nodeIdx;
+	// the objects of each kind by their index in the tables, for the properties
+	vector<hcmObject*> tables[SNAP_INST_PORT + 1];
+	tables[SNAP_DESIGN].push_back(design);
+
+	for(auto cI = order.begin(); cI != order.end(); ++cI) {
+		hcmCell* cell = *cI;
+		hcmSnapCell c = {};
+		c.name = strs.add(cell->getName());
+
+		c.firstNode = nodes.size();
+		const map<string, hcmNode*>& cellNodes = cell->getNodes();
+		for(auto nI = cellNodes.begin(); nI != cellNodes.end(); ++nI) {
+			hcmNode* node = nI->second;
+			hcmPort* port = node->getPort();
+			nodeIdx[node] = nodes.size();
+			nodes.push_back(hcmSnapNode{strs.add(nI->first), port ? port->getDirection() : NOT_PORT, 0, 0,
+			                            port ? (uint32_t)port->getOrdinal() : HCM_SNAP_NONE});
+			tables[SNAP_NODE].push_back(node);
+			tables[SNAP_PORT].push_back(port);
+		}
+		c.numNodes = nodes.size() - c.firstNode;
+
+		c.firstInst = insts.size();
+		const map<string, hcmInstance*>& cellInsts = cell->getInstances();
+		for(auto iI = cellInsts.begin(); iI != cellInsts.end(); ++iI) {
+			hcmInstance* inst = iI->second;
+			uint32_t i = insts.size();
+			hcmSnapInst si = {strs.add(iI->first), cellIdx.at(inst->masterCell()), (uint32_t)pins.size(), 0};
+			const map<string, hcmInstPort*>& instPorts = inst->getInstPorts();
+			for(auto pI = instPorts.begin(); pI != instPorts.end(); ++pI) {
+				hcmInstPort* instPort = pI->second;
+				if(instPort->getNode() == NULL) {
+					continue;
+				}
+				pins.push_back(hcmSnapPin{i, nodeIdx.at(instPort->getNode()), nodeIdx.at(instPort->getPort()->owner())});
+				tables[SNAP_INST_PORT].push_back(instPort);
+			}
+			si.numPins = pins.size() - si.firstPin;
+			insts.push_back(si);
+			tables[SNAP_INST].push_back(inst);
+		}
+		c.numInsts = insts.size() - c.firstInst;
+
+		c.firstBus = buses.size();
+		const map<string, hcmBus>& cellBuses = cell->getBuses();
+		for(auto bI = cellBuses.begin(); bI != cellBuses.end(); ++bI) {
+			const hcmBus& bus = bI->second;
+			buses.push_back(hcmSnapBus{strs.add(bus.getName()), bus.getFrom(), bus.getTo(), bus.getDirection(), (uint32_t)busBits.size(), 0});
+			for(int k = bus.getLow(); k <= bus.getHigh(); k++) {
+				hcmNode* node = bus.getNode(k);
+				busBits.push_back(node ? nodeIdx.at(node) : HCM_SNAP_NONE);
+			}
+		}
+		c.numBuses = buses.size() - c.firstBus;
+
+		const vector<string>* portOrder = cell->getPortOrder();
+		c.firstPortName = portOrder ? portNames.size() : HCM_SNAP_NONE;
+		if(portOrder) {
+			for(auto pI = portOrder->begin(); pI != portOrder->end(); ++pI) {
+				portNames.push_back(strs.add(*pI));
+			}
+			c.numPortNames = portOrder->size();
+		}
+
+		cellIdx[cell] = cells.size();
+		cells.push_back(c);
+		tables[SNAP_CELL].push_back(cell);
+	}
+
+	// the pins of each node, by counting sort
+	vector<uint32_t> nodePins(pins.size());
+	for(auto pI = pins.begin(); pI != pins.end(); ++pI) {
+		nodes[pI->node].numPins++;
+	}
+	uint32_t offset = 0;
+	for(auto nI = nodes.begin(); nI != nodes.end(); ++nI) {
+		nI->firstPin = offset;
+		offset += nI->numPins;
+		nI->numPins = 0;
+	}
+	for(uint32_t p = 0; p < pins.size(); p++) {
+		hcmSnapNode& n = nodes[pins[p].node];
+		nodePins[n.firstPin + n.numPins++] = p;
+	}
+
+	// the properties of the supported types
+	vector<hcmSnapPropKey> keys;
+	vector<hcmSnapProp> props;
+	hcmPropStore& store = design->getPropStore();
+	for(int k = 0; k < hcmPropKeyBase::numKeys(); k++) {
+		const string& typeName = hcmPropKeyBase::getKeyTypeName(k);
+		uint32_t key = keys.size();
+		size_t before = props.size();
+		hcmSnapPropKey sk = {strs.add(hcmPropKeyBase::getKeyName(k)), 0};
+		if(typeName == typeid(int).name()) {
+			sk.type = SNAP_INT;
+			saveColumn<int>(store, k, key, tables, props, strs);
+		}
+		else if(typeName == typeid(double).name()) {
+			sk.type = SNAP_DOUBLE;
+			saveColumn<double>(store, k, key, tables, props, strs);
+		}
+		else if(typeName == typeid(bool).name()) {
+			sk.type = SNAP_BOOL;
+			saveColumn<bool>(store, k, key, tables, props, strs);
+		}
+		else if(typeName == typeid(string).name()) {
+			sk.type = SNAP_STRING;
+			saveColumn<string>(store, k, key, tables, props, strs);
+		}
+		if(props.size() > before) {
+			keys.push_back(sk);
+		}
+	}
+
+	hcmSnapHeader header = {};
+	memcpy(header.magic, HCM_SNAP_MAGIC, sizeof(HCM_SNAP_MAGIC));
+	header.version = HCM_SNAP_VERSION;
+	header.byteOrder = HCM_SNAP_BYTE_ORDER;
+	header.designName = strs.add(design->getName());
+
+	const void* data[SNAP_NUM_SECTIONS] = {
+		strs.chars.data(), cells.data(), nodes.data(), insts.data(), pins.data(),
+		nodePins.data(), buses.data(), busBits.data(), portNames.data(), keys.data(), props.data()
+	};
+	uint64_t counts[SNAP_NUM_SECTIONS] = {
+		strs.chars.size(), cells.size(), nodes.size(), insts.size(), pins.size(),
+		nodePins.size(), buses.size(), busBits.size(), portNames.size(), keys.size(), props.size()
+	};
+	uint64_t pos = align8(sizeof(hcmSnapHeader));
+	for(int s = 0; s < SNAP_NUM_SECTIONS; s++) {
+		header.sections[s].offset = pos;
+		header.sections[s].count = counts[s];
+		pos = align8(pos + counts[s] * recordSize[s]);
+	}
+	header.fileSize = pos;
+
+	ofstream out(fileName.c_str(), ios::binary | ios::trunc);
+	if(!out.good()) {
+		cout << "Error: could not open snapshot file: " << fileName << endl;
+		return BAD_PARAM;
+	}
+	static const char zeros[8] = {0};
+	out.write((const char*)&header, sizeof(header));
+	out.write(zeros, align8(sizeof(header)) - sizeof(header));
+	for(int s = 0; s < SNAP_NUM_SECTIONS; s++) {
+		uint64_t bytes = counts[s] * recordSize[s];
+		out.write((const char*)data[s], bytes);
+		out.write(zeros, align8(bytes) - bytes);
+	}
+	out.close();
+	if(!out.good()) {
+		cout << "Error: could not write snapshot file: " << fileName << endl;
+		return BAD_PARAM;
+	}
+	return OK;
+}
+
+hcmSnapshot::hcmSnapshot(){
+	base = NULL;
+	size = 0;
+	header = NULL;
+}
+
+hcmSnapshot::~hcmSnapshot(){
+	close();
+}
+
+void hcmSnapshot::close(){
+	if(base) {
+		munmap((void*)base, size);
+	}
+	base = NULL;
+	size = 0;
+	header = NULL;
+}
+
+hcmRes hcmSnapshot::open(const string& fileName){
+	close();
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+	if(fd < 0) {
+		error = "could not open " + fileName + ": " + strerror(errno);
+		return BAD_PARAM;
+	}
+	struct stat st;
+	if(fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(hcmSnapHeader)) {
+		::close(fd);
+		error = fileName + " is not a snapshot file";
+		return BAD_PARAM;
+	}
+	// a shared read only mapping - the pages come from the page cache and are shared by all the readers
+	void* p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if(p == MAP_FAILED) {
+		error = "could not map " + fileName + ": " + strerror(errno);
+		return BAD_PARAM;
+	}
+	base = (const char*)p;
+	size = st.st_size;
+	header = (const hcmSnapHeader*)base;
+	if(!check()) {
+		close();
+		return BAD_PARAM;
+	}
+	return OK;
+}
+
+bool hcmSnapshot::check(){
+	if(memcmp(header->magic, HCM_SNAP_MAGIC, sizeof(HCM_SNAP_MAGIC)) != 0) {
+		error = "bad snapshot magic";
+		return false;
+	}
+	if(header->version != HCM_SNAP_VERSION || header->byteOrder != HCM_SNAP_BYTE_ORDER) {
+		error = "unsupported snapshot version or byte order";
+		return false;
+	}
+	if(header->fileSize != size) {
+		error = "truncated snapshot";
+		return false;
+	}
+	for(int s = 0; s < SNAP_NUM_SECTIONS; s++) {
+		uint64_t offset = header->sections[s].offset;
+		uint64_t count = header->sections[s].count;
+		if(offset % 8 || offset > size || count > (size - offset) / recordSize[s]) {
+			error = "snapshot section out of the file";
+			return false;
+		}
+	}
+	uint64_t numChars = header->sections[SNAP_STRINGS].count;
+	if(numChars == 0 || getString(numChars - 1)[0] != '\0') {
+		error = "bad snapshot string section";
+		return false;
+	}
+	return true;
+}
+
+// the range [first, first + num) is in a section of count records
+static bool inRange(uint64_t first, uint64_t num, uint64_t count) {
+	return first <= count && num <= count - first;
+}
+
+bool hcmSnapshot::checkRecords(){
+	uint64_t counts[SNAP_NUM_SECTIONS];
+	for(int s = 0; s < SNAP_NUM_SECTIONS; s++) {
+		counts[s] = header->sections[s].count;
+	}
+	// the string section ends with a NUL, so any offset in it is a terminated string
+	uint64_t numChars = counts[SNAP_STRINGS];
+	if(header->designName >= numChars) {
+		error = "bad snapshot design name";
+		return false;
+	}
+	for(uint64_t c = 0; c < counts[SNAP_CELLS]; c++) {
+		const hcmSnapCell& sc = getCell(c);
+		if(sc.name >= numChars || !inRange(sc.firstNode, sc.numNodes, counts[SNAP_NODES]) ||
+		   !inRange(sc.firstInst, sc.numInsts, counts[SNAP_INSTS]) || !inRange(sc.firstBus, sc.numBuses, counts[SNAP_BUSES]) ||
+		   (sc.firstPortName != HCM_SNAP_NONE && !inRange(sc.firstPortName, sc.numPortNames, counts[SNAP_PORT_ORDER]))) {
+			error = "bad snapshot cell " + to_string(c);
+			return false;
+		}
+	}
+	for(uint64_t n = 0; n < counts[SNAP_NODES]; n++) {
+		const hcmSnapNode& sn = getNode(n);
+		if(sn.name >= numChars || sn.dir < NOT_PORT || sn.dir > IN_OUT || !inRange(sn.firstPin, sn.numPins, counts[SNAP_NODE_PINS]) ||
+		   (sn.dir == NOT_PORT) != (sn.ordinal == HCM_SNAP_NONE)) {
+			error = "bad snapshot node " + to_string(n);
+			return false;
+		}
+	}
+	const uint32_t* nodePins = section<uint32_t>(SNAP_NODE_PINS);
+	for(uint64_t p = 0; p < counts[SNAP_NODE_PINS]; p++) {
+		if(nodePins[p] >= counts[SNAP_PINS]) {
+			error = "bad snapshot node pin " + to_string(p);
+			return false;
+		}
+	}
+	for(uint64_t i = 0; i < counts[SNAP_INSTS]; i++) {
+		const hcmSnapInst& si = getInst(i);
+		if(si.name >= numChars || si.master >= counts[SNAP_CELLS] || !inRange(si.firstPin, si.numPins, counts[SNAP_PINS])) {
+			error = "bad snapshot instance " + to_string(i);
+			return false;
+		}
+	}
+	for(uint64_t p = 0; p < counts[SNAP_PINS]; p++) {
+		const hcmSnapPin& sp = getPin(p);
+		if(sp.inst >= counts[SNAP_INSTS] || sp.node >= counts[SNAP_NODES] || sp.port >= counts[SNAP_NODES]) {
+			error = "bad snapshot pin " + to_string(p);
+			return false;
+		}
+	}
+	const uint32_t* busBits = section<uint32_t>(SNAP_BUS_BITS);
+	for(uint64_t b = 0; b < counts[SNAP_BUSES]; b++) {
+		const hcmSnapBus& sb = getBus(b);
+		uint64_t width = (uint64_t)llabs((int64_t)sb.from - sb.to) + 1;
+		bool good = sb.name < numChars && sb.dir >= NOT_PORT && sb.dir <= IN_OUT && inRange(sb.firstBit, width, counts[SNAP_BUS_BITS]);
+		for(uint64_t k = 0; good && k < width; k++) {
+			good = busBits[sb.firstBit + k] < counts[SNAP_NODES] || busBits[sb.firstBit + k] == HCM_SNAP_NONE;
+		}
+		if(!good) {
+			error = "bad snapshot bus " + to_string(b);
+			return false;
+		}
+	}
+	const uint32_t* portNames = section<uint32_t>(SNAP_PORT_ORDER);
+	for(uint64_t p = 0; p < counts[SNAP_PORT_ORDER]; p++) {
+		if(portNames[p] >= numChars) {
+			error = "bad snapshot port name " + to_string(p);
+			return false;
+		}
+	}
+	const hcmSnapPropKey* keys = section<hcmSnapPropKey>(SNAP_PROP_KEYS);
+	for(uint64_t k = 0; k < counts[SNAP_PROP_KEYS]; k++) {
+		if(keys[k].name >= numChars || keys[k].type > SNAP_STRING) {
+			error = "bad snapshot property key " + to_string(k);
+			return false;
+		}
+	}
+	// the table each kind of object is indexed in
+	const uint64_t numObjs[SNAP_INST_PORT + 1] = {
+		1, counts[SNAP_CELLS], counts[SNAP_NODES], counts[SNAP_NODES], counts[SNAP_INSTS], counts[SNAP_PINS]
+	};
+	const hcmSnapProp* props = section<hcmSnapProp>(SNAP_PROPS);
+	for(uint64_t p = 0; p < counts[SNAP_PROPS]; p++) {
+		const hcmSnapProp& sp = props[p];
+		if(sp.key >= counts[SNAP_PROP_KEYS] || sp.kind > SNAP_INST_PORT || sp.index >= numObjs[sp.kind] ||
+		   (keys[sp.key].type == SNAP_STRING && sp.value.s >= numChars)) {
+			error = "bad snapshot property " + to_string(p);
+			return false;
+		}
+	}
+	return true;
+}
+
+uint32_t hcmSnapshot::findCell(const string& name) const{
+	for(uint32_t c = 0; c < numCells(); c++) {
+		if(name == getString(getCell(c).name)) {
+			return c;
+		}
+	}
+	return HCM_SNAP_NONE;
+}
+
+hcmDesign* hcmSnapshot::load(){
+	if(base == NULL) {
+		error = "no snapshot is open";
+		return NULL;
+	}
+	if(!checkRecords()) {
+		return NULL;
+	}
+	hcmDesign* design = new hcmDesign(getDesignName());
+	vector<hcmCell*> cells(numCells(), NULL);
+	vector<hcmNode*> nodes(numNodes(), NULL);
+	vector<hcmInstance*> insts(numInsts(), NULL);
+
+	for(uint32_t c = 0; c < numCells(); c++) {
+		const hcmSnapCell& sc = getCell(c);
+		hcmCell* cell = design->createCell(getString(sc.name));
+		if(cell == NULL) {
+			error = string("duplicate cell ") + getString(sc.name);
+			delete design;
+			return NULL;
+		}
+		cells[c] = cell;
+		if(sc.firstPortName != HCM_SNAP_NONE) {
+			vector<string> portOrder;
+			for(uint32_t k = 0; k < sc.numPortNames; k++) {
+				portOrder.push_back(getString(getPortName(sc, k)));
+			}
+			cell->setPortOrder(portOrder);
+		}
+
+		// the ports are created by their ordinals, a bus creates the ports of all its bits at its first one
+		vector<uint32_t> busOf(sc.numNodes, HCM_SNAP_NONE);
+		for(uint32_t b = 0; b < sc.numBuses; b++) {
+			const hcmSnapBus& sb = getBus(sc.firstBus + b);
+			for(int k = 0; k <= abs(sb.from - sb.to); k++) {
+				uint32_t n = getBusBit(sb, k);
+				if(n != HCM_SNAP_NONE && n >= sc.firstNode && n < sc.firstNode + sc.numNodes) {
+					busOf[n - sc.firstNode] = b;
+				}
+			}
+		}
+		vector<uint32_t> ports;
+		for(uint32_t n = sc.firstNode; n < sc.firstNode + sc.numNodes; n++) {
+			if(getNode(n).dir != NOT_PORT) {
+				ports.push_back(n);
+			}
+		}
+		stable_sort(ports.begin(), ports.end(), [this](uint32_t x, uint32_t y) { return getNode(x).ordinal < getNode(y).ordinal; });
+		vector<bool> busMade(sc.numBuses, false);
+		for(auto pI = ports.begin(); pI != ports.end(); ++pI) {
+			const hcmSnapNode& sn = getNode(*pI);
+			uint32_t b = busOf[*pI - sc.firstNode];
+			if(b != HCM_SNAP_NONE) {
+				if(!busMade[b]) {
+					const hcmSnapBus& sb = getBus(sc.firstBus + b);
+					cell->createBus(getString(sb.name), sb.from, sb.to, (hcmPortDir)sb.dir);
+					busMade[b] = true;
+				}
+				continue;
+			}
+			hcmNode* node = cell->getNode(getString(sn.name));
+			if(node == NULL) {
+				node = cell->createNode(getString(sn.name));
+			}
+			if(node && node->getPort() == NULL) {
+				node->createPort((hcmPortDir)sn.dir);
+			}
+		}
+		for(uint32_t b = 0; b < sc.numBuses; b++) {
+			if(!busMade[b]) {
+				const hcmSnapBus& sb = getBus(sc.firstBus + b);
+				cell->createBus(getString(sb.name), sb.from, sb.to, (hcmPortDir)sb.dir);
+			}
+		}
+
+		// the supply nodes, the ports and the bus bits already exist
+		hcmCellBuilder builder(cell);
+		builder.reserve(sc.numNodes, sc.numInsts, 0);
+		for(uint32_t n = sc.firstNode; n < sc.firstNode + sc.numNodes; n++) {
+			const hcmSnapNode& sn = getNode(n);
+			hcmNode* node = cell->getNode(getString(sn.name));
+			if(node) {
+				if(sn.dir != NOT_PORT && node->getPort() == NULL) {
+					node->createPort((hcmPortDir)sn.dir);
+				}
+				builder.useNode(node);
+			}
+			else {
+				builder.addNode(getString(sn.name), (hcmPortDir)sn.dir);
+			}
+		}
+		for(uint32_t i = sc.firstInst; i < sc.firstInst + sc.numInsts; i++) {
+			const hcmSnapInst& si = getInst(i);
+			if(si.master >= c) {
+				error = string("master of instance ") + getString(si.name) + " is not before its cell";
+				delete design;
+				return NULL;
+			}
+			int handle = builder.addInst(getString(si.name), cells[si.master]);
+			for(uint32_t p = si.firstPin; p < si.firstPin + si.numPins; p++) {
+				const hcmSnapPin& sp = getPin(p);
+				hcmPort* port = (sp.port < nodes.size() && nodes[sp.port]) ? nodes[sp.port]->getPort() : NULL;
+				if(port == NULL || sp.node < sc.firstNode || sp.node >= sc.firstNode + sc.numNodes) {
+					error = string("bad pin of instance ") + getString(si.name);
+					delete design;
+					return NULL;
+				}
+				builder.addPin(handle, sp.node - sc.firstNode, port);
+			}
+		}
+		if(builder.commit() != OK) {
+			error = builder.getErrors().front();
+			delete design;
+			return NULL;
+		}
+		for(uint32_t n = 0; n < sc.numNodes; n++) {
+			nodes[sc.firstNode + n] = builder.getNode(n);
+		}
+		for(uint32_t i = 0; i < sc.numInsts; i++) {
+			insts[sc.firstInst + i] = builder.getInst(i);
+		}
+	}
+
+	// the typed keys are registered once, by the index of the saved key
+	const hcmSnapPropKey* keys = section<hcmSnapPropKey>(SNAP_PROP_KEYS);
+	uint64_t numKeys = header->sections[SNAP_PROP_KEYS].count;
+	vector<hcmPropKey<int>> intKeys;
+	vector<hcmPropKey<double>> doubleKeys;
+	vector<hcmPropKey<bool>> boolKeys;
+	vector<hcmPropKey<string>> stringKeys;
+	vector<size_t> typedKey(numKeys);
+	for(uint64_t k = 0; k < numKeys; k++) {
+		string name = getString(keys[k].name);
+		switch(keys[k].type) {
+			case SNAP_INT: typedKey[k] = intKeys.size(); intKeys.emplace_back(name); break;
+			case SNAP_DOUBLE: typedKey[k] = doubleKeys.size(); doubleKeys.emplace_back(name); break;
+			case SNAP_BOOL: typedKey[k] = boolKeys.size(); boolKeys.emplace_back(name); break;
+			case SNAP_STRING: typedKey[k] = stringKeys.size(); stringKeys.emplace_back(name); break;
+		}
+	}
+
+	const hcmSnapProp* props = section<hcmSnapProp>(SNAP_PROPS);
+	for(uint64_t k = 0; k < header->sections[SNAP_PROPS].count; k++) {
+		const hcmSnapProp& sp = props[k];
+		// the indexes are in their tables, but a node or instance outside of every cell was never built
+		hcmObject* obj = NULL;
+		switch(sp.kind) {
+			case SNAP_DESIGN: obj = design; break;
+			case SNAP_CELL: obj = cells[sp.index]; break;
+			case SNAP_NODE: obj = nodes[sp.index]; break;
+			case SNAP_PORT: obj = nodes[sp.index] ? nodes[sp.index]->getPort() : NULL; break;
+			case SNAP_INST: obj = insts[sp.index]; break;
+			case SNAP_INST_PORT: {
+				const hcmSnapPin& pin = getPin(sp.index);
+				hcmPort* port = nodes[pin.port] ? nodes[pin.port]->getPort() : NULL;
+				obj = (insts[pin.inst] && port) ? insts[pin.inst]->getInstPort(port) : NULL;
+				break;
+			}
+		}
+		if(obj == NULL) {
+			error = "bad object of snapshot property " + to_string(k);
+			delete design;
+			return NULL;
+		}
+		size_t key = typedKey[sp.key];
+		switch(keys[sp.key].type) {
+			case SNAP_INT: obj->setProp(intKeys[key], (int)sp.value.i); break;
+			case SNAP_DOUBLE: obj->setProp(doubleKeys[key], sp.value.d); break;
+			case SNAP_BOOL: obj->setProp(boolKeys[key], sp.value.i != 0); break;
+			case SNAP_STRING: obj->setProp(stringKeys[key], string(getString(sp.value.s))); break;
+		}
+	}
+	return design;
+}
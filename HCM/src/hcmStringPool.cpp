@@ -0,0 +1,82 @@
+#include "hcm.h"
+#include <mutex>
+
+// the chunks grow with the pool from the first size to the largest, a longer string gets a chunk of its own
+#define HCM_POOL_FIRST_CHUNK 1024
+#define HCM_POOL_CHUNK_SIZE 65536
+
+hcmStringPool::hcmStringPool(){
+	chunkPtr = NULL;
+	chunkLeft = 0;
+	stats = hcmStringPoolStats();
+}
+
+string_view hcmStringPool::store(string_view s){
+	size_t len = s.size() + 1;
+	if(len > chunkLeft) {
+		size_t chunkSize = min(max(stats.chunkBytes, (size_t)HCM_POOL_FIRST_CHUNK), (size_t)HCM_POOL_CHUNK_SIZE);
+		chunkSize = max(len, chunkSize);
+		chunks.emplace_back(new char[chunkSize]);
+		chunkPtr = chunks.back().get();
+		chunkLeft = chunkSize;
+		stats.chunkBytes += chunkSize;
+	}
+	char* res = chunkPtr;
+	memcpy(res, s.data(), s.size());
+	res[s.size()] = 0;
+	chunkPtr += len;
+	chunkLeft -= len;
+	stats.bytes += len;
+	return string_view(res, s.size());
+}
+
+int hcmStringPool::intern(string_view s){
+	stats.lookups++;
+	auto it = ids.find(s);
+	if(it != ids.end()) {
+		stats.hits++;
+		return it->second;
+	}
+	int id = strings.size();
+	strings.push_back(store(s));
+	ids.emplace(strings.back(), id);
+	return id;
+}
+
+int hcmStringPool::find(string_view s) const{
+	auto it = ids.find(s);
+	if(it == ids.end()) {
+		return -1;
+	}
+	return it->second;
+}
+
+void hcmStringPool::reserve(size_t numStrings){
+	strings.reserve(numStrings);
+	ids.reserve(numStrings);
+}
+
+size_t hcmStringPool::bytes() const{
+	return stats.chunkBytes + hcmVectorBytes(chunks) + hcmVectorBytes(strings) + hcmHashBytes(ids);
+}
+
+// the string table of new_string, shared by all the threads
+static hcmStringPool& legacyPool(){
+	static hcmStringPool pool;
+	return pool;
+}
+static mutex legacyPoolLock;
+
+const char *new_string(const char *name){
+	lock_guard<mutex> guard(legacyPoolLock);
+	hcmStringPool& pool = legacyPool();
+	return pool.get(pool.intern(name)).data();
+}
+
+void delete_string(char *_name){
+	// the strings live as long as the program, only a string that was never made is reported
+	lock_guard<mutex> guard(legacyPoolLock);
+	if(legacyPool().find(_name) < 0) {
+		cerr << "Over delete "<< _name << endl;
+	}
+}
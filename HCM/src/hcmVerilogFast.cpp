@@ -0,0 +1,606 @@
+#include "hcm.h"
+#include "hcmVerilogIR.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// the hand written reader of the language of verilog.lpp/verilog.ypp.
+// the file is mapped and scanned in place, only the first occurrence of a name is copied
+// into the parsed file. the tokens follow the flex rules (longest match, then rule order)
+// and the statements are recorded as the grammar actions record them.
+
+typedef enum fastTokenKinds {
+  TOK_EOF, TOK_ID, TOK_INT, TOK_CONST, TOK_PUNCT,
+  TOK_MODULE, TOK_ENDMODULE, TOK_TYPE, TOK_OTHER_KEYWORD
+} fastTokenKind;
+
+struct fastToken {
+  fastTokenKind kind;
+  string_view text;
+  // value - the INT value, the punctuation char or the direction of a type.
+  int value;
+};
+
+class hcmFastVerilogReader {
+  // Abstraction Function:
+    //  p/end - the unread text of the mapped file.
+    //  tok - the lookahead token, line - the line the scanner is at.
+    //  ctx - the parsed file and the module being read.
+
+  private:
+    const char* p;
+    const char* end;
+    fastToken tok;
+    hcmParseContext ctx;
+
+    // the classes of the chars, as the flex rules use them
+    enum { ID_START = 1, ID_CHAR = 2, DIGIT = 4, CONST_DIGIT = 8, PUNCT = 16 };
+    struct charClassTable {
+      unsigned char classes[256];
+      charClassTable() {
+        for(int c = 0; c < 256; c++) {
+          bool idStart = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '/';
+          bool digit = c >= '0' && c <= '9';
+          bool constDigit = digit || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F') || c == 'x' || c == 'X' || c == 'z' || c == 'Z';
+          classes[c] = (idStart ? ID_START | ID_CHAR : 0) | (digit ? DIGIT | ID_CHAR : 0) | (c == '.' ? ID_CHAR : 0) |
+                       (constDigit ? CONST_DIGIT : 0) | ((c && strchr(":.{}[],*;=-+|()", c)) ? PUNCT : 0);
+        }
+      }
+    };
+    static const unsigned char* charClasses() {
+      // built once, the first reader to run builds it
+      static const charClassTable table;
+      return table.classes;
+    }
+
+    const unsigned char* classes;
+
+    bool isA(char c, int cls) const {
+      return classes[(unsigned char)c] & cls;
+    }
+
+    void newLine() {
+      ctx.line++;
+      if(ctx.line % 10000 == 0)
+        fprintf(stderr,"Parsing Verilog file for %d lines ...    \r",ctx.line);
+    }
+
+    // skips to the next \n and past it, false if there is none
+    bool skipLine() {
+      const char* nl = (const char*)memchr(p, '\n', end - p);
+      if(!nl) {
+        return false;
+      }
+      p = nl + 1;
+      newLine();
+      return true;
+    }
+
+    void keyword(string_view id) {
+      static const struct { string_view name; fastTokenKind kind; int dir; } keywords[] = {
+        {"module", TOK_MODULE, 0}, {"endmodule", TOK_ENDMODULE, 0},
+        {"input", TOK_TYPE, IN}, {"output", TOK_TYPE, OUT}, {"inout", TOK_TYPE, IN_OUT},
+        {"wire", TOK_TYPE, NOT_PORT}, {"wand", TOK_TYPE, NOT_PORT}, {"wor", TOK_TYPE, NOT_PORT},
+        {"tri", TOK_TYPE, NOT_PORT}, {"reg", TOK_TYPE, NOT_PORT}, {"supply1", TOK_TYPE, NOT_PORT},
+        {"supply0", TOK_TYPE, NOT_PORT}, {"trireg", TOK_OTHER_KEYWORD, 0},
+        {"assign", TOK_OTHER_KEYWORD, 0}, {"buf", TOK_OTHER_KEYWORD, 0}
+      };
+      tok.kind = TOK_ID;
+      // all the keywords are 3 to 9 lower case letters
+      if(id.size() < 3 || id.size() > 9 || id[0] < 'a' || id[0] > 'w') {
+        return;
+      }
+      for(size_t k = 0; k < sizeof(keywords) / sizeof(keywords[0]); k++) {
+        if(id.size() == keywords[k].name.size() && id[0] == keywords[k].name[0] && id == keywords[k].name) {
+          tok.kind = keywords[k].kind;
+          tok.value = keywords[k].dir;
+          return;
+        }
+      }
+    }
+
+    void next() {
+      while(p < end) {
+        char c = *p;
+        const char* start = p;
+        if(c == '\n') {
+          p++;
+          newLine();
+          continue;
+        }
+        if(c == '`') {
+          if(!skipLine()) {
+            p++;
+          }
+          continue;
+        }
+        if(c == '/' && p + 1 < end && p[1] == '*') {
+          for(p += 2; p < end && !(*p == '*' && p + 1 < end && p[1] == '/'); p++) {
+            if(*p == '\n') {
+              newLine();
+            }
+          }
+          p = min(p + 2, end);
+          continue;
+        }
+        if(c == '/' && p + 1 < end && p[1] == '/' && skipLine()) {
+          continue;
+        }
+        if(isA(c, ID_START)) {
+          while(p < end && isA(*p, ID_CHAR)) {
+            p++;
+          }
+          tok.text = string_view(start, p - start);
+          keyword(tok.text);
+          return;
+        }
+        if(c == '\\' && p + 1 < end && p[1] != ' ' && p[1] != '\t' && p[1] != '\n') {
+          for(p++; p < end && *p != ' ' && *p != '\t' && *p != '\n'; p++) {
+          }
+          tok.kind = TOK_ID;
+          tok.text = string_view(start + 1, p - start - 1);
+          return;
+        }
+        const char* d = p;
+        if((c == '-' || c == '+') && p + 1 < end && isA(p[1], DIGIT)) {
+          d++;
+        }
+        if(d < end && isA(*d, DIGIT)) {
+          const char* q = d + 1;
+          if(*d != '0') {
+            while(q < end && isA(*q, DIGIT)) {
+              q++;
+            }
+            // a sized constant, 4'b0101
+            if(d == p && q + 2 < end && *q == '\'' && (q[1] == 'b' || q[1] == 'h' || q[1] == 'd') && isA(q[2], CONST_DIGIT)) {
+              for(q += 3; q < end && isA(*q, CONST_DIGIT); q++) {
+              }
+              p = q;
+              tok.kind = TOK_CONST;
+              tok.text = string_view(start, p - start);
+              return;
+            }
+          }
+          p = q;
+          tok.kind = TOK_INT;
+          tok.text = string_view(start, p - start);
+          tok.value = 0;
+          for(const char* v = d; v < p; v++) {
+            tok.value = tok.value * 10 + (*v - '0');
+          }
+          if(c == '-') {
+            tok.value = -tok.value;
+          }
+          return;
+        }
+        p++;
+        if(isA(c, PUNCT)) {
+          tok.kind = TOK_PUNCT;
+          tok.value = c;
+          tok.text = string_view(start, 1);
+          return;
+        }
+      }
+      tok.kind = TOK_EOF;
+      tok.text = string_view();
+    }
+
+    bool is(char c) const {
+      return tok.kind == TOK_PUNCT && tok.value == c;
+    }
+
+    // the reading of a rule stops at the first token the grammar doesn't allow
+    bool expect(char c) {
+      if(!is(c)) {
+        return false;
+      }
+      next();
+      return true;
+    }
+
+    bool readInt(int& v) {
+      if(tok.kind != TOK_INT) {
+        return false;
+      }
+      v = tok.value;
+      next();
+      return true;
+    }
+
+    bool readId(const char*& name) {
+      if(tok.kind != TOK_ID) {
+        return false;
+      }
+      name = ctx.file->newString(tok.text);
+      next();
+      return true;
+    }
+
+    bool readModule();
+    bool readPorts();
+    bool readDeclaration();
+    bool readInstance(const char* master);
+    bool readPin();
+    bool readNet();
+
+  public:
+    hcmFastVerilogReader(hcmParsedFile* file, const char* text, size_t size, int firstLine = 1) :
+      p(text), end(text + size), tok(), ctx(file), classes(charClasses()) {
+      ctx.line = firstLine;
+    }
+
+    /** @fn bool read()
+     * @brief reads all the modules of the text into the parsed file.
+     * @return false on the first syntax error.
+     */
+    bool read() {
+      next();
+      while(tok.kind == TOK_MODULE) {
+        if(!readModule()) {
+          return false;
+        }
+      }
+      return tok.kind == TOK_EOF;
+    }
+
+    /** @fn bool index(vector<hcmLibraryModule>& modules)
+     * @brief finds the modules of the text by their keywords only, the bodies are not read.
+     * @param modules - the modules found are added here, with their text range from the start of the text.
+     * @return false if there is anything but modules in the text.
+     */
+    bool index(vector<hcmLibraryModule>& modules) {
+      const char* text = p;
+      next();
+      while(tok.kind == TOK_MODULE) {
+        hcmLibraryModule m;
+        m.begin = tok.text.data() - text;
+        m.line = ctx.line;
+        next();
+        if(tok.kind != TOK_ID) {
+          return false;
+        }
+        m.name = string(tok.text);
+        while(tok.kind != TOK_ENDMODULE) {
+          if(tok.kind == TOK_EOF || tok.kind == TOK_MODULE) {
+            return false;
+          }
+          next();
+        }
+        m.end = p - text;
+        modules.push_back(m);
+        next();
+      }
+      return tok.kind == TOK_EOF;
+    }
+};
+
+bool hcmFastVerilogReader::readModule(){
+  next();
+  const char* name;
+  if(!readId(name)) {
+    return false;
+  }
+  ctx.file->modules.emplace_back();
+  ctx.module = &ctx.file->modules.back();
+  ctx.module->name = name;
+  ctx.module->line = ctx.line;
+  if(!readPorts() || !expect(';')) {
+    return false;
+  }
+  // the body has at least one statement
+  bool empty = true;
+  while(tok.kind != TOK_ENDMODULE) {
+    const char* master;
+    if(tok.kind == TOK_TYPE) {
+      if(!readDeclaration()) {
+        return false;
+      }
+    }
+    else if(readId(master)) {
+      ctx.master = master;
+      if(!readInstance(master)) {
+        return false;
+      }
+    }
+    else {
+      return false;
+    }
+    empty = false;
+  }
+  if(empty) {
+    return false;
+  }
+  next();
+  ctx.module = NULL;
+  return true;
+}
+
+bool hcmFastVerilogReader::readPorts(){
+  if(!expect('(')) {
+    return true;
+  }
+  if(expect(')')) {
+    return true;
+  }
+  do {
+    const char* name;
+    if(!readId(name)) {
+      return false;
+    }
+    int bit;
+    if(expect('[')) {
+      if(!readInt(bit) || !expect(']')) {
+        return false;
+      }
+      name = ctx.file->newString(busNodeName(name, bit));
+    }
+    ctx.module->ports.push_back(name);
+  } while(expect(','));
+  return expect(')');
+}
+
+bool hcmFastVerilogReader::readDeclaration(){
+  ctx.range.dir = (hcmPortDir)tok.value;
+  ctx.range.type = WireNet;
+  ctx.range.upper = -1;
+  ctx.range.lower = -1;
+  next();
+  if(expect('[')) {
+    if(!readInt(ctx.range.upper) || !expect(':') || !readInt(ctx.range.lower) || !expect(']')) {
+      return false;
+    }
+  }
+  do {
+    hcmParsedStmt stmt = {};
+    stmt.line = ctx.line;
+    stmt.master = ctx.master;
+    stmt.dir = NOT_PORT;
+    stmt.firstPin = ctx.module->pins.size();
+    if(!readId(stmt.name)) {
+      return false;
+    }
+    if(expect('[')) {
+      stmt.lower = -1;
+      if(!readInt(stmt.upper)) {
+        return false;
+      }
+      stmt.kind = STMT_BIT;
+      if(expect(':')) {
+        stmt.kind = STMT_BUS;
+        if(!readInt(stmt.lower)) {
+          return false;
+        }
+      }
+      if(!expect(']')) {
+        return false;
+      }
+    }
+    else {
+      stmt.kind = STMT_SIGNAL;
+      stmt.upper = ctx.range.upper;
+      stmt.lower = ctx.range.lower;
+      stmt.dir = ctx.range.dir;
+    }
+    ctx.module->stmts.push_back(stmt);
+  } while(expect(','));
+  return expect(';');
+}
+
+bool hcmFastVerilogReader::readInstance(const char* master){
+  do {
+    hcmParsedStmt stmt = {};
+    stmt.kind = STMT_INST;
+    stmt.line = ctx.line;
+    stmt.master = master;
+    stmt.upper = -1;
+    stmt.lower = -1;
+    stmt.dir = NOT_PORT;
+    stmt.firstPin = ctx.module->pins.size();
+    if(!readId(stmt.name) || !expect('(')) {
+      return false;
+    }
+    ctx.module->stmts.push_back(stmt);
+    // the first pin may be left out, u1(, a)
+    if(!is(',') && !is(')') && !readPin()) {
+      return false;
+    }
+    while(expect(',')) {
+      if(!readPin()) {
+        return false;
+      }
+    }
+    if(!expect(')')) {
+      return false;
+    }
+    hcmParsedStmt& last = ctx.module->stmts.back();
+    last.numPins = ctx.module->pins.size() - last.firstPin;
+  } while(expect(','));
+  return expect(';');
+}
+
+bool hcmFastVerilogReader::readPin(){
+  hcmParsedPin pin;
+  pin.port = NULL;
+  pin.bit = -1;
+  if(expect('.')) {
+    if(!readId(pin.port)) {
+      return false;
+    }
+    if(expect('[')) {
+      if(!readInt(pin.bit) || !expect(']')) {
+        return false;
+      }
+    }
+    if(!expect('(')) {
+      return false;
+    }
+    // .a() is not connected
+    if(expect(')')) {
+      return true;
+    }
+    pin.firstNet = ctx.module->nets.size();
+    if(!readNet()) {
+      return false;
+    }
+    pin.line = ctx.line;
+    if(!expect(')')) {
+      return false;
+    }
+  }
+  else {
+    pin.firstNet = ctx.module->nets.size();
+    if(!readNet()) {
+      return false;
+    }
+    pin.line = ctx.line;
+  }
+  pin.numNets = ctx.module->nets.size() - pin.firstNet;
+  ctx.module->pins.push_back(pin);
+  return true;
+}
+
+bool hcmFastVerilogReader::readNet(){
+  hcmParsedNet net = { NULL, -1, -1, false };
+  if(tok.kind == TOK_CONST) {
+    net.name = ctx.file->newString(tok.text);
+    net.constant = true;
+    next();
+  }
+  else if(expect('{')) {
+    do {
+      if(!readNet()) {
+        return false;
+      }
+    } while(expect(','));
+    return expect('}');
+  }
+  else {
+    if(!readId(net.name)) {
+      return false;
+    }
+    if(expect('[')) {
+      if(!readInt(net.left)) {
+        return false;
+      }
+      net.right = net.left;
+      if(expect(':') && !readInt(net.right)) {
+        return false;
+      }
+      if(!expect(']')) {
+        return false;
+      }
+    }
+  }
+  ctx.module->nets.push_back(net);
+  return true;
+}
+
+hcmParsedFile* read_verilog_file_fast(const char *fn)
+{
+  int fd = open(fn, O_RDONLY);
+  struct stat st;
+  if(fd < 0 || fstat(fd, &st) != 0) {
+    if(fd >= 0) {
+      close(fd);
+    }
+    cerr << "Cannot open " << fn << endl;
+    return NULL;
+  }
+  size_t size = st.st_size;
+  void* text = NULL;
+  if(size) {
+    text = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(text == MAP_FAILED) {
+      close(fd);
+      // not a regular file, the scanner reads it as a stream
+      return read_verilog_file(fn);
+    }
+    madvise(text, size, MADV_SEQUENTIAL);
+  }
+  close(fd);
+
+  hcmParsedFile* file = new hcmParsedFile();
+  file->fileName = fn;
+  // about a new name per 24 bytes in the ISCAS netlists
+  file->reserveStrings(size / 24);
+  file->ok = hcmFastVerilogReader(file, (const char*)text, size).read();
+  if(size) {
+    munmap(text, size);
+  }
+  if(!file->ok) {
+    // the flex/bison parser reports the error and keeps the modules before it
+    delete file;
+    return read_verilog_file(fn);
+  }
+  return file;
+}
+
+// maps the file \a fn for reading, false with a message if it can't be mapped
+static bool map_verilog_file(const char *fn, const char*& text, size_t& size)
+{
+  int fd = open(fn, O_RDONLY);
+  struct stat st;
+  if(fd < 0 || fstat(fd, &st) != 0) {
+    if(fd >= 0) {
+      close(fd);
+    }
+    cerr << "Cannot open " << fn << endl;
+    return false;
+  }
+  size = st.st_size;
+  text = NULL;
+  if(size) {
+    void* m = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(m == MAP_FAILED) {
+      close(fd);
+      cerr << "Cannot map " << fn << endl;
+      return false;
+    }
+    text = (const char*)m;
+  }
+  close(fd);
+  return true;
+}
+
+bool index_verilog_file(const char *fn, vector<hcmLibraryModule>& modules)
+{
+  const char* text;
+  size_t size;
+  if(!map_verilog_file(fn, text, size)) {
+    return false;
+  }
+  madvise((void*)text, size, MADV_SEQUENTIAL);
+  hcmParsedFile scratch;
+  bool ok = hcmFastVerilogReader(&scratch, text, size).index(modules);
+  if(size) {
+    munmap((void*)text, size);
+  }
+  if(!ok) {
+    cerr << "Syntax error in library " << fn << ", only modules are expected" << endl;
+  }
+  return ok;
+}
+
+hcmParsedFile* read_verilog_module(const char *fn, const hcmLibraryModule& module)
+{
+  const char* text;
+  size_t size;
+  if(!map_verilog_file(fn, text, size)) {
+    return NULL;
+  }
+  hcmParsedFile* file = new hcmParsedFile();
+  file->fileName = fn;
+  if(module.end <= size) {
+    file->ok = hcmFastVerilogReader(file, text + module.begin, module.end - module.begin, module.line).read();
+  }
+  if(size) {
+    munmap((void*)text, size);
+  }
+  if(!file->ok || file->modules.size() != 1) {
+    cerr << "Syntax error in module " << module.name << " of library " << fn << " line " << module.line << endl;
+    delete file;
+    return NULL;
+  }
+  return file;
+}
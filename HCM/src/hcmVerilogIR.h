@@ -0,0 +1,265 @@
+#ifndef HCM_VERILOG_IR_H
+#define HCM_VERILOG_IR_H
+
+// the parsed form of a structural verilog file, private to the library.
+// the parser only fills these records, so files can be parsed on any thread. a design
+// is built from them afterwards by hcmVerilogLinker, on the thread owning the design.
+
+#include "hcm.h"
+
+// the kinds of the statements of a module body.
+typedef enum hcmParsedStmtKinds {
+  STMT_SIGNAL,      /**< a declared signal, a bus if it has a range.*/
+  STMT_BIT,         /**< a bit declared by its index, wire a[3]. never a port.*/
+  STMT_BUS,         /**< a bus with the range after its name, wire a[3:0]. never a port.*/
+  STMT_INST         /**< an instance.*/
+} hcmParsedStmtKind;
+
+// a net expression of a pin, expanded to nodes when linked.
+struct hcmParsedNet {
+  // name - the signal or bus, the text of the constant if constant.
+  const char* name;
+  // left/right - the bits taken from left to right, -1 for the whole signal or bus.
+  int left, right;
+  bool constant;
+};
+
+// a connection of an instance.
+struct hcmParsedPin {
+  // port - the master port, NULL if connected by order.
+  const char* port;
+  // bit - the port is port[bit], -1 if not a bit.
+  int bit;
+  int line;
+  // firstNet/numNets - the range of the pin in the nets of the module.
+  uint32_t firstNet, numNets;
+};
+
+struct hcmParsedStmt {
+  hcmParsedStmtKind kind;
+  int line;
+  const char* name;
+  // master - the master of an instance.
+  const char* master;
+  // upper/lower - the range of a signal or a bus, -1 if none. upper is the index of a bit.
+  int upper, lower;
+  hcmPortDir dir;
+  // firstPin/numPins - the range of an instance in the pins of the module.
+  uint32_t firstPin, numPins;
+};
+
+struct hcmParsedModule {
+  const char* name;
+  int line;
+  // ports - the port list of the header in order, a bit port is named port[bit].
+  vector<const char*> ports;
+  // stmts - the declarations and instances in file order.
+  vector<hcmParsedStmt> stmts;
+  vector<hcmParsedPin> pins;
+  vector<hcmParsedNet> nets;
+};
+
+/**
+ * A hcmParsedFile is the result of parsing one verilog file - its complete modules and the
+ * strings they refer to. modules before a syntax error are kept, the module with the error is not.
+ * hcmParsedFile is a mutable object.
+ */
+class hcmParsedFile {
+  // RepInvariant:
+  	//  every name in modules points into strings
+
+  private:
+    hcmStringPool strings;
+
+  public:
+    string fileName;
+    // ok - the file was read with no syntax error.
+    bool ok;
+    vector<hcmParsedModule> modules;
+
+    hcmParsedFile() : ok(false) {}
+
+    /** @fn const char* newString(string_view s)
+     * @brief interns \a s, the result lives as long as this object.\n
+     * only the first lookup of a string copies it, \a s may point into a buffer that goes away.
+     */
+    const char* newString(string_view s) {
+      return strings.get(strings.intern(s)).data();
+    }
+
+    /** @fn void reserveStrings(size_t numStrings)
+     * @brief makes room for \a numStrings strings without rehashing.
+     */
+    void reserveStrings(size_t numStrings) {
+      strings.reserve(numStrings);
+    }
+
+    /** @fn const hcmStringPoolStats& getStringStats() const
+     * @brief gets the counters of the strings of the file.
+     */
+    const hcmStringPoolStats& getStringStats() const {
+      return strings.getStats();
+    }
+};
+
+/**
+ * A hcmParseContext is the state of one run of the reentrant parser and scanner.
+ */
+struct hcmParseContext {
+  hcmParsedFile* file;
+  // module - the module being parsed, NULL between modules.
+  hcmParsedModule* module;
+  // range - the type of the current declaration.
+  Range range;
+  // master - the master of the current instance statement.
+  const char* master;
+  // firstNet - the first net of the pin being parsed.
+  uint32_t firstNet;
+  int line;
+
+  hcmParseContext(hcmParsedFile* f) : file(f), module(NULL), range(), master(""), firstNet(0), line(1) {}
+};
+
+/** @fn hcmParsedFile* read_verilog_file(const char *fn)
+ * @brief parses the file \a fn, touches no shared state.
+ * @return the parsed file, owned by the caller\n NULL if it can't be opened.
+ */
+hcmParsedFile* read_verilog_file(const char *fn);
+
+/** @fn hcmParsedFile* read_verilog_file_fast(const char *fn)
+ * @brief parses the file \a fn as read_verilog_file() does, by the hand written reader of the mapped file.\n
+ * a file with a syntax error is read again by read_verilog_file(), for its messages and modules.
+ * @return the parsed file, owned by the caller\n NULL if it can't be opened.
+ */
+hcmParsedFile* read_verilog_file_fast(const char *fn);
+
+/** @fn hcmParsedFile* read_verilog_file_cached(const char *fn, const string& cacheDir, hcmParsedFile* (*readFile)(const char*), bool& hit)
+ * @brief gets the parsed file \a fn from the parse cache in \a cacheDir by the hash of its text.\n
+ * a file missing from the cache is parsed by \a readFile and, if it has no syntax error, added to it.
+ * @param hit - set to whether the file was read from the cache.
+ * @return the parsed file, owned by the caller\n NULL if it can't be opened.
+ */
+hcmParsedFile* read_verilog_file_cached(const char *fn, const string& cacheDir, hcmParsedFile* (*readFile)(const char*),
+                                        bool& hit);
+
+// a module found by index_verilog_file(), not read yet.
+struct hcmLibraryModule {
+  string name;
+  // begin/end - the text of the module in the file, from its module keyword to past its endmodule.
+  size_t begin, end;
+  // line - the line of the module keyword.
+  int line;
+};
+
+/** @fn bool index_verilog_file(const char *fn, vector<hcmLibraryModule>& modules)
+ * @brief finds the modules of the file \a fn by their keywords, without reading their bodies.
+ * @return true if the file holds only modules\n false if it can't be opened or holds anything else.
+ */
+bool index_verilog_file(const char *fn, vector<hcmLibraryModule>& modules);
+
+/** @fn hcmParsedFile* read_verilog_module(const char *fn, const hcmLibraryModule& module)
+ * @brief parses the text of \a module only, by the hand written reader.
+ * @return the parsed file holding the module, owned by the caller\n NULL if it can't be read.
+ */
+hcmParsedFile* read_verilog_module(const char *fn, const hcmLibraryModule& module);
+
+/**
+ * A hcmVerilogLinker builds the parsed modules into a design.
+ * masters are resolved among all the linked files and then in the design, and a module is
+ * built after the modules it instantiates, so masters may come from any file in any order.
+ * errors in the connections stop the program as the parser always did.
+ * hcmVerilogLinker is a mutable object.
+ */
+class hcmVerilogLinker {
+  // Abstraction Function:
+    //  design - the design the modules are added to.
+    //  modules - the modules of the linked files, moduleIdx finds them by name. the first definition wins.
+    //  file/cell/inst/line - the statement being built, for the messages.
+    //  currentNodes - the nodes of the pin being connected.
+
+  private:
+    typedef enum { UNLINKED, LINKING, LINKED } linkState;
+    struct moduleRec {
+      const hcmParsedFile* file;
+      const hcmParsedModule* module;
+      linkState state;
+    };
+
+    hcmDesign* design;
+    vector<moduleRec> modules;
+    unordered_map<string, size_t> moduleIdx;
+    const hcmParsedFile* file;
+    hcmCell* cell;
+    hcmInstance* inst;
+    const char* master;
+    int line;
+    vector<hcmNode*> currentNodes;
+
+    void linkModule(size_t idx);
+    void declare(const hcmParsedStmt& stmt);
+    void createInstance(const hcmParsedModule& module, const hcmParsedStmt& stmt);
+    void pushBus(const char* busName, int left, int right);
+    void pushBinaryBus(const char* binaryBusChar);
+    void connectNodes(const string& portName);
+    void connectNodesToPorts(const vector<hcmPort*>& availablePorts, const string& portName);
+    void connectNodesToNextPort(int portIdx);
+
+  public:
+    hcmVerilogLinker(hcmDesign* d);
+
+    /** @fn void link(const vector<hcmParsedFile*>& files)
+     * @brief adds the modules of \a files to the design, all the files are resolved together.
+     */
+    void link(const vector<hcmParsedFile*>& files);
+};
+
+/**
+ * A hcmVerilogLibrary is the index of the modules of library files, by their name.
+ * a module is read and built into a cell of the design only when the design first asks for it,
+ * so the cost of a library is the cost of the modules that are used.
+ * hcmVerilogLibrary is a mutable object.
+ */
+class hcmVerilogLibrary {
+  // RepInvariant:
+  	//  modules[i] is the module named names.get(i)
+
+  // Abstraction Function:
+    //  files - the indexed files.
+    //  names - the names of the modules, the first module of a name wins.
+    //  modules/fileOf/built - the text range, the file and the state of each module by its name id.
+  private:
+    hcmDesign* design;
+    vector<string> files;
+    hcmStringPool names;
+    vector<hcmLibraryModule> modules;
+    vector<size_t> fileOf;
+    vector<bool> built;
+
+  public:
+    hcmVerilogLibrary(hcmDesign* d) : design(d) {}
+
+    /** @fn bool addFile(const char* fn)
+     * @brief indexes the modules of the file \a fn.
+     * @return false if the file can't be read or holds anything but modules.
+     */
+    bool addFile(const char* fn);
+
+    /** @fn hcmCell* build(string_view name)
+     * @brief reads and builds the module \a name into a cell of the design, the masters it needs are got from
+     * the design and so built too. a module is built once, even if it fails.
+     * @return the cell of the module\n Null if there is no such module or it failed.
+     */
+    hcmCell* build(string_view name);
+
+    /** @fn size_t size() const
+     * @brief gets the number of indexed modules.
+     */
+    size_t size() const { return modules.size(); }
+
+    /** @fn size_t bytes() const
+     * @brief gets an estimate of the heap bytes held by the index.
+     */
+    size_t bytes() const;
+};
+
+#endif
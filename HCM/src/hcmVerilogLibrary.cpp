@@ -0,0 +1,47 @@
+#include "hcm.h"
+#include "hcmVerilogIR.h"
+
+bool hcmVerilogLibrary::addFile(const char* fn){
+	vector<hcmLibraryModule> found;
+	if(!index_verilog_file(fn, found)) {
+		return false;
+	}
+	files.push_back(fn);
+	for(auto mI = found.begin(); mI != found.end(); ++mI) {
+		// the first module of a name wins, as in the linker
+		if((size_t)names.intern(mI->name) == modules.size()) {
+			modules.push_back(*mI);
+			fileOf.push_back(files.size() - 1);
+			built.push_back(false);
+		}
+	}
+	return true;
+}
+
+hcmCell* hcmVerilogLibrary::build(string_view name){
+	int id = names.find(name);
+	if(id < 0 || built[id]) {
+		return NULL;
+	}
+	built[id] = true;
+	hcmParsedFile* file = read_verilog_module(files[fileOf[id]].c_str(), modules[id]);
+	if(!file) {
+		return NULL;
+	}
+	// masters outside the module are got from the design, building them from the library on the way
+	vector<hcmParsedFile*> parsed(1, file);
+	hcmVerilogLinker(design).link(parsed);
+	delete file;
+	return design->getCell(name);
+}
+
+size_t hcmVerilogLibrary::bytes() const{
+	size_t res = names.bytes() + hcmVectorBytes(files) + hcmVectorBytes(modules) + hcmVectorBytes(fileOf) + built.capacity() / 8;
+	for(auto fI = files.begin(); fI != files.end(); ++fI) {
+		res += hcmStringBytes(*fI);
+	}
+	for(auto mI = modules.begin(); mI != modules.end(); ++mI) {
+		res += hcmStringBytes(mI->name);
+	}
+	return res;
+}
@@ -0,0 +1,284 @@
+#include "hcm.h"
+#include "hcmVerilogIR.h"
+#include <list>
+
+#define IMPLICIT_WIRES 1
+
+hcmVerilogLinker::hcmVerilogLinker(hcmDesign* d){
+	design = d;
+	file = NULL;
+	cell = NULL;
+	inst = NULL;
+	master = "";
+	line = 0;
+}
+
+void hcmVerilogLinker::link(const vector<hcmParsedFile*>& files){
+	modules.clear();
+	moduleIdx.clear();
+	for(auto fI = files.begin(); fI != files.end(); ++fI) {
+		const hcmParsedFile* f = *fI;
+		for(auto mI = f->modules.begin(); mI != f->modules.end(); ++mI) {
+			if(moduleIdx.emplace(mI->name, modules.size()).second) {
+				modules.push_back(moduleRec{f, &(*mI), UNLINKED});
+			}
+			else {
+				cout << "Cell: " << mI->name << " already exists in the design!" << endl;
+			}
+		}
+	}
+	// in file order, a module is linked after the masters it instantiates
+	for(size_t i = 0; i < modules.size(); i++) {
+		linkModule(i);
+	}
+}
+
+void hcmVerilogLinker::linkModule(size_t idx){
+	moduleRec& rec = modules[idx];
+	if(rec.state != UNLINKED) {
+		return;
+	}
+	rec.state = LINKING;
+	const hcmParsedModule& module = *rec.module;
+	for(auto sI = module.stmts.begin(); sI != module.stmts.end(); ++sI) {
+		if(sI->kind != STMT_INST) {
+			continue;
+		}
+		auto mI = moduleIdx.find(sI->master);
+		if(mI != moduleIdx.end()) {
+			linkModule(mI->second);
+		}
+	}
+
+	file = rec.file;
+	line = module.line;
+	cell = design->createCell(module.name);
+	if(cell) {
+		cell->setPortOrder(vector<string>(module.ports.begin(), module.ports.end()));
+		for(auto sI = module.stmts.begin(); sI != module.stmts.end(); ++sI) {
+			if(sI->kind == STMT_INST) {
+				createInstance(module, *sI);
+			}
+			else {
+				declare(*sI);
+			}
+		}
+	}
+	cell = NULL;
+	inst = NULL;
+	rec.state = LINKED;
+}
+
+void hcmVerilogLinker::declare(const hcmParsedStmt& stmt){
+	line = stmt.line;
+	if(stmt.kind == STMT_BIT) {
+		cell->createNode(busNodeName(stmt.name,stmt.upper));
+		return;
+	}
+	if(stmt.kind == STMT_BUS) {
+		cell->createBus(stmt.name,stmt.upper,stmt.lower,NOT_PORT);
+		return;
+	}
+	if(stmt.lower >= 0) {
+		cell->createBus(stmt.name,stmt.upper,stmt.lower,stmt.dir);
+		return;
+	}
+	hcmNode* n = cell->getNode(stmt.name);
+	if (!n) {
+		n = cell->createNode(stmt.name);
+		if (!n) {
+			fprintf(stderr,"\nadd_new_bus: Failed to create node: %s in file %s line %d\n", stmt.name, file->fileName.c_str(),line);
+			exit(1);
+		}
+	}
+	if(stmt.dir != NOT_PORT){
+		n->createPort(stmt.dir);
+	}
+}
+
+void hcmVerilogLinker::createInstance(const hcmParsedModule& module, const hcmParsedStmt& stmt){
+	line = stmt.line;
+	master = stmt.master;
+	inst = cell->createInst(stmt.name,master);
+	if (!inst) {
+		fprintf(stderr,"\ncreateInstance: Failed to create instance: %s of master: %s in file %s line %d\n", stmt.name, master, file->fileName.c_str(),line);
+		exit(1);
+	}
+	// portIdx - the next port of the master for the pins connected by order
+	int portIdx = 0;
+	for(uint32_t p = stmt.firstPin; p < stmt.firstPin + stmt.numPins; p++) {
+		const hcmParsedPin& pin = module.pins[p];
+		line = pin.line;
+		currentNodes.clear();
+		for(uint32_t n = pin.firstNet; n < pin.firstNet + pin.numNets; n++) {
+			const hcmParsedNet& net = module.nets[n];
+			if(net.constant) {
+				pushBinaryBus(net.name);
+			}
+			else {
+				pushBus(net.name,net.left,net.right);
+			}
+		}
+		if(!pin.port) {
+			connectNodesToNextPort(portIdx++);
+		}
+		else if(pin.bit < 0) {
+			connectNodes(pin.port);
+		}
+		else {
+			connectNodes(busNodeName(pin.port,pin.bit));
+		}
+	}
+}
+
+void hcmVerilogLinker::connectNodes(const string& portName){
+	connectNodesToPorts(inst->getAvailablePorts(portName), portName);
+}
+
+void hcmVerilogLinker::connectNodesToPorts(const vector<hcmPort*>& availablePorts, const string& portName){
+	if (currentNodes.size() <= 1) {
+		if (currentNodes.empty() || !currentNodes[0]) {
+			fprintf(stderr,"\nconnectNodes: The node is not available in file %s line %d\n",file->fileName.c_str(),line);
+			exit(1);
+		}
+		// a single node is connected to all the available ports, none if they are taken
+		for(auto pI = availablePorts.begin(); pI != availablePorts.end(); ++pI) {
+			cell->connect(inst,currentNodes[0],*pI);
+		}
+	} else {
+		unsigned int availablePortsNum = availablePorts.size();
+		if(availablePortsNum==0){
+			fprintf(stderr,"\nconnectNodes: The port is not available in file %s line %d\n",file->fileName.c_str(),line);
+			exit(1);
+		}
+		if(availablePortsNum < currentNodes.size()){
+			fprintf(stderr,"\nconnectNodes: The width: %d of port: %s is not sufficient for connecting nodes: %lu in file %s line %d\n",
+				availablePortsNum, portName.c_str(), currentNodes.size(), file->fileName.c_str(),line);
+			for (unsigned int i = 0; i < currentNodes.size(); i++) {
+				if (currentNodes[i]) {
+					fprintf(stderr, "  node: %s\n", currentNodes[i]->getName().c_str());
+				} else {
+					fprintf(stderr, "  node: NULL\n");
+				}
+			}
+			exit(1);
+		}
+		int m = currentNodes.size() - 1;
+		for(int i = 0;i<=m;i++) {
+			cell->connect(inst,currentNodes[i],availablePorts[i]);
+		}
+	}
+	currentNodes.clear();
+}
+
+/* connect based on order of ports, by the port order table compiled on the master */
+void hcmVerilogLinker::connectNodesToNextPort(int portIdx){
+	hcmCell* masterCell = inst->masterCell();
+	const vector<string>* portOrder = masterCell->getPortOrder();
+	if (!portOrder) {
+		fprintf(stderr,"\nconnectNodesToNextPort: No ports for master %s in file %s line %d\n",
+			master, file->fileName.c_str(),line);
+		exit(1);
+	}
+	const vector<hcmPort*>* ports = masterCell->getOrderedPorts(portIdx);
+	if (!ports) {
+		fprintf(stderr,"\nconnectNodesToNextPort: Not enough ports for master %s (%ld <= %d) in file %s line %d\n",
+			master, portOrder->size(), portIdx, file->fileName.c_str(),line);
+		exit(1);
+	}
+	// as by name, the ports are available only if none of them is connected yet
+	for(auto pI = ports->begin(); pI != ports->end(); ++pI) {
+		if (inst->isConnected(*pI)) {
+			connectNodesToPorts(vector<hcmPort*>(), (*portOrder)[portIdx]);
+			return;
+		}
+	}
+	connectNodesToPorts(*ports, (*portOrder)[portIdx]);
+}
+
+void hcmVerilogLinker::pushBus(const char* busName, int left, int right){
+	string nodeName;
+
+	// we may get a signal name but it is a predefined bus...
+	hcmBus *bus = cell->getBus(busName);
+	if (left < 0 && bus) {
+		left = bus->getFrom();
+		right = bus->getTo();
+	}
+	if (left < 0) {
+		nodeName = busName;
+		hcmNode *node = cell->getNode(nodeName);
+#ifdef IMPLICIT_WIRES
+		if (!node) {
+			node = cell->createNode(nodeName);
+		}
+#endif
+		if (!node) {
+			fprintf(stderr,"\nError finding node %s in file %s line %d \n",
+				nodeName.c_str(), file->fileName.c_str(),line);
+			exit(1);
+		}
+		currentNodes.push_back(node);
+		return;
+	}
+
+	int step = (left >= right) ? -1 : 1;
+	for (int i = left; i != right + step; i += step) {
+		// bits of a bus are taken by index, bits declared one by one (wire a[3]) by name
+		hcmNode *node = bus ? bus->getNode(i) : NULL;
+		if (!node) {
+			nodeName = busNodeName(busName,i);
+			node = cell->getNode(nodeName);
+		}
+#ifdef IMPLICIT_WIRES
+		if (!node) {
+			node = cell->createNode(nodeName);
+		}
+#endif
+		if (!node) {
+			fprintf(stderr,"\nError finding node %s in file %s line %d \n",
+				nodeName.c_str(), file->fileName.c_str(),line);
+			exit(1);
+		}
+		currentNodes.push_back(node);
+	}
+}
+
+void hcmVerilogLinker::pushBinaryBus(const char* binaryBusChar){
+	string binaryBus = binaryBusChar;
+	size_t i = binaryBus.find("'");
+	if( i == std::string::npos ) {
+		fprintf(stderr,"\nError in constant (no \"'\") in file %s line %d \n",file->fileName.c_str(),line);
+		exit(1);
+	}
+
+	string base = binaryBus.substr(i+1,i+1);
+	string busLen = binaryBus.substr(0,i);
+	string valStr = binaryBus.substr(i+2);
+	unsigned long int val;
+	switch ((base.c_str())[0]) {
+	case 'b': val = strtoull(valStr.c_str(), NULL, 2); break;
+	case 'd': val = strtoull(valStr.c_str(), NULL, 10); break;
+	case 'h': val = strtoull(valStr.c_str(), NULL, 16); break;
+	default:
+		fprintf(stderr,"\nError in unknwon base %s of constant file %s line %d \n",
+			base.c_str(), file->fileName.c_str(),line);
+		exit(1);
+	}
+
+	// convert the value to binary bus of width "bus length"
+	unsigned int numBits = atoi(busLen.c_str());
+	list<hcmNode*> busNodes;
+	for (unsigned int i = 0; i < numBits; i++) {
+		if (val % 2) {
+			busNodes.push_front(cell->getNode("VDD"));
+		} else {
+			busNodes.push_front(cell->getNode("VSS"));
+		}
+		val = val >> 1;
+	}
+	// copy in order to currentNodes
+	for (list<hcmNode*>::iterator lI = busNodes.begin(); lI != busNodes.end(); lI++) {
+		currentNodes.push_back(*lI);
+	}
+}
@@ -7,19 +7,15 @@
 
 #define yy_create_buffer vlog__create_buffer
 #define yy_delete_buffer vlog__delete_buffer
-#define yy_flex_debug vlog__flex_debug
 #define yy_init_buffer vlog__init_buffer
 #define yy_flush_buffer vlog__flush_buffer
 #define yy_load_buffer_state vlog__load_buffer_state
 #define yy_switch_to_buffer vlog__switch_to_buffer
-#define yyin vlog_in
-#define yyleng vlog_leng
 #define yylex vlog_lex
-#define yylineno vlog_lineno
-#define yyout vlog_out
 #define yyrestart vlog_restart
-#define yytext vlog_text
-#define yywrap vlog_wrap
+#define yylex_init vlog_lex_init
+#define yylex_init_extra vlog_lex_init_extra
+#define yylex_destroy vlog_lex_destroy
 #define yyalloc vlog_alloc
 #define yyrealloc vlog_realloc
 #define yyfree vlog_free
@@ -137,24 +133,43 @@ typedef unsigned int flex_uint32_t;
  */
 #define YY_SC_TO_UI(c) ((unsigned int) (unsigned char) c)
 
+/* An opaque pointer. */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+/* For convenience, these vars (plus the bison vars far below)
+   are macros in the reentrant scanner. */
+#define yyin yyg->yyin_r
+#define yyout yyg->yyout_r
+#define yyextra yyg->yyextra_r
+#define yyleng yyg->yyleng_r
+#define yytext yyg->yytext_r
+#define yylineno (YY_CURRENT_BUFFER_LVALUE->yy_bs_lineno)
+#define yycolumn (YY_CURRENT_BUFFER_LVALUE->yy_bs_column)
+#define yy_flex_debug yyg->yy_flex_debug_r
+
+int vlog_lex_init (yyscan_t* scanner);
+
 /* Enter a start condition.  This macro really ought to take a parameter,
  * but we do it the disgusting crufty way forced on us by the ()-less
  * definition of BEGIN.
  */
-#define BEGIN (yy_start) = 1 + 2 *
+#define BEGIN yyg->yy_start = 1 + 2 *
 
 /* Translate the current start state into a value that can be later handed
  * to BEGIN to return to the state.  The YYSTATE alias is for lex
  * compatibility.
  */
-#define YY_START (((yy_start) - 1) / 2)
+#define YY_START ((yyg->yy_start - 1) / 2)
 #define YYSTATE YY_START
 
 /* Action number for EOF rule of a given start state. */
 #define YY_STATE_EOF(state) (YY_END_OF_BUFFER + state + 1)
 
 /* Special action meaning "start processing a new file". */
-#define YY_NEW_FILE vlog_restart(vlog_in  )
+#define YY_NEW_FILE vlog_restart(yyin ,yyscanner )
 
 #define YY_END_OF_BUFFER_CHAR 0
 
@@ -180,10 +195,6 @@ typedef unsigned int flex_uint32_t;
 typedef struct yy_buffer_state *YY_BUFFER_STATE;
 #endif
 
-extern int vlog_leng;
-
-extern FILE *vlog_in, *vlog_out;
-
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
 #define EOB_ACT_LAST_MATCH 2
@@ -194,17 +205,17 @@ extern FILE *vlog_in, *vlog_out;
 #define yyless(n) \
 	do \
 		{ \
-		/* Undo effects of setting up vlog_text. */ \
+		/* Undo effects of setting up yytext. */ \
         int yyless_macro_arg = (n); \
         YY_LESS_LINENO(yyless_macro_arg);\
-		*yy_cp = (yy_hold_char); \
+		*yy_cp = yyg->yy_hold_char; \
 		YY_RESTORE_YY_MORE_OFFSET \
-		(yy_c_buf_p) = yy_cp = yy_bp + yyless_macro_arg - YY_MORE_ADJ; \
-		YY_DO_BEFORE_ACTION; /* set up vlog_text again */ \
+		yyg->yy_c_buf_p = yy_cp = yy_bp + yyless_macro_arg - YY_MORE_ADJ; \
+		YY_DO_BEFORE_ACTION; /* set up yytext again */ \
 		} \
 	while ( 0 )
 
-#define unput(c) yyunput( c, (yytext_ptr)  )
+#define unput(c) yyunput( c, yyg->yytext_ptr , yyscanner )
 
 #ifndef YY_TYPEDEF_YY_SIZE_T
 #define YY_TYPEDEF_YY_SIZE_T
@@ -269,78 +280,58 @@ struct yy_buffer_state
 	 *
 	 * When we actually see the EOF, we change the status to "new"
 	 * (via vlog_restart()), so that the user can continue scanning by
-	 * just pointing vlog_in at a new input file.
+	 * just pointing yyin at a new input file.
 	 */
 #define YY_BUFFER_EOF_PENDING 2
 
 	};
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
-/* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
-
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
  * "scanner state".
  *
  * Returns the top of the stack, or NULL.
  */
-#define YY_CURRENT_BUFFER ( (yy_buffer_stack) \
-                          ? (yy_buffer_stack)[(yy_buffer_stack_top)] \
+#define YY_CURRENT_BUFFER ( yyg->yy_buffer_stack \
+                          ? yyg->yy_buffer_stack[yyg->yy_buffer_stack_top] \
                           : NULL)
 
 /* Same as previous macro, but useful when we know that the buffer stack is not
  * NULL or when we need an lvalue. For internal use only.
  */
-#define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
+#define YY_CURRENT_BUFFER_LVALUE yyg->yy_buffer_stack[yyg->yy_buffer_stack_top]
 
-/* yy_hold_char holds the character lost when vlog_text is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int vlog_leng;
+void vlog_restart (FILE *input_file ,yyscan_t yyscanner );
+void vlog__switch_to_buffer (YY_BUFFER_STATE new_buffer ,yyscan_t yyscanner );
+YY_BUFFER_STATE vlog__create_buffer (FILE *file,int size ,yyscan_t yyscanner );
+void vlog__delete_buffer (YY_BUFFER_STATE b ,yyscan_t yyscanner );
+void vlog__flush_buffer (YY_BUFFER_STATE b ,yyscan_t yyscanner );
+void vlog_push_buffer_state (YY_BUFFER_STATE new_buffer ,yyscan_t yyscanner );
+void vlog_pop_buffer_state (yyscan_t yyscanner );
 
-/* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
-
-/* Flag which is used to allow vlog_wrap()'s to do buffer switches
- * instead of setting up a fresh vlog_in.  A bit of a hack ...
- */
-static int yy_did_buffer_switch_on_eof;
+static void vlog_ensure_buffer_stack (yyscan_t yyscanner );
+static void vlog__load_buffer_state (yyscan_t yyscanner );
+static void vlog__init_buffer (YY_BUFFER_STATE b,FILE *file ,yyscan_t yyscanner );
 
-void vlog_restart (FILE *input_file  );
-void vlog__switch_to_buffer (YY_BUFFER_STATE new_buffer  );
-YY_BUFFER_STATE vlog__create_buffer (FILE *file,int size  );
-void vlog__delete_buffer (YY_BUFFER_STATE b  );
-void vlog__flush_buffer (YY_BUFFER_STATE b  );
-void vlog_push_buffer_state (YY_BUFFER_STATE new_buffer  );
-void vlog_pop_buffer_state (void );
+#define YY_FLUSH_BUFFER vlog__flush_buffer(YY_CURRENT_BUFFER ,yyscanner)
 
-static void vlog_ensure_buffer_stack (void );
-static void vlog__load_buffer_state (void );
-static void vlog__init_buffer (YY_BUFFER_STATE b,FILE *file  );
+YY_BUFFER_STATE vlog__scan_buffer (char *base,yy_size_t size ,yyscan_t yyscanner );
+YY_BUFFER_STATE vlog__scan_string (yyconst char *yy_str ,yyscan_t yyscanner );
+YY_BUFFER_STATE vlog__scan_bytes (yyconst char *bytes,int len ,yyscan_t yyscanner );
 
-#define YY_FLUSH_BUFFER vlog__flush_buffer(YY_CURRENT_BUFFER )
-
-YY_BUFFER_STATE vlog__scan_buffer (char *base,yy_size_t size  );
-YY_BUFFER_STATE vlog__scan_string (yyconst char *yy_str  );
-YY_BUFFER_STATE vlog__scan_bytes (yyconst char *bytes,int len  );
-
-void *vlog_alloc (yy_size_t  );
-void *vlog_realloc (void *,yy_size_t  );
-void vlog_free (void *  );
+void *vlog_alloc (yy_size_t ,yyscan_t yyscanner );
+void *vlog_realloc (void *,yy_size_t ,yyscan_t yyscanner );
+void vlog_free (void * ,yyscan_t yyscanner );
 
 #define yy_new_buffer vlog__create_buffer
 
 #define yy_set_interactive(is_interactive) \
 	{ \
 	if ( ! YY_CURRENT_BUFFER ){ \
-        vlog_ensure_buffer_stack (); \
+        vlog_ensure_buffer_stack (yyscanner); \
 		YY_CURRENT_BUFFER_LVALUE =    \
-            vlog__create_buffer(vlog_in,YY_BUF_SIZE ); \
+            vlog__create_buffer(yyin,YY_BUF_SIZE ,yyscanner); \
 	} \
 	YY_CURRENT_BUFFER_LVALUE->yy_is_interactive = is_interactive; \
 	}
@@ -348,9 +339,9 @@ void vlog_free (void *  );
 #define yy_set_bol(at_bol) \
 	{ \
 	if ( ! YY_CURRENT_BUFFER ){\
-        vlog_ensure_buffer_stack (); \
+        vlog_ensure_buffer_stack (yyscanner); \
 		YY_CURRENT_BUFFER_LVALUE =    \
-            vlog__create_buffer(vlog_in,YY_BUF_SIZE ); \
+            vlog__create_buffer(yyin,YY_BUF_SIZE ,yyscanner); \
 	} \
 	YY_CURRENT_BUFFER_LVALUE->yy_at_bol = at_bol; \
 	}
@@ -359,18 +350,14 @@ void vlog_free (void *  );
 
 /* Begin user sect3 */
 
-typedef char YY_CHAR;
+#define vlog_wrap(n) 1
+#define YY_SKIP_YYWRAP
 
-FILE *vlog_in = (FILE *) 0, *vlog_out = (FILE *) 0;
+typedef char YY_CHAR;
 
 typedef int yy_state_type;
 
-extern int vlog_lineno;
-
-int vlog_lineno = 1;
-
-extern char *vlog_text;
-#define yytext_ptr vlog_text
+#define yytext_ptr yytext_r
 static yyconst flex_int16_t yy_nxt[][128] =
     {
     {
@@ -2139,20 +2126,20 @@ static yyconst flex_int16_t yy_nxt[][128] =
 
     } ;
 
-static yy_state_type yy_get_previous_state (void );
-static yy_state_type yy_try_NUL_trans (yy_state_type current_state  );
-static int yy_get_next_buffer (void );
-static void yy_fatal_error (yyconst char msg[]  );
+static yy_state_type yy_get_previous_state (yyscan_t yyscanner );
+static yy_state_type yy_try_NUL_trans (yy_state_type current_state  ,yyscan_t yyscanner);
+static int yy_get_next_buffer (yyscan_t yyscanner );
+static void yy_fatal_error (yyconst char msg[] ,yyscan_t yyscanner );
 
 /* Done after the current pattern has been matched and before the
- * corresponding action - sets up vlog_text.
+ * corresponding action - sets up yytext.
  */
 #define YY_DO_BEFORE_ACTION \
-	(yytext_ptr) = yy_bp; \
-	vlog_leng = (size_t) (yy_cp - yy_bp); \
-	(yy_hold_char) = *yy_cp; \
+	yyg->yytext_ptr = yy_bp; \
+	yyleng = (size_t) (yy_cp - yy_bp); \
+	yyg->yy_hold_char = *yy_cp; \
 	*yy_cp = '\0'; \
-	(yy_c_buf_p) = yy_cp;
+	yyg->yy_c_buf_p = yy_cp;
 
 #define YY_NUM_RULES 27
 #define YY_END_OF_BUFFER 28
@@ -2179,9 +2166,6 @@ static yyconst flex_int16_t yy_accept[102] =
        10
     } ;
 
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
-
 static yyconst yy_state_type yy_NUL_trans[102] =
     {   0,
         8,    8,   28,   28,   31,   31,    0,    0,    0,    0,
@@ -2198,9 +2182,6 @@ static yyconst yy_state_type yy_NUL_trans[102] =
         0
     } ;
 
-extern int vlog__flex_debug;
-int vlog__flex_debug = 0;
-
 /* The intent behind this definition is that it'll catch
  * any uses of REJECT which flex missed.
  */
@@ -2208,7 +2189,6 @@ int vlog__flex_debug = 0;
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *vlog_text;
 #line 1 "verilog.lpp"
 #line 3 "verilog.lpp"
 /*
@@ -2220,13 +2200,11 @@ char *vlog_text;
 #include <stdio.h>
 #include <strings.h>
 #include "hcm.h"
+#include "hcmVerilogIR.h"
 #include "verilog.tab.hpp"
-extern YYSTYPE vlog_lval;
-//int vlog_lineno=1;
 
-
-
-#line 2230 "lex.vlog_.c"
+#define YY_NO_INPUT 1
+#line 2208 "lex.vlog_.c"
 
 #define INITIAL 0
 #define CMT 1
@@ -2240,40 +2218,86 @@ extern YYSTYPE vlog_lval;
 #include <unistd.h>
 #endif
 
-#ifndef YY_EXTRA_TYPE
-#define YY_EXTRA_TYPE void *
-#endif
+#define YY_EXTRA_TYPE hcmParseContext*
+
+/* Holds the entire state of the reentrant scanner. */
+struct yyguts_t
+    {
+
+    /* User-defined. Not touched by flex. */
+    YY_EXTRA_TYPE yyextra_r;
+
+    /* The rest are the same as the globals declared in the non-reentrant scanner. */
+    FILE *yyin_r, *yyout_r;
+    size_t yy_buffer_stack_top; /**< index of top of stack. */
+    size_t yy_buffer_stack_max; /**< capacity of stack. */
+    YY_BUFFER_STATE * yy_buffer_stack; /**< Stack as an array. */
+    char yy_hold_char;
+    int yy_n_chars;
+    int yyleng_r;
+    char *yy_c_buf_p;
+    int yy_init;
+    int yy_start;
+    int yy_did_buffer_switch_on_eof;
+    int yy_start_stack_ptr;
+    int yy_start_stack_depth;
+    int *yy_start_stack;
+    yy_state_type yy_last_accepting_state;
+    char* yy_last_accepting_cpos;
+
+    int yylineno_r;
+    int yy_flex_debug_r;
+
+    char *yytext_r;
+    int yy_more_flag;
+    int yy_more_len;
 
-static int yy_init_globals (void );
+    YYSTYPE * yylval_r;
+
+    }; /* end struct yyguts_t */
+
+static int yy_init_globals (yyscan_t yyscanner );
+
+    /* This must go here because YYSTYPE and YYLTYPE are included
+     * from bison output in section 1.*/
+    #    define yylval yyg->yylval_r
+    
+int vlog_lex_init (yyscan_t* scanner);
+
+int vlog_lex_init_extra (YY_EXTRA_TYPE user_defined,yyscan_t* scanner);
 
 /* Accessor methods to globals.
    These are made visible to non-reentrant scanners for convenience. */
 
-int vlog_lex_destroy (void );
+int vlog_lex_destroy (yyscan_t yyscanner );
+
+int vlog_get_debug (yyscan_t yyscanner );
 
-int vlog_get_debug (void );
+void vlog_set_debug (int debug_flag ,yyscan_t yyscanner );
 
-void vlog_set_debug (int debug_flag  );
+YY_EXTRA_TYPE vlog_get_extra (yyscan_t yyscanner );
 
-YY_EXTRA_TYPE vlog_get_extra (void );
+void vlog_set_extra (YY_EXTRA_TYPE user_defined ,yyscan_t yyscanner );
 
-void vlog_set_extra (YY_EXTRA_TYPE user_defined  );
+FILE *vlog_get_in (yyscan_t yyscanner );
 
-FILE *vlog_get_in (void );
+void vlog_set_in  (FILE * in_str ,yyscan_t yyscanner );
 
-void vlog_set_in  (FILE * in_str  );
+FILE *vlog_get_out (yyscan_t yyscanner );
 
-FILE *vlog_get_out (void );
+void vlog_set_out  (FILE * out_str ,yyscan_t yyscanner );
 
-void vlog_set_out  (FILE * out_str  );
+int vlog_get_leng (yyscan_t yyscanner );
 
-int vlog_get_leng (void );
+char *vlog_get_text (yyscan_t yyscanner );
 
-char *vlog_get_text (void );
+int vlog_get_lineno (yyscan_t yyscanner );
 
-int vlog_get_lineno (void );
+void vlog_set_lineno (int line_number ,yyscan_t yyscanner );
 
-void vlog_set_lineno (int line_number  );
+YYSTYPE * vlog_get_lval (yyscan_t yyscanner );
+
+void vlog_set_lval (YYSTYPE * yylval_param ,yyscan_t yyscanner );
 
 /* Macros after this point can all be overridden by user definitions in
  * section 1.
@@ -2281,28 +2305,26 @@ void vlog_set_lineno (int line_number  );
 
 #ifndef YY_SKIP_YYWRAP
 #ifdef __cplusplus
-extern "C" int vlog_wrap (void );
+extern "C" int vlog_wrap (yyscan_t yyscanner );
 #else
-extern int vlog_wrap (void );
+extern int vlog_wrap (yyscan_t yyscanner );
 #endif
 #endif
 
-    static void yyunput (int c,char *buf_ptr  );
-    
 #ifndef yytext_ptr
-static void yy_flex_strncpy (char *,yyconst char *,int );
+static void yy_flex_strncpy (char *,yyconst char *,int ,yyscan_t yyscanner);
 #endif
 
 #ifdef YY_NEED_STRLEN
-static int yy_flex_strlen (yyconst char * );
+static int yy_flex_strlen (yyconst char * ,yyscan_t yyscanner);
 #endif
 
 #ifndef YY_NO_INPUT
 
 #ifdef __cplusplus
-static int yyinput (void );
+static int yyinput (yyscan_t yyscanner );
 #else
-static int input (void );
+static int input (yyscan_t yyscanner );
 #endif
 
 #endif
@@ -2322,7 +2344,7 @@ static int input (void );
 /* This used to be an fputs(), but since the string might contain NUL's,
  * we now use fwrite().
  */
-#define ECHO do { if (fwrite( vlog_text, vlog_leng, 1, vlog_out )) {} } while (0)
+#define ECHO do { if (fwrite( yytext, yyleng, 1, yyout )) {} } while (0)
 #endif
 
 /* Gets input and stuffs it into "buf".  number of characters read, or YY_NULL,
@@ -2331,7 +2353,7 @@ static int input (void );
 #ifndef YY_INPUT
 #define YY_INPUT(buf,result,max_size) \
 	errno=0; \
-	while ( (result = read( fileno(vlog_in), (char *) buf, max_size )) < 0 ) \
+	while ( (result = read( fileno(yyin), (char *) buf, max_size )) < 0 ) \
 	{ \
 		if( errno != EINTR) \
 		{ \
@@ -2339,7 +2361,7 @@ static int input (void );
 			break; \
 		} \
 		errno=0; \
-		clearerr(vlog_in); \
+		clearerr(yyin); \
 	}\
 \
 
@@ -2360,7 +2382,7 @@ static int input (void );
 
 /* Report a fatal error. */
 #ifndef YY_FATAL_ERROR
-#define YY_FATAL_ERROR(msg) yy_fatal_error( msg )
+#define YY_FATAL_ERROR(msg) yy_fatal_error( msg , yyscanner)
 #endif
 
 /* end tables serialization structures and prototypes */
@@ -2371,12 +2393,14 @@ static int input (void );
 #ifndef YY_DECL
 #define YY_DECL_IS_OURS 1
 
-extern int vlog_lex (void);
+extern int vlog_lex \
+               (YYSTYPE * yylval_param ,yyscan_t yyscanner);
 
-#define YY_DECL int vlog_lex (void)
+#define YY_DECL int vlog_lex \
+               (YYSTYPE * yylval_param , yyscan_t yyscanner)
 #endif /* !YY_DECL */
 
-/* Code executed at the beginning of each rule, after vlog_text and vlog_leng
+/* Code executed at the beginning of each rule, after yytext and yyleng
  * have been set up.
  */
 #ifndef YY_USER_ACTION
@@ -2398,58 +2422,61 @@ YY_DECL
 	register yy_state_type yy_current_state;
 	register char *yy_cp, *yy_bp;
 	register int yy_act;
-    
-#line 24 "verilog.lpp"
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+#line 26 "verilog.lpp"
 
 
-#line 2406 "lex.vlog_.c"
+#line 2431 "lex.vlog_.c"
 
-	if ( !(yy_init) )
+    yylval = yylval_param;
+
+	if ( !yyg->yy_init )
 		{
-		(yy_init) = 1;
+		yyg->yy_init = 1;
 
 #ifdef YY_USER_INIT
 		YY_USER_INIT;
 #endif
 
-		if ( ! (yy_start) )
-			(yy_start) = 1;	/* first start state */
+		if ( ! yyg->yy_start )
+			yyg->yy_start = 1;	/* first start state */
 
-		if ( ! vlog_in )
-			vlog_in = stdin;
+		if ( ! yyin )
+			yyin = stdin;
 
-		if ( ! vlog_out )
-			vlog_out = stdout;
+		if ( ! yyout )
+			yyout = stdout;
 
 		if ( ! YY_CURRENT_BUFFER ) {
-			vlog_ensure_buffer_stack ();
+			vlog_ensure_buffer_stack (yyscanner);
 			YY_CURRENT_BUFFER_LVALUE =
-				vlog__create_buffer(vlog_in,YY_BUF_SIZE );
+				vlog__create_buffer(yyin,YY_BUF_SIZE ,yyscanner);
 		}
 
-		vlog__load_buffer_state( );
+		vlog__load_buffer_state(yyscanner );
 		}
 
 	while ( 1 )		/* loops until end-of-file is reached */
 		{
-		yy_cp = (yy_c_buf_p);
+		yy_cp = yyg->yy_c_buf_p;
 
-		/* Support of vlog_text. */
-		*yy_cp = (yy_hold_char);
+		/* Support of yytext. */
+		*yy_cp = yyg->yy_hold_char;
 
 		/* yy_bp points to the position in yy_ch_buf of the start of
 		 * the current run.
 		 */
 		yy_bp = yy_cp;
 
-		yy_current_state = (yy_start);
+		yy_current_state = yyg->yy_start;
 yy_match:
 		while ( (yy_current_state = yy_nxt[yy_current_state][ YY_SC_TO_UI(*yy_cp) ]) > 0 )
 			{
 			if ( yy_accept[yy_current_state] )
 				{
-				(yy_last_accepting_state) = yy_current_state;
-				(yy_last_accepting_cpos) = yy_cp;
+				yyg->yy_last_accepting_state = yy_current_state;
+				yyg->yy_last_accepting_cpos = yy_cp;
 				}
 
 			++yy_cp;
@@ -2468,249 +2495,249 @@ do_action:	/* This label is used only to access EOF actions. */
 	{ /* beginning of action switch */
 			case 0: /* must back up */
 			/* undo the effects of YY_DO_BEFORE_ACTION */
-			*yy_cp = (yy_hold_char);
-			yy_cp = (yy_last_accepting_cpos) + 1;
-			yy_current_state = (yy_last_accepting_state);
+			*yy_cp = yyg->yy_hold_char;
+			yy_cp = yyg->yy_last_accepting_cpos + 1;
+			yy_current_state = yyg->yy_last_accepting_state;
 			goto yy_find_action;
 
 case 1:
 /* rule 1 can match eol */
 YY_RULE_SETUP
-#line 26 "verilog.lpp"
+#line 28 "verilog.lpp"
 {
         		#ifdef DEBUG 
 			printf("COMMENT\n");
  			#endif		
-   			vlog_lineno++;
-                        if(vlog_lineno % 10000==0) 
-                           fprintf(stderr,"Parsing Verilog file for %d lines ...    \r",vlog_lineno);   
+   			yyextra->line++;
+                        if(yyextra->line % 10000==0) 
+                           fprintf(stderr,"Parsing Verilog file for %d lines ...    \r",yyextra->line);   
                       }
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 34 "verilog.lpp"
+#line 36 "verilog.lpp"
 { BEGIN CMT;}
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 35 "verilog.lpp"
+#line 37 "verilog.lpp"
 { BEGIN INITIAL;}
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 36 "verilog.lpp"
+#line 38 "verilog.lpp"
 
 	YY_BREAK
 case 5:
 /* rule 5 can match eol */
 YY_RULE_SETUP
-#line 37 "verilog.lpp"
-{ vlog_lineno++;
-                          if(vlog_lineno % 10000==0) 
-                           fprintf(stderr,"Parsing Verilog file for %d lines ...    \r",vlog_lineno);   
+#line 39 "verilog.lpp"
+{ yyextra->line++;
+                          if(yyextra->line % 10000==0) 
+                           fprintf(stderr,"Parsing Verilog file for %d lines ...    \r",yyextra->line);   
                         }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 41 "verilog.lpp"
+#line 43 "verilog.lpp"
 { 
                         #ifdef DEBUG
- 			printf("INT=%s ",vlog_text);
+ 			printf("INT=%s ",yytext);
  			#endif
-			vlog_lval.sval=strdup(vlog_text);
+			yylval->sval=(char*)yyextra->file->newString(yytext);
                         return CONST;
                         }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 50 "verilog.lpp"
+#line 52 "verilog.lpp"
 { 
                         #ifdef DEBUG
- 			printf("INT=%s ",vlog_text);
+ 			printf("INT=%s ",yytext);
  			#endif
-			vlog_lval.ival=atol(vlog_text);
+			yylval->ival=atol(yytext);
                         return INT;
                         }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 58 "verilog.lpp"
+#line 60 "verilog.lpp"
 {
                         #ifdef DEBUG 
-                        printf("%c ",vlog_text[0]);
+                        printf("%c ",yytext[0]);
                         #endif
-			return ((int) vlog_text[0]);
+			return ((int) yytext[0]);
 			}
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 65 "verilog.lpp"
+#line 67 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("MODULE ");
 		#endif
-		vlog_lval.ival=MODULE;
+		yylval->ival=MODULE;
 		return MODULE;
 		}
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 72 "verilog.lpp"
+#line 74 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("ENDMODULE ");
 		#endif
-		vlog_lval.ival=ENDMODULE;
+		yylval->ival=ENDMODULE;
 		return ENDMODULE;
 		}
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 79 "verilog.lpp"
+#line 81 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("WIRE ");
 		#endif
-		vlog_lval.ival=WIRE;
+		yylval->ival=WIRE;
 		return WIRE;
 		}
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 86 "verilog.lpp"
+#line 88 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("WAND ");
 		#endif
-		vlog_lval.ival=WAND;
+		yylval->ival=WAND;
 		return WAND;
 		}
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 93 "verilog.lpp"
+#line 95 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("WOR ");
 		#endif
-		vlog_lval.ival=WOR;
+		yylval->ival=WOR;
 		return WOR;
 		}
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 100 "verilog.lpp"
+#line 102 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("TRI ");
 		#endif
-		vlog_lval.ival=TRI;
+		yylval->ival=TRI;
 		return TRI;
 		}
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 108 "verilog.lpp"
+#line 110 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("REG ");
 		#endif
-		vlog_lval.ival=REG;
+		yylval->ival=REG;
 		return REG;
 		}
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 115 "verilog.lpp"
+#line 117 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("TRIREG ");
 		#endif
-		vlog_lval.ival=TRIREG;
+		yylval->ival=TRIREG;
 		return TRIREG;
 		}
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 122 "verilog.lpp"
+#line 124 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("INPUT ");
 		#endif
-		vlog_lval.ival=INPUT;
+		yylval->ival=INPUT;
 		return INPUT;
 		}
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 129 "verilog.lpp"
+#line 131 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("OUTPUT ");
 		#endif
-		vlog_lval.ival=OUTPUT;
+		yylval->ival=OUTPUT;
 		return OUTPUT;
 		}
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 136 "verilog.lpp"
+#line 138 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("INOUT ");
 		#endif
-		vlog_lval.ival=INOUT;
+		yylval->ival=INOUT;
 		return INOUT;
 		}
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 143 "verilog.lpp"
+#line 145 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("SUPPLY1 ");
 		#endif
-		vlog_lval.ival=SUPPLY1;
+		yylval->ival=SUPPLY1;
 		return SUPPLY1;
 		}
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 150 "verilog.lpp"
+#line 152 "verilog.lpp"
 {
 		#ifdef DEBUG
 		printf("SUPPLY0 ");
 		#endif
-		vlog_lval.ival=SUPPLY0;
+		yylval->ival=SUPPLY0;
 		return SUPPLY0;
 		}
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 157 "verilog.lpp"
+#line 159 "verilog.lpp"
 {
-		vlog_lval.ival=_ASSIGN;
+		yylval->ival=_ASSIGN;
 		return _ASSIGN;
 		}
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 162 "verilog.lpp"
+#line 164 "verilog.lpp"
 {
-		vlog_lval.ival=BUF;
+		yylval->ival=BUF;
 		return BUF;
 		}
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 167 "verilog.lpp"
+#line 169 "verilog.lpp"
 {
-                        if(vlog_text[0] == '\\')
-                           vlog_lval.sval = (char*)new_string(vlog_text+1);
+                        if(yytext[0] == '\\')
+                           yylval->sval = (char*)yyextra->file->newString(yytext+1);
                         else
-                           vlog_lval.sval = (char*)new_string(vlog_text);
+                           yylval->sval = (char*)yyextra->file->newString(yytext);
             		#ifdef DEBUG
- 			printf("ID=%s ",vlog_lval.sval);
+ 			printf("ID=%s ",yylval->sval);
 			#endif
 			return (ID);
 			}
@@ -2718,24 +2745,24 @@ YY_RULE_SETUP
 case 25:
 /* rule 25 can match eol */
 YY_RULE_SETUP
-#line 178 "verilog.lpp"
+#line 180 "verilog.lpp"
 {
-                           vlog_lineno++;
-                           if(vlog_lineno % 10000==0) 
-                              fprintf(stderr,"Parsing Verilog file for %d lines ...    \r",vlog_lineno);   
+                           yyextra->line++;
+                           if(yyextra->line % 10000==0) 
+                              fprintf(stderr,"Parsing Verilog file for %d lines ...    \r",yyextra->line);   
                         }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 183 "verilog.lpp"
+#line 185 "verilog.lpp"
 ;
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 185 "verilog.lpp"
+#line 187 "verilog.lpp"
 ECHO;
 	YY_BREAK
-#line 2739 "lex.vlog_.c"
+#line 2766 "lex.vlog_.c"
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(CMT):
 case YY_STATE_EOF(PROP):
@@ -2744,25 +2771,25 @@ case YY_STATE_EOF(PROP):
 	case YY_END_OF_BUFFER:
 		{
 		/* Amount of text matched not including the EOB char. */
-		int yy_amount_of_matched_text = (int) (yy_cp - (yytext_ptr)) - 1;
+		int yy_amount_of_matched_text = (int) (yy_cp - yyg->yytext_ptr) - 1;
 
 		/* Undo the effects of YY_DO_BEFORE_ACTION. */
-		*yy_cp = (yy_hold_char);
+		*yy_cp = yyg->yy_hold_char;
 		YY_RESTORE_YY_MORE_OFFSET
 
 		if ( YY_CURRENT_BUFFER_LVALUE->yy_buffer_status == YY_BUFFER_NEW )
 			{
 			/* We're scanning a new file or input source.  It's
 			 * possible that this happened because the user
-			 * just pointed vlog_in at a new source and called
+			 * just pointed yyin at a new source and called
 			 * vlog_lex().  If so, then we have to assure
 			 * consistency between YY_CURRENT_BUFFER and our
 			 * globals.  Here is the right place to do so, because
 			 * this is the first action (other than possibly a
 			 * back-up) that will match for the new input source.
 			 */
-			(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
-			YY_CURRENT_BUFFER_LVALUE->yy_input_file = vlog_in;
+			yyg->yy_n_chars = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
+			YY_CURRENT_BUFFER_LVALUE->yy_input_file = yyin;
 			YY_CURRENT_BUFFER_LVALUE->yy_buffer_status = YY_BUFFER_NORMAL;
 			}
 
@@ -2773,13 +2800,13 @@ case YY_STATE_EOF(PROP):
 		 * end-of-buffer state).  Contrast this with the test
 		 * in input().
 		 */
-		if ( (yy_c_buf_p) <= &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
+		if ( yyg->yy_c_buf_p <= &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] )
 			{ /* This was really a NUL. */
 			yy_state_type yy_next_state;
 
-			(yy_c_buf_p) = (yytext_ptr) + yy_amount_of_matched_text;
+			yyg->yy_c_buf_p = yyg->yytext_ptr + yy_amount_of_matched_text;
 
-			yy_current_state = yy_get_previous_state(  );
+			yy_current_state = yy_get_previous_state( yyscanner );
 
 			/* Okay, we're now positioned to make the NUL
 			 * transition.  We couldn't have
@@ -2790,43 +2817,43 @@ case YY_STATE_EOF(PROP):
 			 * will run more slowly).
 			 */
 
-			yy_next_state = yy_try_NUL_trans( yy_current_state );
+			yy_next_state = yy_try_NUL_trans( yy_current_state , yyscanner);
 
-			yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+			yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 
 			if ( yy_next_state )
 				{
 				/* Consume the NUL. */
-				yy_cp = ++(yy_c_buf_p);
+				yy_cp = ++yyg->yy_c_buf_p;
 				yy_current_state = yy_next_state;
 				goto yy_match;
 				}
 
 			else
 				{
-				yy_cp = (yy_c_buf_p);
+				yy_cp = yyg->yy_c_buf_p;
 				goto yy_find_action;
 				}
 			}
 
-		else switch ( yy_get_next_buffer(  ) )
+		else switch ( yy_get_next_buffer( yyscanner ) )
 			{
 			case EOB_ACT_END_OF_FILE:
 				{
-				(yy_did_buffer_switch_on_eof) = 0;
+				yyg->yy_did_buffer_switch_on_eof = 0;
 
-				if ( vlog_wrap( ) )
+				if ( vlog_wrap(yyscanner ) )
 					{
 					/* Note: because we've taken care in
 					 * yy_get_next_buffer() to have set up
-					 * vlog_text, we can now set up
+					 * yytext, we can now set up
 					 * yy_c_buf_p so that if some total
 					 * hoser (like flex itself) wants to
 					 * call the scanner after we return the
 					 * YY_NULL, it'll still work - another
 					 * YY_NULL will get returned.
 					 */
-					(yy_c_buf_p) = (yytext_ptr) + YY_MORE_ADJ;
+					yyg->yy_c_buf_p = yyg->yytext_ptr + YY_MORE_ADJ;
 
 					yy_act = YY_STATE_EOF(YY_START);
 					goto do_action;
@@ -2834,30 +2861,30 @@ case YY_STATE_EOF(PROP):
 
 				else
 					{
-					if ( ! (yy_did_buffer_switch_on_eof) )
+					if ( ! yyg->yy_did_buffer_switch_on_eof )
 						YY_NEW_FILE;
 					}
 				break;
 				}
 
 			case EOB_ACT_CONTINUE_SCAN:
-				(yy_c_buf_p) =
-					(yytext_ptr) + yy_amount_of_matched_text;
+				yyg->yy_c_buf_p =
+					yyg->yytext_ptr + yy_amount_of_matched_text;
 
-				yy_current_state = yy_get_previous_state(  );
+				yy_current_state = yy_get_previous_state( yyscanner );
 
-				yy_cp = (yy_c_buf_p);
-				yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+				yy_cp = yyg->yy_c_buf_p;
+				yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 				goto yy_match;
 
 			case EOB_ACT_LAST_MATCH:
-				(yy_c_buf_p) =
-				&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)];
+				yyg->yy_c_buf_p =
+				&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars];
 
-				yy_current_state = yy_get_previous_state(  );
+				yy_current_state = yy_get_previous_state( yyscanner );
 
-				yy_cp = (yy_c_buf_p);
-				yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+				yy_cp = yyg->yy_c_buf_p;
+				yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 				goto yy_find_action;
 			}
 		break;
@@ -2877,20 +2904,21 @@ case YY_STATE_EOF(PROP):
  *	EOB_ACT_CONTINUE_SCAN - continue scanning from current position
  *	EOB_ACT_END_OF_FILE - end of file
  */
-static int yy_get_next_buffer (void)
+static int yy_get_next_buffer (yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
     	register char *dest = YY_CURRENT_BUFFER_LVALUE->yy_ch_buf;
-	register char *source = (yytext_ptr);
+	register char *source = yyg->yytext_ptr;
 	register int number_to_move, i;
 	int ret_val;
 
-	if ( (yy_c_buf_p) > &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] )
+	if ( yyg->yy_c_buf_p > &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars + 1] )
 		YY_FATAL_ERROR(
 		"fatal flex scanner internal error--end of buffer missed" );
 
 	if ( YY_CURRENT_BUFFER_LVALUE->yy_fill_buffer == 0 )
 		{ /* Don't try to fill the buffer, so this is an EOF. */
-		if ( (yy_c_buf_p) - (yytext_ptr) - YY_MORE_ADJ == 1 )
+		if ( yyg->yy_c_buf_p - yyg->yytext_ptr - YY_MORE_ADJ == 1 )
 			{
 			/* We matched a single character, the EOB, so
 			 * treat this as a final EOF.
@@ -2910,7 +2938,7 @@ static int yy_get_next_buffer (void)
 	/* Try to read more data. */
 
 	/* First move last chars to start of buffer. */
-	number_to_move = (int) ((yy_c_buf_p) - (yytext_ptr)) - 1;
+	number_to_move = (int) (yyg->yy_c_buf_p - yyg->yytext_ptr) - 1;
 
 	for ( i = 0; i < number_to_move; ++i )
 		*(dest++) = *(source++);
@@ -2919,7 +2947,7 @@ static int yy_get_next_buffer (void)
 		/* don't do the read, it's not guaranteed to return an EOF,
 		 * just force an EOF
 		 */
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars) = 0;
+		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars = 0;
 
 	else
 		{
@@ -2933,7 +2961,7 @@ static int yy_get_next_buffer (void)
 			YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
 
 			int yy_c_buf_p_offset =
-				(int) ((yy_c_buf_p) - b->yy_ch_buf);
+				(int) (yyg->yy_c_buf_p - b->yy_ch_buf);
 
 			if ( b->yy_is_our_buffer )
 				{
@@ -2946,7 +2974,7 @@ static int yy_get_next_buffer (void)
 
 				b->yy_ch_buf = (char *)
 					/* Include room in for 2 EOB chars. */
-					vlog_realloc((void *) b->yy_ch_buf,b->yy_buf_size + 2  );
+					vlog_realloc((void *) b->yy_ch_buf,b->yy_buf_size + 2 ,yyscanner );
 				}
 			else
 				/* Can't grow it, we don't own it. */
@@ -2956,7 +2984,7 @@ static int yy_get_next_buffer (void)
 				YY_FATAL_ERROR(
 				"fatal error - scanner input buffer overflow" );
 
-			(yy_c_buf_p) = &b->yy_ch_buf[yy_c_buf_p_offset];
+			yyg->yy_c_buf_p = &b->yy_ch_buf[yy_c_buf_p_offset];
 
 			num_to_read = YY_CURRENT_BUFFER_LVALUE->yy_buf_size -
 						number_to_move - 1;
@@ -2968,17 +2996,17 @@ static int yy_get_next_buffer (void)
 
 		/* Read in more data. */
 		YY_INPUT( (&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[number_to_move]),
-			(yy_n_chars), (size_t) num_to_read );
+			yyg->yy_n_chars, (size_t) num_to_read );
 
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
 		}
 
-	if ( (yy_n_chars) == 0 )
+	if ( yyg->yy_n_chars == 0 )
 		{
 		if ( number_to_move == YY_MORE_ADJ )
 			{
 			ret_val = EOB_ACT_END_OF_FILE;
-			vlog_restart(vlog_in  );
+			vlog_restart(yyin  ,yyscanner);
 			}
 
 		else
@@ -2992,33 +3020,34 @@ static int yy_get_next_buffer (void)
 	else
 		ret_val = EOB_ACT_CONTINUE_SCAN;
 
-	if ((yy_size_t) ((yy_n_chars) + number_to_move) > YY_CURRENT_BUFFER_LVALUE->yy_buf_size) {
+	if ((yy_size_t) (yyg->yy_n_chars + number_to_move) > YY_CURRENT_BUFFER_LVALUE->yy_buf_size) {
 		/* Extend the array by 50%, plus the number we really need. */
-		yy_size_t new_size = (yy_n_chars) + number_to_move + ((yy_n_chars) >> 1);
-		YY_CURRENT_BUFFER_LVALUE->yy_ch_buf = (char *) vlog_realloc((void *) YY_CURRENT_BUFFER_LVALUE->yy_ch_buf,new_size  );
+		yy_size_t new_size = yyg->yy_n_chars + number_to_move + (yyg->yy_n_chars >> 1);
+		YY_CURRENT_BUFFER_LVALUE->yy_ch_buf = (char *) vlog_realloc((void *) YY_CURRENT_BUFFER_LVALUE->yy_ch_buf,new_size ,yyscanner );
 		if ( ! YY_CURRENT_BUFFER_LVALUE->yy_ch_buf )
 			YY_FATAL_ERROR( "out of dynamic memory in yy_get_next_buffer()" );
 	}
 
-	(yy_n_chars) += number_to_move;
-	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] = YY_END_OF_BUFFER_CHAR;
-	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] = YY_END_OF_BUFFER_CHAR;
+	yyg->yy_n_chars += number_to_move;
+	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] = YY_END_OF_BUFFER_CHAR;
+	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
 
-	(yytext_ptr) = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[0];
+	yyg->yytext_ptr = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[0];
 
 	return ret_val;
 }
 
 /* yy_get_previous_state - get the state just before the EOB char was reached */
 
-    static yy_state_type yy_get_previous_state (void)
+    static yy_state_type yy_get_previous_state (yyscan_t yyscanner)
 {
 	register yy_state_type yy_current_state;
 	register char *yy_cp;
-    
-	yy_current_state = (yy_start);
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	yy_current_state = yyg->yy_start;
 
-	for ( yy_cp = (yytext_ptr) + YY_MORE_ADJ; yy_cp < (yy_c_buf_p); ++yy_cp )
+	for ( yy_cp = yyg->yytext_ptr + YY_MORE_ADJ; yy_cp < yyg->yy_c_buf_p; ++yy_cp )
 		{
 		if ( *yy_cp )
 			{
@@ -3028,8 +3057,8 @@ static int yy_get_next_buffer (void)
 			yy_current_state = yy_NUL_trans[yy_current_state];
 		if ( yy_accept[yy_current_state] )
 			{
-			(yy_last_accepting_state) = yy_current_state;
-			(yy_last_accepting_cpos) = yy_cp;
+			yyg->yy_last_accepting_state = yy_current_state;
+			yyg->yy_last_accepting_cpos = yy_cp;
 			}
 		}
 
@@ -3041,10 +3070,11 @@ static int yy_get_next_buffer (void)
  * synopsis
  *	next_state = yy_try_NUL_trans( current_state );
  */
-    static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state )
+    static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state , yyscan_t yyscanner)
 {
 	register int yy_is_jam;
-    	register char *yy_cp = (yy_c_buf_p);
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner; /* This var may be unused depending upon options. */
+	register char *yy_cp = yyg->yy_c_buf_p;
 
 	yy_current_state = yy_NUL_trans[yy_current_state];
 	yy_is_jam = (yy_current_state == 0);
@@ -3053,79 +3083,43 @@ static int yy_get_next_buffer (void)
 		{
 		if ( yy_accept[yy_current_state] )
 			{
-			(yy_last_accepting_state) = yy_current_state;
-			(yy_last_accepting_cpos) = yy_cp;
+			yyg->yy_last_accepting_state = yy_current_state;
+			yyg->yy_last_accepting_cpos = yy_cp;
 			}
 		}
 
 	return yy_is_jam ? 0 : yy_current_state;
 }
 
-    static void yyunput (int c, register char * yy_bp )
-{
-	register char *yy_cp;
-    
-    yy_cp = (yy_c_buf_p);
-
-	/* undo effects of setting up vlog_text */
-	*yy_cp = (yy_hold_char);
-
-	if ( yy_cp < YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + 2 )
-		{ /* need to shift things up to make room */
-		/* +2 for EOB chars. */
-		register int number_to_move = (yy_n_chars) + 2;
-		register char *dest = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[
-					YY_CURRENT_BUFFER_LVALUE->yy_buf_size + 2];
-		register char *source =
-				&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[number_to_move];
-
-		while ( source > YY_CURRENT_BUFFER_LVALUE->yy_ch_buf )
-			*--dest = *--source;
-
-		yy_cp += (int) (dest - source);
-		yy_bp += (int) (dest - source);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars =
-			(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_buf_size;
-
-		if ( yy_cp < YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + 2 )
-			YY_FATAL_ERROR( "flex scanner push-back overflow" );
-		}
-
-	*--yy_cp = (char) c;
-
-	(yytext_ptr) = yy_bp;
-	(yy_hold_char) = *yy_cp;
-	(yy_c_buf_p) = yy_cp;
-}
-
 #ifndef YY_NO_INPUT
 #ifdef __cplusplus
-    static int yyinput (void)
+    static int yyinput (yyscan_t yyscanner)
 #else
-    static int input  (void)
+    static int input  (yyscan_t yyscanner)
 #endif
 
 {
 	int c;
-    
-	*(yy_c_buf_p) = (yy_hold_char);
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
-	if ( *(yy_c_buf_p) == YY_END_OF_BUFFER_CHAR )
+	*yyg->yy_c_buf_p = yyg->yy_hold_char;
+
+	if ( *yyg->yy_c_buf_p == YY_END_OF_BUFFER_CHAR )
 		{
 		/* yy_c_buf_p now points to the character we want to return.
 		 * If this occurs *before* the EOB characters, then it's a
 		 * valid NUL; if not, then we've hit the end of the buffer.
 		 */
-		if ( (yy_c_buf_p) < &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
+		if ( yyg->yy_c_buf_p < &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] )
 			/* This was really a NUL. */
-			*(yy_c_buf_p) = '\0';
+			*yyg->yy_c_buf_p = '\0';
 
 		else
 			{ /* need more input */
-			int offset = (yy_c_buf_p) - (yytext_ptr);
-			++(yy_c_buf_p);
+			int offset = yyg->yy_c_buf_p - yyg->yytext_ptr;
+			++yyg->yy_c_buf_p;
 
-			switch ( yy_get_next_buffer(  ) )
+			switch ( yy_get_next_buffer( yyscanner ) )
 				{
 				case EOB_ACT_LAST_MATCH:
 					/* This happens because yy_g_n_b()
@@ -3139,34 +3133,34 @@ static int yy_get_next_buffer (void)
 					 */
 
 					/* Reset buffer status. */
-					vlog_restart(vlog_in );
+					vlog_restart(yyin ,yyscanner);
 
 					/*FALLTHROUGH*/
 
 				case EOB_ACT_END_OF_FILE:
 					{
-					if ( vlog_wrap( ) )
+					if ( vlog_wrap(yyscanner ) )
 						return EOF;
 
-					if ( ! (yy_did_buffer_switch_on_eof) )
+					if ( ! yyg->yy_did_buffer_switch_on_eof )
 						YY_NEW_FILE;
 #ifdef __cplusplus
-					return yyinput();
+					return yyinput(yyscanner);
 #else
-					return input();
+					return input(yyscanner);
 #endif
 					}
 
 				case EOB_ACT_CONTINUE_SCAN:
-					(yy_c_buf_p) = (yytext_ptr) + offset;
+					yyg->yy_c_buf_p = yyg->yytext_ptr + offset;
 					break;
 				}
 			}
 		}
 
-	c = *(unsigned char *) (yy_c_buf_p);	/* cast for 8-bit char's */
-	*(yy_c_buf_p) = '\0';	/* preserve vlog_text */
-	(yy_hold_char) = *++(yy_c_buf_p);
+	c = *(unsigned char *) yyg->yy_c_buf_p;	/* cast for 8-bit char's */
+	*yyg->yy_c_buf_p = '\0';	/* preserve yytext */
+	yyg->yy_hold_char = *++yyg->yy_c_buf_p;
 
 	return c;
 }
@@ -3174,76 +3168,79 @@ static int yy_get_next_buffer (void)
 
 /** Immediately switch to a different input stream.
  * @param input_file A readable stream.
- * 
+ * @param yyscanner The scanner object.
  * @note This function does not reset the start condition to @c INITIAL .
  */
-    void vlog_restart  (FILE * input_file )
+    void vlog_restart  (FILE * input_file , yyscan_t yyscanner)
 {
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
 	if ( ! YY_CURRENT_BUFFER ){
-        vlog_ensure_buffer_stack ();
+        vlog_ensure_buffer_stack (yyscanner);
 		YY_CURRENT_BUFFER_LVALUE =
-            vlog__create_buffer(vlog_in,YY_BUF_SIZE );
+            vlog__create_buffer(yyin,YY_BUF_SIZE ,yyscanner);
 	}
 
-	vlog__init_buffer(YY_CURRENT_BUFFER,input_file );
-	vlog__load_buffer_state( );
+	vlog__init_buffer(YY_CURRENT_BUFFER,input_file ,yyscanner);
+	vlog__load_buffer_state(yyscanner );
 }
 
 /** Switch to a different input buffer.
  * @param new_buffer The new input buffer.
- * 
+ * @param yyscanner The scanner object.
  */
-    void vlog__switch_to_buffer  (YY_BUFFER_STATE  new_buffer )
+    void vlog__switch_to_buffer  (YY_BUFFER_STATE  new_buffer , yyscan_t yyscanner)
 {
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
 	/* TODO. We should be able to replace this entire function body
 	 * with
 	 *		vlog_pop_buffer_state();
 	 *		vlog_push_buffer_state(new_buffer);
      */
-	vlog_ensure_buffer_stack ();
+	vlog_ensure_buffer_stack (yyscanner);
 	if ( YY_CURRENT_BUFFER == new_buffer )
 		return;
 
 	if ( YY_CURRENT_BUFFER )
 		{
 		/* Flush out information for old buffer. */
-		*(yy_c_buf_p) = (yy_hold_char);
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+		*yyg->yy_c_buf_p = yyg->yy_hold_char;
+		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = yyg->yy_c_buf_p;
+		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
 		}
 
 	YY_CURRENT_BUFFER_LVALUE = new_buffer;
-	vlog__load_buffer_state( );
+	vlog__load_buffer_state(yyscanner );
 
 	/* We don't actually know whether we did this switch during
 	 * EOF (vlog_wrap()) processing, but the only time this flag
 	 * is looked at is after vlog_wrap() is called, so it's safe
 	 * to go ahead and always set it.
 	 */
-	(yy_did_buffer_switch_on_eof) = 1;
+	yyg->yy_did_buffer_switch_on_eof = 1;
 }
 
-static void vlog__load_buffer_state  (void)
+static void vlog__load_buffer_state  (yyscan_t yyscanner)
 {
-    	(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
-	(yytext_ptr) = (yy_c_buf_p) = YY_CURRENT_BUFFER_LVALUE->yy_buf_pos;
-	vlog_in = YY_CURRENT_BUFFER_LVALUE->yy_input_file;
-	(yy_hold_char) = *(yy_c_buf_p);
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yyg->yy_n_chars = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
+	yyg->yytext_ptr = yyg->yy_c_buf_p = YY_CURRENT_BUFFER_LVALUE->yy_buf_pos;
+	yyin = YY_CURRENT_BUFFER_LVALUE->yy_input_file;
+	yyg->yy_hold_char = *yyg->yy_c_buf_p;
 }
 
 /** Allocate and initialize an input buffer state.
  * @param file A readable stream.
  * @param size The character buffer size in bytes. When in doubt, use @c YY_BUF_SIZE.
- * 
+ * @param yyscanner The scanner object.
  * @return the allocated buffer state.
  */
-    YY_BUFFER_STATE vlog__create_buffer  (FILE * file, int  size )
+    YY_BUFFER_STATE vlog__create_buffer  (FILE * file, int  size , yyscan_t yyscanner)
 {
 	YY_BUFFER_STATE b;
     
-	b = (YY_BUFFER_STATE) vlog_alloc(sizeof( struct yy_buffer_state )  );
+	b = (YY_BUFFER_STATE) vlog_alloc(sizeof( struct yy_buffer_state ) ,yyscanner );
 	if ( ! b )
 		YY_FATAL_ERROR( "out of dynamic memory in vlog__create_buffer()" );
 
@@ -3252,24 +3249,25 @@ static void vlog__load_buffer_state  (void)
 	/* yy_ch_buf has to be 2 characters longer than the size given because
 	 * we need to put in 2 end-of-buffer characters.
 	 */
-	b->yy_ch_buf = (char *) vlog_alloc(b->yy_buf_size + 2  );
+	b->yy_ch_buf = (char *) vlog_alloc(b->yy_buf_size + 2 ,yyscanner );
 	if ( ! b->yy_ch_buf )
 		YY_FATAL_ERROR( "out of dynamic memory in vlog__create_buffer()" );
 
 	b->yy_is_our_buffer = 1;
 
-	vlog__init_buffer(b,file );
+	vlog__init_buffer(b,file ,yyscanner);
 
 	return b;
 }
 
 /** Destroy the buffer.
  * @param b a buffer created with vlog__create_buffer()
- * 
+ * @param yyscanner The scanner object.
  */
-    void vlog__delete_buffer (YY_BUFFER_STATE  b )
+    void vlog__delete_buffer (YY_BUFFER_STATE  b , yyscan_t yyscanner)
 {
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
 	if ( ! b )
 		return;
 
@@ -3277,9 +3275,9 @@ static void vlog__load_buffer_state  (void)
 		YY_CURRENT_BUFFER_LVALUE = (YY_BUFFER_STATE) 0;
 
 	if ( b->yy_is_our_buffer )
-		vlog_free((void *) b->yy_ch_buf  );
+		vlog_free((void *) b->yy_ch_buf ,yyscanner );
 
-	vlog_free((void *) b  );
+	vlog_free((void *) b ,yyscanner );
 }
 
 #ifndef __cplusplus
@@ -3290,12 +3288,13 @@ extern int isatty (int );
  * This function is sometimes called more than once on the same buffer,
  * such as during a vlog_restart() or at EOF.
  */
-    static void vlog__init_buffer  (YY_BUFFER_STATE  b, FILE * file )
+    static void vlog__init_buffer  (YY_BUFFER_STATE  b, FILE * file , yyscan_t yyscanner)
 
 {
 	int oerrno = errno;
-    
-	vlog__flush_buffer(b );
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	vlog__flush_buffer(b ,yyscanner);
 
 	b->yy_input_file = file;
 	b->yy_fill_buffer = 1;
@@ -3316,11 +3315,12 @@ extern int isatty (int );
 
 /** Discard all buffered characters. On the next scan, YY_INPUT will be called.
  * @param b the buffer state to be flushed, usually @c YY_CURRENT_BUFFER.
- * 
+ * @param yyscanner The scanner object.
  */
-    void vlog__flush_buffer (YY_BUFFER_STATE  b )
+    void vlog__flush_buffer (YY_BUFFER_STATE  b , yyscan_t yyscanner)
 {
-    	if ( ! b )
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if ( ! b )
 		return;
 
 	b->yy_n_chars = 0;
@@ -3338,114 +3338,117 @@ extern int isatty (int );
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
 	if ( b == YY_CURRENT_BUFFER )
-		vlog__load_buffer_state( );
+		vlog__load_buffer_state(yyscanner );
 }
 
 /** Pushes the new state onto the stack. The new state becomes
  *  the current state. This function will allocate the stack
  *  if necessary.
  *  @param new_buffer The new state.
- *  
+ *  @param yyscanner The scanner object.
  */
-void vlog_push_buffer_state (YY_BUFFER_STATE new_buffer )
+void vlog_push_buffer_state (YY_BUFFER_STATE new_buffer , yyscan_t yyscanner)
 {
-    	if (new_buffer == NULL)
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if (new_buffer == NULL)
 		return;
 
-	vlog_ensure_buffer_stack();
+	vlog_ensure_buffer_stack(yyscanner);
 
 	/* This block is copied from vlog__switch_to_buffer. */
 	if ( YY_CURRENT_BUFFER )
 		{
 		/* Flush out information for old buffer. */
-		*(yy_c_buf_p) = (yy_hold_char);
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+		*yyg->yy_c_buf_p = yyg->yy_hold_char;
+		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = yyg->yy_c_buf_p;
+		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
 		}
 
 	/* Only push if top exists. Otherwise, replace top. */
 	if (YY_CURRENT_BUFFER)
-		(yy_buffer_stack_top)++;
+		yyg->yy_buffer_stack_top++;
 	YY_CURRENT_BUFFER_LVALUE = new_buffer;
 
 	/* copied from vlog__switch_to_buffer. */
-	vlog__load_buffer_state( );
-	(yy_did_buffer_switch_on_eof) = 1;
+	vlog__load_buffer_state(yyscanner );
+	yyg->yy_did_buffer_switch_on_eof = 1;
 }
 
 /** Removes and deletes the top of the stack, if present.
  *  The next element becomes the new top.
- *  
+ *  @param yyscanner The scanner object.
  */
-void vlog_pop_buffer_state (void)
+void vlog_pop_buffer_state (yyscan_t yyscanner)
 {
-    	if (!YY_CURRENT_BUFFER)
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if (!YY_CURRENT_BUFFER)
 		return;
 
-	vlog__delete_buffer(YY_CURRENT_BUFFER );
+	vlog__delete_buffer(YY_CURRENT_BUFFER ,yyscanner);
 	YY_CURRENT_BUFFER_LVALUE = NULL;
-	if ((yy_buffer_stack_top) > 0)
-		--(yy_buffer_stack_top);
+	if (yyg->yy_buffer_stack_top > 0)
+		--yyg->yy_buffer_stack_top;
 
 	if (YY_CURRENT_BUFFER) {
-		vlog__load_buffer_state( );
-		(yy_did_buffer_switch_on_eof) = 1;
+		vlog__load_buffer_state(yyscanner );
+		yyg->yy_did_buffer_switch_on_eof = 1;
 	}
 }
 
 /* Allocates the stack if it does not exist.
  *  Guarantees space for at least one push.
  */
-static void vlog_ensure_buffer_stack (void)
+static void vlog_ensure_buffer_stack (yyscan_t yyscanner)
 {
 	int num_to_alloc;
-    
-	if (!(yy_buffer_stack)) {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	if (!yyg->yy_buffer_stack) {
 
 		/* First allocation is just for 2 elements, since we don't know if this
 		 * scanner will even need a stack. We use 2 instead of 1 to avoid an
 		 * immediate realloc on the next call.
          */
 		num_to_alloc = 1;
-		(yy_buffer_stack) = (struct yy_buffer_state**)vlog_alloc
+		yyg->yy_buffer_stack = (struct yy_buffer_state**)vlog_alloc
 								(num_to_alloc * sizeof(struct yy_buffer_state*)
-								);
-		if ( ! (yy_buffer_stack) )
+								, yyscanner);
+		if ( ! yyg->yy_buffer_stack )
 			YY_FATAL_ERROR( "out of dynamic memory in vlog_ensure_buffer_stack()" );
 								  
-		memset((yy_buffer_stack), 0, num_to_alloc * sizeof(struct yy_buffer_state*));
+		memset(yyg->yy_buffer_stack, 0, num_to_alloc * sizeof(struct yy_buffer_state*));
 				
-		(yy_buffer_stack_max) = num_to_alloc;
-		(yy_buffer_stack_top) = 0;
+		yyg->yy_buffer_stack_max = num_to_alloc;
+		yyg->yy_buffer_stack_top = 0;
 		return;
 	}
 
-	if ((yy_buffer_stack_top) >= ((yy_buffer_stack_max)) - 1){
+	if (yyg->yy_buffer_stack_top >= (yyg->yy_buffer_stack_max) - 1){
 
 		/* Increase the buffer to prepare for a possible push. */
 		int grow_size = 8 /* arbitrary grow size */;
 
-		num_to_alloc = (yy_buffer_stack_max) + grow_size;
-		(yy_buffer_stack) = (struct yy_buffer_state**)vlog_realloc
-								((yy_buffer_stack),
+		num_to_alloc = yyg->yy_buffer_stack_max + grow_size;
+		yyg->yy_buffer_stack = (struct yy_buffer_state**)vlog_realloc
+								(yyg->yy_buffer_stack,
 								num_to_alloc * sizeof(struct yy_buffer_state*)
-								);
-		if ( ! (yy_buffer_stack) )
+								, yyscanner);
+		if ( ! yyg->yy_buffer_stack )
 			YY_FATAL_ERROR( "out of dynamic memory in vlog_ensure_buffer_stack()" );
 
 		/* zero only the new slots.*/
-		memset((yy_buffer_stack) + (yy_buffer_stack_max), 0, grow_size * sizeof(struct yy_buffer_state*));
-		(yy_buffer_stack_max) = num_to_alloc;
+		memset(yyg->yy_buffer_stack + yyg->yy_buffer_stack_max, 0, grow_size * sizeof(struct yy_buffer_state*));
+		yyg->yy_buffer_stack_max = num_to_alloc;
 	}
 }
 
 /** Setup the input buffer state to scan directly from a user-specified character buffer.
  * @param base the character buffer
  * @param size the size in bytes of the character buffer
- * 
+ * @param yyscanner The scanner object.
  * @return the newly allocated buffer state object. 
  */
-YY_BUFFER_STATE vlog__scan_buffer  (char * base, yy_size_t  size )
+YY_BUFFER_STATE vlog__scan_buffer  (char * base, yy_size_t  size , yyscan_t yyscanner)
 {
 	YY_BUFFER_STATE b;
     
@@ -3455,7 +3458,7 @@ YY_BUFFER_STATE vlog__scan_buffer  (char * base, yy_size_t  size )
 		/* They forgot to leave room for the EOB's. */
 		return 0;
 
-	b = (YY_BUFFER_STATE) vlog_alloc(sizeof( struct yy_buffer_state )  );
+	b = (YY_BUFFER_STATE) vlog_alloc(sizeof( struct yy_buffer_state ) ,yyscanner );
 	if ( ! b )
 		YY_FATAL_ERROR( "out of dynamic memory in vlog__scan_buffer()" );
 
@@ -3469,7 +3472,7 @@ YY_BUFFER_STATE vlog__scan_buffer  (char * base, yy_size_t  size )
 	b->yy_fill_buffer = 0;
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
-	vlog__switch_to_buffer(b  );
+	vlog__switch_to_buffer(b ,yyscanner );
 
 	return b;
 }
@@ -3477,25 +3480,25 @@ YY_BUFFER_STATE vlog__scan_buffer  (char * base, yy_size_t  size )
 /** Setup the input buffer state to scan a string. The next call to vlog_lex() will
  * scan from a @e copy of @a str.
  * @param yystr a NUL-terminated string to scan
- * 
+ * @param yyscanner The scanner object.
  * @return the newly allocated buffer state object.
  * @note If you want to scan bytes that may contain NUL values, then use
  *       vlog__scan_bytes() instead.
  */
-YY_BUFFER_STATE vlog__scan_string (yyconst char * yystr )
+YY_BUFFER_STATE vlog__scan_string (yyconst char * yystr , yyscan_t yyscanner)
 {
     
-	return vlog__scan_bytes(yystr,strlen(yystr) );
+	return vlog__scan_bytes(yystr,strlen(yystr) ,yyscanner);
 }
 
 /** Setup the input buffer state to scan the given bytes. The next call to vlog_lex() will
  * scan from a @e copy of @a bytes.
  * @param yybytes the byte buffer to scan
  * @param _yybytes_len the number of bytes in the buffer pointed to by @a bytes.
- * 
+ * @param yyscanner The scanner object.
  * @return the newly allocated buffer state object.
  */
-YY_BUFFER_STATE vlog__scan_bytes  (yyconst char * yybytes, int  _yybytes_len )
+YY_BUFFER_STATE vlog__scan_bytes  (yyconst char * yybytes, int  _yybytes_len , yyscan_t yyscanner)
 {
 	YY_BUFFER_STATE b;
 	char *buf;
@@ -3504,7 +3507,7 @@ YY_BUFFER_STATE vlog__scan_bytes  (yyconst char * yybytes, int  _yybytes_len )
     
 	/* Get memory for full buffer, including space for trailing EOB's. */
 	n = _yybytes_len + 2;
-	buf = (char *) vlog_alloc(n  );
+	buf = (char *) vlog_alloc(n ,yyscanner );
 	if ( ! buf )
 		YY_FATAL_ERROR( "out of dynamic memory in vlog__scan_bytes()" );
 
@@ -3513,7 +3516,7 @@ YY_BUFFER_STATE vlog__scan_bytes  (yyconst char * yybytes, int  _yybytes_len )
 
 	buf[_yybytes_len] = buf[_yybytes_len+1] = YY_END_OF_BUFFER_CHAR;
 
-	b = vlog__scan_buffer(buf,n );
+	b = vlog__scan_buffer(buf,n ,yyscanner);
 	if ( ! b )
 		YY_FATAL_ERROR( "bad buffer in vlog__scan_bytes()" );
 
@@ -3529,7 +3532,7 @@ YY_BUFFER_STATE vlog__scan_bytes  (yyconst char * yybytes, int  _yybytes_len )
 #define YY_EXIT_FAILURE 2
 #endif
 
-static void yy_fatal_error (yyconst char* msg )
+static void yy_fatal_error (yyconst char* msg , yyscan_t yyscanner)
 {
     	(void) fprintf( stderr, "%s\n", msg );
 	exit( YY_EXIT_FAILURE );
@@ -3541,117 +3544,264 @@ static void yy_fatal_error (yyconst char* msg )
 #define yyless(n) \
 	do \
 		{ \
-		/* Undo effects of setting up vlog_text. */ \
+		/* Undo effects of setting up yytext. */ \
         int yyless_macro_arg = (n); \
         YY_LESS_LINENO(yyless_macro_arg);\
-		vlog_text[vlog_leng] = (yy_hold_char); \
-		(yy_c_buf_p) = vlog_text + yyless_macro_arg; \
-		(yy_hold_char) = *(yy_c_buf_p); \
-		*(yy_c_buf_p) = '\0'; \
-		vlog_leng = yyless_macro_arg; \
+		yytext[yyleng] = yyg->yy_hold_char; \
+		yyg->yy_c_buf_p = yytext + yyless_macro_arg; \
+		yyg->yy_hold_char = *yyg->yy_c_buf_p; \
+		*yyg->yy_c_buf_p = '\0'; \
+		yyleng = yyless_macro_arg; \
 		} \
 	while ( 0 )
 
 /* Accessor  methods (get/set functions) to struct members. */
 
+/** Get the user-defined data for this scanner.
+ * @param yyscanner The scanner object.
+ */
+YY_EXTRA_TYPE vlog_get_extra  (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyextra;
+}
+
 /** Get the current line number.
- * 
+ * @param yyscanner The scanner object.
  */
-int vlog_get_lineno  (void)
+int vlog_get_lineno  (yyscan_t yyscanner)
 {
-        
-    return vlog_lineno;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    
+        if (! YY_CURRENT_BUFFER)
+            return 0;
+    
+    return yylineno;
+}
+
+/** Get the current column number.
+ * @param yyscanner The scanner object.
+ */
+int vlog_get_column  (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    
+        if (! YY_CURRENT_BUFFER)
+            return 0;
+    
+    return yycolumn;
 }
 
 /** Get the input stream.
- * 
+ * @param yyscanner The scanner object.
  */
-FILE *vlog_get_in  (void)
+FILE *vlog_get_in  (yyscan_t yyscanner)
 {
-        return vlog_in;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyin;
 }
 
 /** Get the output stream.
- * 
+ * @param yyscanner The scanner object.
  */
-FILE *vlog_get_out  (void)
+FILE *vlog_get_out  (yyscan_t yyscanner)
 {
-        return vlog_out;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyout;
 }
 
 /** Get the length of the current token.
- * 
+ * @param yyscanner The scanner object.
  */
-int vlog_get_leng  (void)
+int vlog_get_leng  (yyscan_t yyscanner)
 {
-        return vlog_leng;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyleng;
 }
 
 /** Get the current token.
- * 
+ * @param yyscanner The scanner object.
  */
 
-char *vlog_get_text  (void)
+char *vlog_get_text  (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yytext;
+}
+
+/** Set the user-defined data. This data is never touched by the scanner.
+ * @param user_defined The data to be associated with this scanner.
+ * @param yyscanner The scanner object.
+ */
+void vlog_set_extra (YY_EXTRA_TYPE  user_defined , yyscan_t yyscanner)
 {
-        return vlog_text;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyextra = user_defined ;
 }
 
 /** Set the current line number.
  * @param line_number
- * 
+ * @param yyscanner The scanner object.
+ */
+void vlog_set_lineno (int  line_number , yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        /* lineno is only valid if an input buffer exists. */
+        if (! YY_CURRENT_BUFFER )
+           yy_fatal_error( "vlog_set_lineno called with no buffer" , yyscanner); 
+    
+    yylineno = line_number;
+}
+
+/** Set the current column.
+ * @param line_number
+ * @param yyscanner The scanner object.
  */
-void vlog_set_lineno (int  line_number )
+void vlog_set_column (int  column_no , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        /* column is only valid if an input buffer exists. */
+        if (! YY_CURRENT_BUFFER )
+           yy_fatal_error( "vlog_set_column called with no buffer" , yyscanner); 
     
-    vlog_lineno = line_number;
+    yycolumn = column_no;
 }
 
 /** Set the input stream. This does not discard the current
  * input buffer.
  * @param in_str A readable stream.
- * 
+ * @param yyscanner The scanner object.
  * @see vlog__switch_to_buffer
  */
-void vlog_set_in (FILE *  in_str )
+void vlog_set_in (FILE *  in_str , yyscan_t yyscanner)
 {
-        vlog_in = in_str ;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyin = in_str ;
 }
 
-void vlog_set_out (FILE *  out_str )
+void vlog_set_out (FILE *  out_str , yyscan_t yyscanner)
 {
-        vlog_out = out_str ;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyout = out_str ;
 }
 
-int vlog_get_debug  (void)
+int vlog_get_debug  (yyscan_t yyscanner)
 {
-        return vlog__flex_debug;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yy_flex_debug;
 }
 
-void vlog_set_debug (int  bdebug )
+void vlog_set_debug (int  bdebug , yyscan_t yyscanner)
 {
-        vlog__flex_debug = bdebug ;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yy_flex_debug = bdebug ;
 }
 
-static int yy_init_globals (void)
+/* Accessor methods for yylval and yylloc */
+
+YYSTYPE * vlog_get_lval  (yyscan_t yyscanner)
 {
-        /* Initialization is the same as for the non-reentrant scanner.
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yylval;
+}
+
+void vlog_set_lval (YYSTYPE *  yylval_param , yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yylval = yylval_param;
+}
+
+/* User-visible API */
+
+/* vlog_lex_init is special because it creates the scanner itself, so it is
+ * the ONLY reentrant function that doesn't take the scanner as the last argument.
+ * That's why we explicitly handle the declaration, instead of using our macros.
+ */
+
+int vlog_lex_init(yyscan_t* ptr_yy_globals)
+
+{
+    if (ptr_yy_globals == NULL){
+        errno = EINVAL;
+        return 1;
+    }
+
+    *ptr_yy_globals = (yyscan_t) vlog_alloc ( sizeof( struct yyguts_t ), NULL );
+
+    if (*ptr_yy_globals == NULL){
+        errno = ENOMEM;
+        return 1;
+    }
+
+    /* By setting to 0xAA, we expose bugs in yy_init_globals. Leave at 0x00 for releases. */
+    memset(*ptr_yy_globals,0x00,sizeof(struct yyguts_t));
+
+    return yy_init_globals ( *ptr_yy_globals );
+}
+
+/* vlog_lex_init_extra has the same functionality as vlog_lex_init, but follows the
+ * convention of taking the scanner as the last argument. Note however, that
+ * this is a *pointer* to a scanner, as it will be allocated by this call (and
+ * is the reason, too, why this function also must handle its own declaration).
+ * The user defined value in the first argument will be available to vlog_alloc in
+ * the yyextra field.
+ */
+
+int vlog_lex_init_extra(YY_EXTRA_TYPE yy_user_defined,yyscan_t* ptr_yy_globals )
+
+{
+    struct yyguts_t dummy_yyguts;
+
+    vlog_set_extra (yy_user_defined, &dummy_yyguts);
+
+    if (ptr_yy_globals == NULL){
+        errno = EINVAL;
+        return 1;
+    }
+	
+    *ptr_yy_globals = (yyscan_t) vlog_alloc ( sizeof( struct yyguts_t ), &dummy_yyguts );
+	
+    if (*ptr_yy_globals == NULL){
+        errno = ENOMEM;
+        return 1;
+    }
+    
+    /* By setting to 0xAA, we expose bugs in
+    yy_init_globals. Leave at 0x00 for releases. */
+    memset(*ptr_yy_globals,0x00,sizeof(struct yyguts_t));
+    
+    vlog_set_extra (yy_user_defined, *ptr_yy_globals);
+    
+    return yy_init_globals ( *ptr_yy_globals );
+}
+
+static int yy_init_globals (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    /* Initialization is the same as for the non-reentrant scanner.
      * This function is called from vlog_lex_destroy(), so don't allocate here.
      */
 
-    (yy_buffer_stack) = 0;
-    (yy_buffer_stack_top) = 0;
-    (yy_buffer_stack_max) = 0;
-    (yy_c_buf_p) = (char *) 0;
-    (yy_init) = 0;
-    (yy_start) = 0;
+    yyg->yy_buffer_stack = 0;
+    yyg->yy_buffer_stack_top = 0;
+    yyg->yy_buffer_stack_max = 0;
+    yyg->yy_c_buf_p = (char *) 0;
+    yyg->yy_init = 0;
+    yyg->yy_start = 0;
+
+    yyg->yy_start_stack_ptr = 0;
+    yyg->yy_start_stack_depth = 0;
+    yyg->yy_start_stack =  NULL;
 
 /* Defined in main.c */
 #ifdef YY_STDINIT
-    vlog_in = stdin;
-    vlog_out = stdout;
+    yyin = stdin;
+    yyout = stdout;
 #else
-    vlog_in = (FILE *) 0;
-    vlog_out = (FILE *) 0;
+    yyin = (FILE *) 0;
+    yyout = (FILE *) 0;
 #endif
 
     /* For future reference: Set errno on error, since we are called by
@@ -3661,24 +3811,32 @@ static int yy_init_globals (void)
 }
 
 /* vlog_lex_destroy is for both reentrant and non-reentrant scanners. */
-int vlog_lex_destroy  (void)
+int vlog_lex_destroy  (yyscan_t yyscanner)
 {
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
     /* Pop the buffer stack, destroying each element. */
 	while(YY_CURRENT_BUFFER){
-		vlog__delete_buffer(YY_CURRENT_BUFFER  );
+		vlog__delete_buffer(YY_CURRENT_BUFFER ,yyscanner );
 		YY_CURRENT_BUFFER_LVALUE = NULL;
-		vlog_pop_buffer_state();
+		vlog_pop_buffer_state(yyscanner);
 	}
 
 	/* Destroy the stack itself. */
-	vlog_free((yy_buffer_stack) );
-	(yy_buffer_stack) = NULL;
+	vlog_free(yyg->yy_buffer_stack ,yyscanner);
+	yyg->yy_buffer_stack = NULL;
+
+    /* Destroy the start condition stack. */
+        vlog_free(yyg->yy_start_stack ,yyscanner );
+        yyg->yy_start_stack = NULL;
 
     /* Reset the globals. This is important in a non-reentrant scanner so the next time
      * vlog_lex() is called, initialization will occur. */
-    yy_init_globals( );
+    yy_init_globals( yyscanner);
 
+    /* Destroy the main struct (reentrant only). */
+    vlog_free ( yyscanner , yyscanner );
+    yyscanner = NULL;
     return 0;
 }
 
@@ -3687,7 +3845,7 @@ int vlog_lex_destroy  (void)
  */
 
 #ifndef yytext_ptr
-static void yy_flex_strncpy (char* s1, yyconst char * s2, int n )
+static void yy_flex_strncpy (char* s1, yyconst char * s2, int n , yyscan_t yyscanner)
 {
 	register int i;
 	for ( i = 0; i < n; ++i )
@@ -3696,7 +3854,7 @@ static void yy_flex_strncpy (char* s1, yyconst char * s2, int n )
 #endif
 
 #ifdef YY_NEED_STRLEN
-static int yy_flex_strlen (yyconst char * s )
+static int yy_flex_strlen (yyconst char * s , yyscan_t yyscanner)
 {
 	register int n;
 	for ( n = 0; s[n]; ++n )
@@ -3706,12 +3864,12 @@ static int yy_flex_strlen (yyconst char * s )
 }
 #endif
 
-void *vlog_alloc (yy_size_t  size )
+void *vlog_alloc (yy_size_t  size , yyscan_t yyscanner)
 {
 	return (void *) malloc( size );
 }
 
-void *vlog_realloc  (void * ptr, yy_size_t  size )
+void *vlog_realloc  (void * ptr, yy_size_t  size , yyscan_t yyscanner)
 {
 	/* The cast to (char *) in the following accommodates both
 	 * implementations that use char* generic pointers, and those
@@ -3723,29 +3881,27 @@ void *vlog_realloc  (void * ptr, yy_size_t  size )
 	return (void *) realloc( (char *) ptr, size );
 }
 
-void vlog_free (void * ptr )
+void vlog_free (void * ptr , yyscan_t yyscanner)
 {
 	free( (char *) ptr );	/* see vlog_realloc() for (char *) cast */
 }
 
 #define YYTABLES_NAME "yytables"
 
-#line 185 "verilog.lpp"
-
-
-
-int vlog_wrap ()
-   {
-   return (1);
-   }
+#line 187 "verilog.lpp"
 
 #ifdef SELFDEBUG
 main()
 {
    int t;
-   while(t=vlog_lex()){
+   YYSTYPE lval;
+   hcmParsedFile file;
+   hcmParseContext ctx(&file);
+   yyscan_t scanner;
+   vlog_lex_init_extra(&ctx, &scanner);
+   while(t=vlog_lex(&lval, scanner)){
       printf("%d ",t);
    }
+   vlog_lex_destroy(scanner);
 }
 #endif
-
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -66,182 +71,226 @@
 #define yydebug         vlog_debug
 #define yynerrs         vlog_nerrs
 
-#define yylval          vlog_lval
-#define yychar          vlog_char
-
-/* Copy the first part of user declarations.  */
-#line 7 "verilog.ypp" /* yacc.c:339  */
-
-#define IMPLICIT_WIRES 1
+/* First part of user prologue.  */
+#line 7 "verilog.ypp"
 
 #include <stdio.h>
 #include "string.h"
 #include <sstream>
 #include <vector>
-#include <list>
 #include "hcm.h"
+#include "hcmVerilogIR.h"
 #include "verilog.tab.hpp"
 
-#ifdef VLOG_MAIN
-CharBuf token;
-#endif
-
 //#define DEBUG 1
-#define VDD 1
-#define VSS 0
 #define YYMAXDEPTH 65536*1024
-void record_type(int x);
+void record_type(hcmParseContext* ctx, int x);
 
 
 
-#line 98 "verilog.tab.cpp" /* yacc.c:339  */
+#line 92 "verilog.tab.cpp"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "verilog.tab.hpp".  */
-#ifndef YY_VLOG_VERILOG_TAB_HPP_INCLUDED
-# define YY_VLOG_VERILOG_TAB_HPP_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int vlog_debug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    INT = 258,
-    ID = 259,
-    MODULE = 260,
-    ENDMODULE = 261,
-    CONST = 262,
-    _ASSIGN = 263,
-    BUF = 264,
-    WIRE = 265,
-    WAND = 266,
-    WOR = 267,
-    TRI = 268,
-    REG = 269,
-    TRIREG = 270,
-    INPUT = 271,
-    OUTPUT = 272,
-    INOUT = 273,
-    SUPPLY1 = 274,
-    SUPPLY0 = 275
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
-union YYSTYPE
+#include "verilog.tab.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 31 "verilog.ypp" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INT = 3,                        /* INT  */
+  YYSYMBOL_ID = 4,                         /* ID  */
+  YYSYMBOL_MODULE = 5,                     /* MODULE  */
+  YYSYMBOL_ENDMODULE = 6,                  /* ENDMODULE  */
+  YYSYMBOL_CONST = 7,                      /* CONST  */
+  YYSYMBOL__ASSIGN = 8,                    /* _ASSIGN  */
+  YYSYMBOL_BUF = 9,                        /* BUF  */
+  YYSYMBOL_WIRE = 10,                      /* WIRE  */
+  YYSYMBOL_WAND = 11,                      /* WAND  */
+  YYSYMBOL_WOR = 12,                       /* WOR  */
+  YYSYMBOL_TRI = 13,                       /* TRI  */
+  YYSYMBOL_REG = 14,                       /* REG  */
+  YYSYMBOL_TRIREG = 15,                    /* TRIREG  */
+  YYSYMBOL_INPUT = 16,                     /* INPUT  */
+  YYSYMBOL_OUTPUT = 17,                    /* OUTPUT  */
+  YYSYMBOL_INOUT = 18,                     /* INOUT  */
+  YYSYMBOL_SUPPLY1 = 19,                   /* SUPPLY1  */
+  YYSYMBOL_SUPPLY0 = 20,                   /* SUPPLY0  */
+  YYSYMBOL_21_ = 21,                       /* ';'  */
+  YYSYMBOL_22_ = 22,                       /* '['  */
+  YYSYMBOL_23_ = 23,                       /* ':'  */
+  YYSYMBOL_24_ = 24,                       /* ']'  */
+  YYSYMBOL_25_ = 25,                       /* ','  */
+  YYSYMBOL_26_ = 26,                       /* '('  */
+  YYSYMBOL_27_ = 27,                       /* ')'  */
+  YYSYMBOL_28_ = 28,                       /* '{'  */
+  YYSYMBOL_29_ = 29,                       /* '}'  */
+  YYSYMBOL_30_ = 30,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 31,                  /* $accept  */
+  YYSYMBOL_prog = 32,                      /* prog  */
+  YYSYMBOL_module0 = 33,                   /* module0  */
+  YYSYMBOL_module = 34,                    /* module  */
+  YYSYMBOL_body = 35,                      /* body  */
+  YYSYMBOL_type_decl = 36,                 /* type_decl  */
+  YYSYMBOL_nodedeclaration = 37,           /* nodedeclaration  */
+  YYSYMBOL_declaration = 38,               /* declaration  */
+  YYSYMBOL_assign_parameter_list = 39,     /* assign_parameter_list  */
+  YYSYMBOL_instName = 40,                  /* instName  */
+  YYSYMBOL_singleInst = 41,                /* singleInst  */
+  YYSYMBOL_repeatedInsts = 42,             /* repeatedInsts  */
+  YYSYMBOL_master = 43,                    /* master  */
+  YYSYMBOL_instance = 44,                  /* instance  */
+  YYSYMBOL_port_declaration = 45,          /* port_declaration  */
+  YYSYMBOL_port_list = 46,                 /* port_list  */
+  YYSYMBOL_net = 47,                       /* net  */
+  YYSYMBOL_net_list = 48,                  /* net_list  */
+  YYSYMBOL_sym_pin = 49,                   /* sym_pin  */
+  YYSYMBOL_50_1 = 50,                      /* $@1  */
+  YYSYMBOL_51_2 = 51,                      /* $@2  */
+  YYSYMBOL_52_3 = 52,                      /* $@3  */
+  YYSYMBOL_sym_pin_list = 53,              /* sym_pin_list  */
+  YYSYMBOL_type = 54                       /* type  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-    int ival;
-    char *sval;
-    hcmInstance *instance;
-    hcmCell  *cell;
-    hcmInstPort *sym_pin;
 
-#line 167 "verilog.tab.cpp" /* yacc.c:355  */
-};
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+/* Second part of user prologue.  */
+#line 46 "verilog.ypp"
 
 
-extern YYSTYPE vlog_lval;
-
-int vlog_parse (void);
-
-#endif /* !YY_VLOG_VERILOG_TAB_HPP_INCLUDED  */
-
-/* Copy the second part of user declarations.  */
-#line 53 "verilog.ypp" /* yacc.c:358  */
-
-extern int vlog_lineno;
-hcmDesign         *global_design;
-hcmCell               *current_cell=NULL;
-static hcmInstance      *current_instance=NULL;
-static char moduleName[256];
-static char masterName[256];
-static char buff[1024];
-Range current_range;
-/* point to current port number for connect by order */
-int curPortIdx; 
-map< const hcmDesign *, map<string, vector<string> > > designCellPortsListMap;
-DictType dict;
-vector<hcmNode*> currentNodes;
-const char *current_file="";
-map<string, pair<int,int> > curCellBusses;
-void createInstance(const char *name);
-void add_new_bus(const char *name);
-void connectNodes(string portName);
-void connectNodesToNextPort();
-string busNodeName(string busName, int index);
-void pushBus(const char* busName, int leftIdx, int rightIdx);
-void pushBinaryBus(const char* binaryBusChar);
-extern int vlog_lex();
-
-int vlog_error(const char *msg)
+// the parser only records the statements in ctx->file, the design is built by hcmVerilogLinker
+void add_stmt(hcmParseContext* ctx, hcmParsedStmtKind kind, const char* name, int upper, int lower);
+void add_port(hcmParseContext* ctx, const char* name);
+void add_net(hcmParseContext* ctx, const char* name, int left, int right, bool constant);
+void add_pin(hcmParseContext* ctx, const char* port, int bit);
+extern int vlog_lex(YYSTYPE* lvalp, void* scanner);
+// the reentrant scanner in lex.vlog.cpp
+typedef void* yyscan_t;
+extern int vlog_lex_init_extra(hcmParseContext* ctx, yyscan_t* scanner);
+extern void vlog_set_in(FILE* in, yyscan_t scanner);
+extern int vlog_lex_destroy(yyscan_t scanner);
+
+int vlog_error(void* scanner, hcmParseContext* ctx, const char *msg)
 {
-   fprintf(stderr,"\nVerilog Syntax error at '%s' line %d (%s) ",current_file,vlog_lineno,msg);
-   delete current_cell;
-	current_cell = NULL;
+   fprintf(stderr,"\nVerilog Syntax error at '%s' line %d (%s) ",ctx->file->fileName.c_str(),ctx->line,msg);
+   // the module with the error is not kept
+   if (ctx->module) {
+     ctx->file->modules.pop_back();
+     ctx->module = NULL;
+   }
    return 1;
 }
 
 
-void print_each_net();
+#line 207 "verilog.tab.cpp"
 
-#line 219 "verilog.tab.cpp" /* yacc.c:358  */
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -249,15 +298,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -271,47 +333,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -324,8 +382,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -390,8 +462,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -400,17 +471,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -423,11 +494,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -439,12 +510,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -461,23 +532,26 @@ union yyalloc
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  31
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  26
+#define YYNNTS  24
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  60
+#define YYNRULES  58
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  106
+#define YYNSTATES  104
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   275
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -510,217 +584,215 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    92,    92,    93,    93,    97,   105,   112,   113,   114,
-     115,   119,   125,   134,   135,   136,   140,   144,   145,   148,
-     150,   150,   153,   154,   157,   160,   162,   163,   164,   168,
-     169,   170,   171,   175,   176,   177,   178,   179,   182,   183,
-     186,   186,   187,   188,   188,   189,   190,   190,   193,   194,
-     195,   199,   200,   201,   202,   203,   204,   205,   206,   207,
-     208
+       0,    74,    74,    75,    79,    88,    95,    96,    97,    98,
+     102,   108,   117,   118,   119,   123,   127,   128,   131,   133,
+     139,   140,   143,   146,   148,   149,   150,   154,   155,   156,
+     157,   160,   161,   162,   163,   164,   167,   168,   171,   171,
+     172,   173,   173,   174,   175,   175,   178,   179,   180,   184,
+     185,   186,   187,   188,   189,   190,   191,   192,   193
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "INT", "ID", "MODULE", "ENDMODULE",
-  "CONST", "_ASSIGN", "BUF", "WIRE", "WAND", "WOR", "TRI", "REG", "TRIREG",
-  "INPUT", "OUTPUT", "INOUT", "SUPPLY1", "SUPPLY0", "';'", "'['", "':'",
-  "']'", "','", "'('", "')'", "'{'", "'}'", "'.'", "$accept", "prog",
-  "$@1", "module0", "module", "body", "type_decl", "nodedeclaration",
-  "declaration", "assign_parameter_list", "instName", "singleInst", "$@2",
+  "\"end of file\"", "error", "\"invalid token\"", "INT", "ID", "MODULE",
+  "ENDMODULE", "CONST", "_ASSIGN", "BUF", "WIRE", "WAND", "WOR", "TRI",
+  "REG", "TRIREG", "INPUT", "OUTPUT", "INOUT", "SUPPLY1", "SUPPLY0", "';'",
+  "'['", "':'", "']'", "','", "'('", "')'", "'{'", "'}'", "'.'", "$accept",
+  "prog", "module0", "module", "body", "type_decl", "nodedeclaration",
+  "declaration", "assign_parameter_list", "instName", "singleInst",
   "repeatedInsts", "master", "instance", "port_declaration", "port_list",
-  "net", "net_list", "sym_pin", "$@3", "$@4", "$@5", "sym_pin_list",
+  "net", "net_list", "sym_pin", "$@1", "$@2", "$@3", "sym_pin_list",
   "type", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,    59,    91,    58,    93,    44,    40,    41,   123,   125,
-      46
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -76
+#define YYPACT_NINF (-72)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-76)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -49
+#define YYTABLE_NINF (-47)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-      16,    19,    44,    26,   -76,   -76,   -76,    -1,    34,    16,
-      35,   -76,    -8,    29,   -76,    53,    54,   -76,   -76,   -76,
-     -76,   -76,   -76,   -76,   -76,   -76,   -76,   -76,   -76,    18,
-      55,   -76,    56,   -76,    39,    38,    41,   -76,   -76,   -76,
-      42,   -76,   -19,   -76,    40,   -76,   -13,    62,   -76,    64,
-      65,   -76,    55,   -76,   -76,    56,    46,    47,    27,   -76,
-     -20,   -76,    67,   -76,    69,   -76,    70,   -76,    -3,    -7,
-      49,    51,   -11,    57,   -76,    -3,   -76,    48,   -76,   -76,
-     -76,    73,    50,    77,   -76,   -16,   -76,    58,   -76,    -3,
-      30,    -3,   -76,    59,    60,    78,   -76,   -76,    61,   -76,
-      66,   -76,    -3,   -76,    68,   -76
+       9,    17,    27,     7,     9,   -72,   -72,    -1,    29,   -72,
+      34,   -72,    -8,    35,    54,    55,   -72,   -72,   -72,   -72,
+     -72,   -72,   -72,   -72,   -72,   -72,   -72,   -72,    24,    56,
+     -72,    57,   -72,    36,    38,    41,   -72,   -72,   -72,    42,
+     -72,   -19,   -72,    39,   -72,   -13,    63,   -72,    64,    65,
+     -72,    56,   -20,   -72,    57,    46,    47,     0,   -72,    66,
+     -72,    -3,    -5,   -72,    69,   -72,    70,   -72,   -11,    52,
+     -72,    -3,   -72,    45,   -72,    53,    58,    73,    51,    76,
+     -72,   -16,   -72,   -72,   -72,    59,   -72,    -3,     8,    -3,
+     -72,    60,    61,    77,   -72,   -72,    62,   -72,    67,   -72,
+      -3,   -72,    68,   -72
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       2,     0,     0,    26,     3,     5,     1,     0,     0,     2,
-      29,    27,     0,     0,     4,     0,     0,    28,    24,    54,
-      55,    56,    57,    58,    51,    52,    53,    59,    60,     0,
-       0,     7,     0,     8,    12,     0,    31,     6,     9,    10,
-      13,    17,     0,    19,     0,    23,     0,     0,    30,     0,
-       0,    16,     0,    20,    25,     0,     0,     0,     0,    18,
-      40,    22,     0,    32,     0,    14,     0,    49,     0,     0,
-       0,     0,     0,    33,    36,     0,    41,    40,    21,    11,
-      15,     0,    43,     0,    38,     0,    50,     0,    42,     0,
-       0,     0,    37,     0,     0,     0,    34,    39,    46,    44,
-       0,    45,     0,    35,     0,    47
+       2,     0,     0,    24,     2,     4,     1,     0,     0,     3,
+      27,    25,     0,     0,     0,     0,    26,    22,    52,    53,
+      54,    55,    56,    49,    50,    51,    57,    58,     0,     0,
+       6,     0,     7,    11,     0,    29,     5,     8,     9,    12,
+      16,     0,    18,     0,    21,     0,     0,    28,     0,     0,
+      15,     0,    38,    23,     0,     0,     0,     0,    17,     0,
+      47,     0,     0,    20,     0,    30,     0,    13,     0,    31,
+      34,     0,    39,    38,    19,     0,     0,     0,    41,     0,
+      36,     0,    48,    10,    14,     0,    40,     0,     0,     0,
+      35,     0,     0,     0,    32,    37,    44,    42,     0,    43,
+       0,    33,     0,    45
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -76,    74,   -76,   -76,   -76,   -76,   -76,    32,    63,   -76,
-     -76,    31,   -76,   -76,   -76,    71,   -76,   -76,   -75,   -76,
-      12,   -76,   -76,   -76,   -76,   -76
+     -72,    80,   -72,   -72,   -72,   -72,    30,    71,   -72,   -72,
+      31,   -72,   -72,    72,   -72,   -72,   -71,   -72,    14,   -72,
+     -72,   -72,   -72,   -72
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     2,     9,     3,     4,    29,    30,    41,    31,    42,
-      44,    45,    60,    46,    32,    33,     8,    12,    76,    85,
-      67,    68,    89,   102,    69,    34
+       0,     2,     3,     4,    28,    29,    40,    30,    41,    43,
+      44,    45,    31,    32,     8,    12,    72,    81,    60,    61,
+      87,   100,    62,    33
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
-      84,    73,    51,    10,    74,   -48,    52,   -48,    54,    91,
-      66,    81,    55,    92,    94,    82,    97,    16,    77,    17,
-      78,     1,    18,     5,    37,    75,    11,   104,    19,    20,
-      21,    22,    23,    18,    24,    25,    26,    27,    28,    19,
-      20,    21,    22,    23,     6,    24,    25,    26,    27,    28,
-      64,    65,     7,    95,    96,    13,    35,    15,    36,    40,
-      43,    47,    48,    49,    50,    56,    53,    57,    58,    62,
-      70,    63,    71,    79,    72,    80,    87,    88,    66,    83,
-      90,   100,    93,    14,    59,    98,    61,    99,   101,    86,
-     103,     0,    38,     0,     0,   105,     0,     0,     0,     0,
-      39
+      80,    69,    50,    10,    70,   -46,    51,   -46,    53,    89,
+      59,    77,    54,    90,     1,    78,    92,    15,    95,    16,
+      73,     5,    74,    66,    67,    71,    11,     6,    17,   102,
+      36,    93,    94,     7,    18,    19,    20,    21,    22,    17,
+      23,    24,    25,    26,    27,    18,    19,    20,    21,    22,
+      13,    23,    24,    25,    26,    27,    14,    34,    46,    35,
+      39,    42,    47,    48,    49,    52,    55,    56,    57,    64,
+      68,    65,    75,    76,    79,    59,    85,    83,    86,    88,
+      98,    58,    84,    91,     9,    63,    96,    82,    97,    99,
+       0,   101,     0,     0,     0,   103,     0,     0,     0,    37,
+      38
 };
 
 static const yytype_int8 yycheck[] =
 {
-      75,     4,    21,     4,     7,    25,    25,    27,    21,    25,
-      30,    22,    25,    29,    89,    26,    91,    25,    25,    27,
-      27,     5,     4,     4,     6,    28,    27,   102,    10,    11,
-      12,    13,    14,     4,    16,    17,    18,    19,    20,    10,
-      11,    12,    13,    14,     0,    16,    17,    18,    19,    20,
-      23,    24,    26,    23,    24,    21,     3,    22,     4,     4,
-       4,    22,    24,    22,    22,     3,    26,     3,     3,    23,
-       3,    24,     3,    24,     4,    24,     3,    27,    30,    22,
-       3,     3,    24,     9,    52,    26,    55,    27,    27,    77,
-      24,    -1,    29,    -1,    -1,    27,    -1,    -1,    -1,    -1,
-      29
+      71,     4,    21,     4,     7,    25,    25,    27,    21,    25,
+      30,    22,    25,    29,     5,    26,    87,    25,    89,    27,
+      25,     4,    27,    23,    24,    28,    27,     0,     4,   100,
+       6,    23,    24,    26,    10,    11,    12,    13,    14,     4,
+      16,    17,    18,    19,    20,    10,    11,    12,    13,    14,
+      21,    16,    17,    18,    19,    20,    22,     3,    22,     4,
+       4,     4,    24,    22,    22,    26,     3,     3,     3,    23,
+       4,    24,     3,     3,    22,    30,     3,    24,    27,     3,
+       3,    51,    24,    24,     4,    54,    26,    73,    27,    27,
+      -1,    24,    -1,    -1,    -1,    27,    -1,    -1,    -1,    28,
+      28
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-       0,     5,    32,    34,    35,     4,     0,    26,    47,    33,
-       4,    27,    48,    21,    32,    22,    25,    27,     4,    10,
-      11,    12,    13,    14,    16,    17,    18,    19,    20,    36,
-      37,    39,    45,    46,    56,     3,     4,     6,    39,    46,
-       4,    38,    40,     4,    41,    42,    44,    22,    24,    22,
-      22,    21,    25,    26,    21,    25,     3,     3,     3,    38,
-      43,    42,    23,    24,    23,    24,    30,    51,    52,    55,
-       3,     3,     4,     4,     7,    28,    49,    25,    27,    24,
-      24,    22,    26,    22,    49,    50,    51,     3,    27,    53,
-       3,    25,    29,    24,    49,    23,    24,    49,    26,    27,
-       3,    27,    54,    24,    49,    27
+       0,     5,    32,    33,    34,     4,     0,    26,    45,    32,
+       4,    27,    46,    21,    22,    25,    27,     4,    10,    11,
+      12,    13,    14,    16,    17,    18,    19,    20,    35,    36,
+      38,    43,    44,    54,     3,     4,     6,    38,    44,     4,
+      37,    39,     4,    40,    41,    42,    22,    24,    22,    22,
+      21,    25,    26,    21,    25,     3,     3,     3,    37,    30,
+      49,    50,    53,    41,    23,    24,    23,    24,     4,     4,
+       7,    28,    47,    25,    27,     3,     3,    22,    26,    22,
+      47,    48,    49,    24,    24,     3,    27,    51,     3,    25,
+      29,    24,    47,    23,    24,    47,    26,    27,     3,    27,
+      52,    24,    47,    27
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       0,    31,    32,    33,    32,    34,    35,    36,    36,    36,
-      36,    37,    37,    38,    38,    38,    39,    40,    40,    41,
-      43,    42,    44,    44,    45,    46,    47,    47,    47,    48,
-      48,    48,    48,    49,    49,    49,    49,    49,    50,    50,
-      52,    51,    51,    53,    51,    51,    54,    51,    55,    55,
-      55,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      56
+       0,    31,    32,    32,    33,    34,    35,    35,    35,    35,
+      36,    36,    37,    37,    37,    38,    39,    39,    40,    41,
+      42,    42,    43,    44,    45,    45,    45,    46,    46,    46,
+      46,    47,    47,    47,    47,    47,    48,    48,    50,    49,
+      49,    51,    49,    49,    52,    49,    53,    53,    53,    54,
+      54,    54,    54,    54,    54,    54,    54,    54,    54
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,     2,     0,     0,     3,     2,     5,     1,     1,     2,
-       2,     6,     1,     1,     4,     6,     3,     1,     3,     1,
-       0,     5,     3,     1,     1,     3,     0,     2,     3,     1,
-       4,     3,     6,     1,     4,     6,     1,     3,     1,     3,
-       0,     2,     4,     0,     6,     7,     0,     9,     0,     1,
-       3,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1
+       0,     2,     0,     2,     2,     5,     1,     1,     2,     2,
+       6,     1,     1,     4,     6,     3,     1,     3,     1,     4,
+       3,     1,     1,     3,     0,     2,     3,     1,     4,     3,
+       6,     1,     4,     6,     1,     3,     1,     3,     0,     2,
+       4,     0,     6,     7,     0,     9,     0,     1,     3,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -737,55 +809,54 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, scanner, ctx); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void* scanner, hcmParseContext* ctx)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (ctx);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void* scanner, hcmParseContext* ctx)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, ctx);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -794,7 +865,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -817,21 +888,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, void* scanner, hcmParseContext* ctx)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, ctx);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -839,15 +910,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner, ctx); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -870,255 +941,33 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
 
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
 
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, void* scanner, hcmParseContext* ctx)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (ctx);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
@@ -1126,45 +975,51 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (void* scanner, hcmParseContext* ctx)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1172,71 +1027,75 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1244,30 +1103,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1278,18 +1138,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1317,15 +1188,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1340,7 +1209,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1360,307 +1229,299 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 3:
-#line 93 "verilog.ypp" /* yacc.c:1646  */
-    {curCellBusses.clear();}
-#line 1368 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 3: /* prog: module prog  */
+#line 75 "verilog.ypp"
+                  {ctx->module = NULL;}
+#line 1236 "verilog.tab.cpp"
     break;
 
-  case 4:
-#line 93 "verilog.ypp" /* yacc.c:1646  */
-    {current_cell = NULL;}
-#line 1374 "verilog.tab.cpp" /* yacc.c:1646  */
-    break;
-
-  case 5:
-#line 97 "verilog.ypp" /* yacc.c:1646  */
-    { 
-	           strcpy(moduleName, (yyvsp[0].sval));
-                   (yyval.cell)=global_design->createCell((yyvsp[0].sval));
-                   current_cell=(yyval.cell);
+  case 4: /* module0: MODULE ID  */
+#line 79 "verilog.ypp"
+                { 
+                   ctx->file->modules.emplace_back();
+                   ctx->module = &ctx->file->modules.back();
+                   ctx->module->name = (yyvsp[0].sval);
+                   ctx->module->line = ctx->line;
                 }
-#line 1384 "verilog.tab.cpp" /* yacc.c:1646  */
+#line 1247 "verilog.tab.cpp"
     break;
 
-  case 6:
-#line 106 "verilog.ypp" /* yacc.c:1646  */
-    { 
-           
+  case 5: /* module: module0 port_declaration ';' body ENDMODULE  */
+#line 89 "verilog.ypp"
+        { 
+           ctx->module = NULL;
         }
-#line 1392 "verilog.tab.cpp" /* yacc.c:1646  */
+#line 1255 "verilog.tab.cpp"
     break;
 
-  case 11:
-#line 119 "verilog.ypp" /* yacc.c:1646  */
-    { current_range.upper=(yyvsp[-3].ival); 
-                                 current_range.lower=(yyvsp[-1].ival); 
-				 current_range.type=WireNet;
- 				 current_range.dir=NOT_PORT;
-                                 record_type((int)(yyvsp[-5].ival));
+  case 10: /* type_decl: type '[' INT ':' INT ']'  */
+#line 102 "verilog.ypp"
+                               { ctx->range.upper=(yyvsp[-3].ival); 
+                                 ctx->range.lower=(yyvsp[-1].ival); 
+				 ctx->range.type=WireNet;
+ 				 ctx->range.dir=NOT_PORT;
+                                 record_type(ctx,(int)(yyvsp[-5].ival));
                                }
-#line 1403 "verilog.tab.cpp" /* yacc.c:1646  */
+#line 1266 "verilog.tab.cpp"
     break;
 
-  case 12:
-#line 125 "verilog.ypp" /* yacc.c:1646  */
-    { current_range.upper=-1; 
-                                 current_range.lower=-1; 
-                                 current_range.type=WireNet;
- 				 current_range.dir=NOT_PORT;
-                                 record_type((int)(yyvsp[0].ival));
+  case 11: /* type_decl: type  */
+#line 108 "verilog.ypp"
+                               { ctx->range.upper=-1; 
+                                 ctx->range.lower=-1; 
+                                 ctx->range.type=WireNet;
+ 				 ctx->range.dir=NOT_PORT;
+                                 record_type(ctx,(int)(yyvsp[0].ival));
                                }
-#line 1414 "verilog.tab.cpp" /* yacc.c:1646  */
+#line 1277 "verilog.tab.cpp"
     break;
 
-  case 13:
-#line 134 "verilog.ypp" /* yacc.c:1646  */
-    { add_new_bus((yyvsp[0].sval));}
-#line 1420 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 12: /* nodedeclaration: ID  */
+#line 117 "verilog.ypp"
+                                 { add_stmt(ctx,STMT_SIGNAL,(yyvsp[0].sval),ctx->range.upper,ctx->range.lower);}
+#line 1283 "verilog.tab.cpp"
     break;
 
-  case 14:
-#line 135 "verilog.ypp" /* yacc.c:1646  */
-    { current_cell->createNode(busNodeName((yyvsp[-3].sval),(yyvsp[-1].ival)));}
-#line 1426 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 13: /* nodedeclaration: ID '[' INT ']'  */
+#line 118 "verilog.ypp"
+                                 { add_stmt(ctx,STMT_BIT,(yyvsp[-3].sval),(yyvsp[-1].ival),-1);}
+#line 1289 "verilog.tab.cpp"
     break;
 
-  case 15:
-#line 136 "verilog.ypp" /* yacc.c:1646  */
-    { current_cell->createBus((yyvsp[-5].sval),(yyvsp[-3].ival),(yyvsp[-1].ival),NOT_PORT);}
-#line 1432 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 14: /* nodedeclaration: ID '[' INT ':' INT ']'  */
+#line 119 "verilog.ypp"
+                                 { add_stmt(ctx,STMT_BUS,(yyvsp[-5].sval),(yyvsp[-3].ival),(yyvsp[-1].ival));}
+#line 1295 "verilog.tab.cpp"
     break;
 
-  case 16:
-#line 140 "verilog.ypp" /* yacc.c:1646  */
-    {  }
-#line 1438 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 15: /* declaration: type_decl assign_parameter_list ';'  */
+#line 123 "verilog.ypp"
+                                         {  }
+#line 1301 "verilog.tab.cpp"
     break;
 
-  case 17:
-#line 144 "verilog.ypp" /* yacc.c:1646  */
-    {}
-#line 1444 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 16: /* assign_parameter_list: nodedeclaration  */
+#line 127 "verilog.ypp"
+                    {}
+#line 1307 "verilog.tab.cpp"
     break;
 
-  case 18:
-#line 145 "verilog.ypp" /* yacc.c:1646  */
-    { }
-#line 1450 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 17: /* assign_parameter_list: assign_parameter_list ',' nodedeclaration  */
+#line 128 "verilog.ypp"
+                                                  { }
+#line 1313 "verilog.tab.cpp"
     break;
 
-  case 19:
-#line 148 "verilog.ypp" /* yacc.c:1646  */
-    {createInstance((yyvsp[0].sval)); (yyval.instance)=current_instance;}
-#line 1456 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 18: /* instName: ID  */
+#line 131 "verilog.ypp"
+             { add_stmt(ctx,STMT_INST,(yyvsp[0].sval),-1,-1);}
+#line 1319 "verilog.tab.cpp"
     break;
 
-  case 20:
-#line 150 "verilog.ypp" /* yacc.c:1646  */
-    {curPortIdx = 0; }
-#line 1462 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 19: /* singleInst: instName '(' sym_pin_list ')'  */
+#line 133 "verilog.ypp"
+                                          { 
+                hcmParsedStmt& stmt = ctx->module->stmts.back();
+                stmt.numPins = ctx->module->pins.size() - stmt.firstPin;
+              }
+#line 1328 "verilog.tab.cpp"
     break;
 
-  case 21:
-#line 150 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.instance)=(yyvsp[-4].instance);}
-#line 1468 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 22: /* master: ID  */
+#line 143 "verilog.ypp"
+           { ctx->master = (yyvsp[0].sval);}
+#line 1334 "verilog.tab.cpp"
     break;
 
-  case 24:
-#line 157 "verilog.ypp" /* yacc.c:1646  */
-    { strcpy(masterName, (yyvsp[0].sval));}
-#line 1474 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 27: /* port_list: ID  */
+#line 154 "verilog.ypp"
+                        { add_port(ctx,(yyvsp[0].sval));}
+#line 1340 "verilog.tab.cpp"
     break;
 
-  case 29:
-#line 168 "verilog.ypp" /* yacc.c:1646  */
-    { designCellPortsListMap[global_design][moduleName].push_back((yyvsp[0].sval));}
-#line 1480 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 28: /* port_list: ID '[' INT ']'  */
+#line 155 "verilog.ypp"
+                        { add_port(ctx,busNodeName((yyvsp[-3].sval),(yyvsp[-1].ival)).c_str());}
+#line 1346 "verilog.tab.cpp"
     break;
 
-  case 30:
-#line 169 "verilog.ypp" /* yacc.c:1646  */
-    { sprintf(buff, "%s[%d]",(yyvsp[-3].sval),(yyvsp[-1].ival)); designCellPortsListMap[global_design][moduleName].push_back(buff);}
-#line 1486 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 29: /* port_list: port_list ',' ID  */
+#line 156 "verilog.ypp"
+                        { add_port(ctx,(yyvsp[0].sval));}
+#line 1352 "verilog.tab.cpp"
     break;
 
-  case 31:
-#line 170 "verilog.ypp" /* yacc.c:1646  */
-    { designCellPortsListMap[global_design][moduleName].push_back((yyvsp[0].sval));}
-#line 1492 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 30: /* port_list: port_list ',' ID '[' INT ']'  */
+#line 157 "verilog.ypp"
+                                    { add_port(ctx,busNodeName((yyvsp[-3].sval),(yyvsp[-1].ival)).c_str());}
+#line 1358 "verilog.tab.cpp"
     break;
 
-  case 32:
-#line 171 "verilog.ypp" /* yacc.c:1646  */
-    { sprintf(buff, "%s[%d]",(yyvsp[-3].sval),(yyvsp[-1].ival)); 
-                                             designCellPortsListMap[global_design][moduleName].push_back(buff);}
-#line 1499 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 31: /* net: ID  */
+#line 160 "verilog.ypp"
+                                 { add_net(ctx,(yyvsp[0].sval),-1,-1,false);}
+#line 1364 "verilog.tab.cpp"
     break;
 
-  case 33:
-#line 175 "verilog.ypp" /* yacc.c:1646  */
-    { pushBus((yyvsp[0].sval),-1,-1);;}
-#line 1505 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 32: /* net: ID '[' INT ']'  */
+#line 161 "verilog.ypp"
+                                 { add_net(ctx,(yyvsp[-3].sval),(yyvsp[-1].ival),(yyvsp[-1].ival),false);}
+#line 1370 "verilog.tab.cpp"
     break;
 
-  case 34:
-#line 176 "verilog.ypp" /* yacc.c:1646  */
-    { pushBus((yyvsp[-3].sval),(yyvsp[-1].ival),(yyvsp[-1].ival));}
-#line 1511 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 33: /* net: ID '[' INT ':' INT ']'  */
+#line 162 "verilog.ypp"
+                                 { add_net(ctx,(yyvsp[-5].sval),(yyvsp[-3].ival),(yyvsp[-1].ival),false);}
+#line 1376 "verilog.tab.cpp"
     break;
 
-  case 35:
-#line 177 "verilog.ypp" /* yacc.c:1646  */
-    { pushBus((yyvsp[-5].sval),(yyvsp[-3].ival),(yyvsp[-1].ival));}
-#line 1517 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 34: /* net: CONST  */
+#line 163 "verilog.ypp"
+                                 { add_net(ctx,(yyvsp[0].sval),-1,-1,true);}
+#line 1382 "verilog.tab.cpp"
     break;
 
-  case 36:
-#line 178 "verilog.ypp" /* yacc.c:1646  */
-    { pushBinaryBus((yyvsp[0].sval));}
-#line 1523 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 36: /* net_list: net  */
+#line 167 "verilog.ypp"
+                                 {}
+#line 1388 "verilog.tab.cpp"
     break;
 
-  case 38:
-#line 182 "verilog.ypp" /* yacc.c:1646  */
-    {}
-#line 1529 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 37: /* net_list: net_list ',' net  */
+#line 168 "verilog.ypp"
+                                 {}
+#line 1394 "verilog.tab.cpp"
     break;
 
-  case 39:
-#line 183 "verilog.ypp" /* yacc.c:1646  */
-    {}
-#line 1535 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 38: /* $@1: %empty  */
+#line 171 "verilog.ypp"
+          {  ctx->firstNet = ctx->module->nets.size(); }
+#line 1400 "verilog.tab.cpp"
     break;
 
-  case 40:
-#line 186 "verilog.ypp" /* yacc.c:1646  */
-    {  currentNodes.clear(); }
-#line 1541 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 39: /* sym_pin: $@1 net  */
+#line 171 "verilog.ypp"
+                                                                { add_pin(ctx,NULL,-1); }
+#line 1406 "verilog.tab.cpp"
     break;
 
-  case 41:
-#line 186 "verilog.ypp" /* yacc.c:1646  */
-    { connectNodesToNextPort(); }
-#line 1547 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 40: /* sym_pin: '.' ID '(' ')'  */
+#line 172 "verilog.ypp"
+                                     {  }
+#line 1412 "verilog.tab.cpp"
     break;
 
-  case 42:
-#line 187 "verilog.ypp" /* yacc.c:1646  */
-    {  }
-#line 1553 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 41: /* $@2: %empty  */
+#line 173 "verilog.ypp"
+                 {  ctx->firstNet = ctx->module->nets.size(); }
+#line 1418 "verilog.tab.cpp"
     break;
 
-  case 43:
-#line 188 "verilog.ypp" /* yacc.c:1646  */
-    {  currentNodes.clear(); }
-#line 1559 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 42: /* sym_pin: '.' ID '(' $@2 net ')'  */
+#line 173 "verilog.ypp"
+                                                                                    { add_pin(ctx,(yyvsp[-4].sval),-1);}
+#line 1424 "verilog.tab.cpp"
     break;
 
-  case 44:
-#line 188 "verilog.ypp" /* yacc.c:1646  */
-    { connectNodes((yyvsp[-4].sval));}
-#line 1565 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 43: /* sym_pin: '.' ID '[' INT ']' '(' ')'  */
+#line 174 "verilog.ypp"
+                                     { }
+#line 1430 "verilog.tab.cpp"
     break;
 
-  case 45:
-#line 189 "verilog.ypp" /* yacc.c:1646  */
-    { }
-#line 1571 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 44: /* $@3: %empty  */
+#line 175 "verilog.ypp"
+                             {  ctx->firstNet = ctx->module->nets.size(); }
+#line 1436 "verilog.tab.cpp"
     break;
 
-  case 46:
-#line 190 "verilog.ypp" /* yacc.c:1646  */
-    {  currentNodes.clear(); }
-#line 1577 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 45: /* sym_pin: '.' ID '[' INT ']' '(' $@3 net ')'  */
+#line 175 "verilog.ypp"
+                                                                                    { add_pin(ctx,(yyvsp[-7].sval),(yyvsp[-5].ival));}
+#line 1442 "verilog.tab.cpp"
     break;
 
-  case 47:
-#line 190 "verilog.ypp" /* yacc.c:1646  */
-    { connectNodes(busNodeName((yyvsp[-7].sval),(yyvsp[-5].ival)));}
-#line 1583 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 46: /* sym_pin_list: %empty  */
+#line 178 "verilog.ypp"
+                                 {}
+#line 1448 "verilog.tab.cpp"
     break;
 
-  case 48:
-#line 193 "verilog.ypp" /* yacc.c:1646  */
-    {}
-#line 1589 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 47: /* sym_pin_list: sym_pin  */
+#line 179 "verilog.ypp"
+                                 { }
+#line 1454 "verilog.tab.cpp"
     break;
 
-  case 49:
-#line 194 "verilog.ypp" /* yacc.c:1646  */
-    { }
-#line 1595 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 48: /* sym_pin_list: sym_pin_list ',' sym_pin  */
+#line 180 "verilog.ypp"
+                                 { }
+#line 1460 "verilog.tab.cpp"
     break;
 
-  case 50:
-#line 195 "verilog.ypp" /* yacc.c:1646  */
-    { }
-#line 1601 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 49: /* type: INPUT  */
+#line 184 "verilog.ypp"
+           {(yyval.ival)=INPUT;}
+#line 1466 "verilog.tab.cpp"
     break;
 
-  case 51:
-#line 199 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=INPUT;}
-#line 1607 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 50: /* type: OUTPUT  */
+#line 185 "verilog.ypp"
+             {(yyval.ival)=OUTPUT;}
+#line 1472 "verilog.tab.cpp"
     break;
 
-  case 52:
-#line 200 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=OUTPUT;}
-#line 1613 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 51: /* type: INOUT  */
+#line 186 "verilog.ypp"
+             {(yyval.ival)=INOUT;}
+#line 1478 "verilog.tab.cpp"
     break;
 
-  case 53:
-#line 201 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=INOUT;}
-#line 1619 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 52: /* type: WIRE  */
+#line 187 "verilog.ypp"
+             {(yyval.ival)=WIRE;}
+#line 1484 "verilog.tab.cpp"
     break;
 
-  case 54:
-#line 202 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=WIRE;}
-#line 1625 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 53: /* type: WAND  */
+#line 188 "verilog.ypp"
+             {(yyval.ival)=WAND;}
+#line 1490 "verilog.tab.cpp"
     break;
 
-  case 55:
-#line 203 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=WAND;}
-#line 1631 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 54: /* type: WOR  */
+#line 189 "verilog.ypp"
+             {(yyval.ival)=WOR;}
+#line 1496 "verilog.tab.cpp"
     break;
 
-  case 56:
-#line 204 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=WOR;}
-#line 1637 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 55: /* type: TRI  */
+#line 190 "verilog.ypp"
+             {(yyval.ival)=TRI;}
+#line 1502 "verilog.tab.cpp"
     break;
 
-  case 57:
-#line 205 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=TRI;}
-#line 1643 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 56: /* type: REG  */
+#line 191 "verilog.ypp"
+             {(yyval.ival)=REG;}
+#line 1508 "verilog.tab.cpp"
     break;
 
-  case 58:
-#line 206 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=REG;}
-#line 1649 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 57: /* type: SUPPLY1  */
+#line 192 "verilog.ypp"
+              {(yyval.ival)=SUPPLY1;}
+#line 1514 "verilog.tab.cpp"
     break;
 
-  case 59:
-#line 207 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=SUPPLY1;}
-#line 1655 "verilog.tab.cpp" /* yacc.c:1646  */
+  case 58: /* type: SUPPLY0  */
+#line 193 "verilog.ypp"
+              {(yyval.ival)=SUPPLY0;}
+#line 1520 "verilog.tab.cpp"
     break;
 
-  case 60:
-#line 208 "verilog.ypp" /* yacc.c:1646  */
-    {(yyval.ival)=SUPPLY0;}
-#line 1661 "verilog.tab.cpp" /* yacc.c:1646  */
-    break;
 
+#line 1524 "verilog.tab.cpp"
 
-#line 1665 "verilog.tab.cpp" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1674,25 +1535,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -1703,50 +1562,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (scanner, ctx, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -1761,7 +1584,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, scanner, ctx);
           yychar = YYEMPTY;
         }
     }
@@ -1775,12 +1598,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -1797,13 +1619,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -1817,7 +1640,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, ctx);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1829,7 +1652,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1840,33 +1663,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (scanner, ctx, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, scanner, ctx);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -1875,235 +1702,87 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, ctx);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 210 "verilog.ypp" /* yacc.c:1906  */
+
+#line 195 "verilog.ypp"
 
 
-void record_type(int x){
+void record_type(hcmParseContext* ctx, int x){
   if(x==INPUT){
-    current_range.dir=IN;
+    ctx->range.dir=IN;
   }else if(x==OUTPUT){
-    current_range.dir=OUT;
+    ctx->range.dir=OUT;
   }else if(x==INOUT){
-    current_range.dir=IN_OUT;
+    ctx->range.dir=IN_OUT;
   }
 }
 
-void createInstance(const char *name) {
-  current_instance = current_cell->createInst(name,masterName);
-  if (!current_instance) {
-    fprintf(stderr,"\ncreateInstance: Failed to create instance: %s of master: %s in file %s line %d\n", name, masterName, current_file,vlog_lineno);
-    exit(1);
-  }
+void add_stmt(hcmParseContext* ctx, hcmParsedStmtKind kind, const char* name, int upper, int lower) {
+  hcmParsedStmt stmt;
+  stmt.kind = kind;
+  stmt.line = ctx->line;
+  stmt.name = name;
+  stmt.master = ctx->master;
+  stmt.upper = upper;
+  stmt.lower = lower;
+  stmt.dir = (kind == STMT_SIGNAL) ? ctx->range.dir : NOT_PORT;
+  stmt.firstPin = ctx->module->pins.size();
+  stmt.numPins = 0;
+  ctx->module->stmts.push_back(stmt);
 }
 
-void add_new_bus(const char *name){
-  if(current_range.lower < 0) {
-    hcmNode* n = current_cell->getNode(name);
-    if (!n) {
-      n = current_cell->createNode(name);
-      if (!n) {
-	fprintf(stderr,"\nadd_new_bus: Failed to create node: %s in file %s line %d\n", name, current_file,vlog_lineno);
-	exit(1);      
-      }
-    }
-    if( current_range.dir!= NOT_PORT){
-      n->createPort(current_range.dir);
-    }
-    return;
-  }
-  current_cell->createBus(name,current_range.upper,current_range.lower,current_range.dir);
-  curCellBusses[name] = pair<int,int>(current_range.upper,current_range.lower);
+void add_port(hcmParseContext* ctx, const char* name) {
+  ctx->module->ports.push_back(ctx->file->newString(name));
 }
 
-void connectNodes(string portName) {
-  if (currentNodes.size() <= 1) {
-    if (currentNodes.empty() || !currentNodes[0]) {
-      fprintf(stderr,"\nconnectNodes: The node is not available in file %s line %d\n",current_file,vlog_lineno);
-      exit(1);
-    }
-    current_cell->connect(current_instance,currentNodes[0],portName);
-  } else {
-    vector<hcmPort*> availablePorts = current_instance->getAvailablePorts(portName);
-    unsigned int availablePortsNum = availablePorts.size();
-    if(availablePortsNum==0){
-      fprintf(stderr,"\nconnectNodes: The port is not available in file %s line %d\n",current_file,vlog_lineno);
-      exit(1);
-    }
-    if(availablePortsNum < currentNodes.size()){
-      fprintf(stderr,"\nconnectNodes: The width: %d of port: %s is not sufficient for connecting nodes: %lu in file %s line %d\n",
-	      availablePortsNum, portName.c_str(), currentNodes.size(), current_file,vlog_lineno);
-      for (unsigned int i = 0; i < currentNodes.size(); i++) {
-	if (currentNodes[i]) {
-	  fprintf(stderr, "  node: %s\n", currentNodes[i]->getName().c_str());
-	} else {
-	  fprintf(stderr, "  node: NULL\n");
-	}
-      }
-      exit(1);
-    }
-    int m = currentNodes.size() - 1;
-    for(int i = 0;i<=m;i++) {
-      current_cell->connect(current_instance,currentNodes[i],availablePorts[i]->getName());
-    }
-  }
-  currentNodes.clear();
+void add_net(hcmParseContext* ctx, const char* name, int left, int right, bool constant) {
+  hcmParsedNet net = { name, left, right, constant };
+  ctx->module->nets.push_back(net);
 }
 
-/* connect based on order of ports */
-void connectNodesToNextPort() {
-  string portName;
-  if (designCellPortsListMap[global_design].find(masterName) == designCellPortsListMap[global_design].end()) {
-    fprintf(stderr,"\nconnectNodesToNextPort: No ports for master %s in file %s line %d\n",
-	    masterName, current_file,vlog_lineno);
-    exit(1);
-  }
-  if (designCellPortsListMap[global_design][masterName].size() <= (unsigned)curPortIdx) {
-    fprintf(stderr,"\nconnectNodesToNextPort: Not enough ports for master %s (%ld <= %d) in file %s line %d\n",
-	    masterName, designCellPortsListMap[global_design][masterName].size(), curPortIdx, current_file,vlog_lineno);
-    exit(1);
-  }
-  connectNodes(designCellPortsListMap[global_design][masterName][curPortIdx++]);
+void add_pin(hcmParseContext* ctx, const char* port, int bit) {
+  hcmParsedPin pin;
+  pin.port = port;
+  pin.bit = bit;
+  pin.line = ctx->line;
+  pin.firstNet = ctx->firstNet;
+  pin.numNets = ctx->module->nets.size() - ctx->firstNet;
+  ctx->module->pins.push_back(pin);
 }
 
 string busNodeName(string busName, int index){
-        
-  ostringstream result;
-  result << busName << '[' << index << ']';
-  return result.str();
-}
-
-void pushBus(const char* busName, int left, int right) {
-  string nodeName;
-
-  // we may get a signal name but it is a predefined bus...
-  if (left < 0) {
-    map< string, pair<int, int> >::const_iterator cbI = curCellBusses.find(busName);
-    if (cbI != curCellBusses.end()) {
-      left = (*cbI).second.first;
-      right = (*cbI).second.second;
-    }
-  }
-  if (left >= right) {
-    for (int i = left; i>=right ; i--) {
-      hcmNode *node;
-      if (left >= 0)
-	nodeName = busNodeName(busName,i);
-      else 
-	nodeName = busName;
-
-      node = current_cell->getNode(nodeName);
-#ifdef IMPLICIT_WIRES
-      if (!node) {
-	node = current_cell->createNode(nodeName);
-      }
-#endif	
-      if (!node) {
-	fprintf(stderr,"\nError finding node %s in file %s line %d \n",
-		nodeName.c_str(), current_file,vlog_lineno);
-	exit(1);
-      }
-      currentNodes.push_back(node);
-    }
-  } else {
-    for (int i = left; i<=right ; i++) {
-      nodeName = busNodeName(busName,i);
-      hcmNode *node = current_cell->getNode(nodeName);
-#ifdef IMPLICIT_WIRES
-      if (!node) {
-	node = current_cell->createNode(nodeName);
-      }
-#endif	
-      if (!node) {
-	fprintf(stderr,"\nError finding node %s in file %s line %d \n",
-		nodeName.c_str(), current_file,vlog_lineno);
-	exit(1);
-      }
-      currentNodes.push_back(node);
-    }
-  }
+  return busName + '[' + to_string(index) + ']';
 }
 
-void pushBinaryBus(const char* binaryBusChar){
-  string binaryBus = binaryBusChar;
-  size_t i = binaryBus.find("'");
-  if( i == std::string::npos ) {
-    fprintf(stderr,"\nError in constant (no \"'\") in file %s line %d \n",current_file,vlog_lineno);
-    exit(1);
-  }
-
-  string base = binaryBus.substr(i+1,i+1);
-  string busLen = binaryBus.substr(0,i);
-  string valStr = binaryBus.substr(i+2);
-  unsigned long int val;
-  switch ((base.c_str())[0]) {
-  case 'b': val = strtoull(valStr.c_str(), NULL, 2); break;
-  case 'd': val = strtoull(valStr.c_str(), NULL, 10); break;
-  case 'h': val = strtoull(valStr.c_str(), NULL, 16); break;
-  default:
-    fprintf(stderr,"\nError in unknwon base %s of constant file %s line %d \n", 
-	    base.c_str(), current_file,vlog_lineno);
-    exit(1);
-  }
-
-  // convert the value to binary bus of width "bus length"
-  unsigned int numBits = atoi(busLen.c_str());
-  list<hcmNode*> busNodes;
-  for (unsigned int i = 0; i < numBits; i++) {
-    if (val % 2) {
-      busNodes.push_front(current_cell->getNode("VDD"));
-    } else {
-      busNodes.push_front(current_cell->getNode("VSS"));      
-    }
-    val = val >> 1;
-  }
-  // copy in order to currentNodes
-  /* string res; */
-  for (list<hcmNode*>::iterator lI = busNodes.begin(); lI != busNodes.end(); lI++) {
-    currentNodes.push_back(*lI);
-    /* res += (*lI)->getName() + string(","); */
-  }
-
-  /* fprintf(stderr,"\nEZ: converted %s to %s in file %s line %d \n",  */
-  /* 	  binaryBus.c_str(), res.c_str(), current_file, vlog_lineno); */
-
-}
-
-int 
-read_verilog(hcmDesign* design, const char *fn)
+hcmParsedFile* read_verilog_file(const char *fn)
 {
-  global_design = design;
-  extern FILE *vlog_in;
-  int ret;
-  extern int vlog_lineno;
-
-  vlog_in=fopen(fn,"r");
-  if(vlog_in==NULL){
+  FILE* in = fopen(fn,"r");
+  if(in==NULL){
     cerr << "Cannot open " << fn << endl;
-    return 0;
+    return NULL;
   }
-  current_file=(char*)fn;
-  vlog_lineno=1;  
-  if(vlog_parse()==0){
-    ret=1; 
+  hcmParsedFile* file = new hcmParsedFile();
+  file->fileName = fn;
+  hcmParseContext ctx(file);
+  yyscan_t scanner;
+  vlog_lex_init_extra(&ctx, &scanner);
+  vlog_set_in(in, scanner);
+  if(vlog_parse(scanner, &ctx)==0){
+    file->ok = true;
   } else {
     cerr << "Syntax Problem!\n";
-    ret=0;
+    file->ok = false;
   }
-  fclose(vlog_in);
-  return ret;
+  vlog_lex_destroy(scanner);
+  fclose(in);
+  return file;
 }
-
-
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_VLOG_VERILOG_TAB_HPP_INCLUDED
 # define YY_VLOG_VERILOG_TAB_HPP_INCLUDED
 /* Debug traces.  */
@@ -39,55 +44,65 @@
 #if YYDEBUG
 extern int vlog_debug;
 #endif
+/* "%code requires" blocks.  */
+#line 27 "verilog.ypp"
+
+struct hcmParseContext;
 
-/* Token type.  */
+#line 53 "verilog.tab.hpp"
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    INT = 258,
-    ID = 259,
-    MODULE = 260,
-    ENDMODULE = 261,
-    CONST = 262,
-    _ASSIGN = 263,
-    BUF = 264,
-    WIRE = 265,
-    WAND = 266,
-    WOR = 267,
-    TRI = 268,
-    REG = 269,
-    TRIREG = 270,
-    INPUT = 271,
-    OUTPUT = 272,
-    INOUT = 273,
-    SUPPLY1 = 274,
-    SUPPLY0 = 275
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    INT = 258,                     /* INT  */
+    ID = 259,                      /* ID  */
+    MODULE = 260,                  /* MODULE  */
+    ENDMODULE = 261,               /* ENDMODULE  */
+    CONST = 262,                   /* CONST  */
+    _ASSIGN = 263,                 /* _ASSIGN  */
+    BUF = 264,                     /* BUF  */
+    WIRE = 265,                    /* WIRE  */
+    WAND = 266,                    /* WAND  */
+    WOR = 267,                     /* WOR  */
+    TRI = 268,                     /* TRI  */
+    REG = 269,                     /* REG  */
+    TRIREG = 270,                  /* TRIREG  */
+    INPUT = 271,                   /* INPUT  */
+    OUTPUT = 272,                  /* OUTPUT  */
+    INOUT = 273,                   /* INOUT  */
+    SUPPLY1 = 274,                 /* SUPPLY1  */
+    SUPPLY0 = 275                  /* SUPPLY0  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
 union YYSTYPE
 {
-#line 31 "verilog.ypp" /* yacc.c:1909  */
+#line 31 "verilog.ypp"
 
     int ival;
     char *sval;
-    hcmInstance *instance;
-    hcmCell  *cell;
-    hcmInstPort *sym_pin;
 
-#line 83 "verilog.tab.hpp" /* yacc.c:1909  */
+#line 95 "verilog.tab.hpp"
+
 };
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
 
-extern YYSTYPE vlog_lval;
 
-int vlog_parse (void);
+
+int vlog_parse (void* scanner, hcmParseContext* ctx);
+
 
 #endif /* !YY_VLOG_VERILOG_TAB_HPP_INCLUDED  */
@@ -1,6 +1,25 @@
 #include "hcm.h"
+#include "hcmCellBuilder.h"
+#include "hcmCompactNetlist.h"
+#include "hcmFingerprint.h"
+#include "hcmOccIterator.h"
+#include "hcmOccTree.h"
+#include "hcmSnapshot.h"
+#include "flat.h"
+#include "gen.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
 using namespace std;
 
+// the flattener prints its comments when set
+bool verbose = false;
+
 void testParsing() {
 	hcmDesign* d = new hcmDesign("MyDesign");
 	d->parseStructuralVerilog("myrisc.v");
@@ -8,8 +27,1194 @@ void testParsing() {
 	delete d;
 }
 
+void testCompactNetlist() {
+	hcmDesign* d = new hcmDesign("CompactDesign");
+	hcmCell* and2 = d->createCell("and2");
+	hcmPort* a = and2->createNode("A")->createPort(IN);
+	hcmPort* b = and2->createNode("B")->createPort(IN);
+	hcmPort* y = and2->createNode("Y")->createPort(OUT);
+	hcmCell* pad = d->createCell("pad");
+	hcmPort* p = pad->createNode("P")->createPort(IN_OUT);
+	hcmCell* top = d->createCell("top");
+	top->createNode("in1")->createPort(IN);
+	top->createNode("in2")->createPort(IN);
+	top->createNode("out")->createPort(OUT);
+	top->createNode("n");
+	hcmInstance* u1 = top->createInst("u1", and2);
+	hcmInstance* u2 = top->createInst("u2", and2);
+	hcmInstance* u3 = top->createInst("u3", pad);
+	top->connect(u1, top->getNode("in1"), a);
+	top->connect(u1, top->getNode("in2"), b);
+	top->connect(u1, top->getNode("n"), y);
+	top->connect(u2, top->getNode("n"), a);
+	top->connect(u2, top->getNode("in2"), b);
+	top->connect(u2, top->getNode("out"), y);
+	top->connect(u3, top->getNode("out"), p);
+
+	// nets (with VDD and VSS) instances and pins are numbered by name, masters as they are met
+	hcmCompactNetlist cn(top);
+	assert(cn.getCell() == top && !cn.isStale());
+	assert(cn.numNets() == 6 && cn.numInsts() == 3 && cn.numPins() == 7 && cn.numMasters() == 2);
+	int in1 = cn.getNetIndex(top->getNode("in1")), in2 = cn.getNetIndex(top->getNode("in2"));
+	int n = cn.getNetIndex(top->getNode("n")), out = cn.getNetIndex(top->getNode("out"));
+	assert(in1 == 2 && in2 == 3 && n == 4 && out == 5);
+	assert(cn.getNetPortDir(in1) == IN && cn.getNetPortDir(n) == NOT_PORT && cn.getNetPortDir(out) == OUT);
+	assert(cn.getInstIndex(u1) == 0 && cn.getInstIndex(u2) == 1 && cn.getInstIndex(u3) == 2);
+	assert(cn.getInst(2) == u3 && cn.getNet(n) == top->getNode("n"));
+	assert(cn.getMaster(cn.getInstMaster(0)) == and2 && cn.getInstMaster(1) == cn.getInstMaster(0));
+	assert(cn.getMaster(cn.getInstMaster(2)) == pad);
+	assert(cn.getInstIndex(d->createCell("other")->createInst("u1", and2)) == -1);
+	assert(cn.getNetIndex(and2->getNode("A")) == -1);
+
+	// the pins of an instance are by port name, each on its instance and net
+	assert(cn.instPinEnd(0) - cn.instPinBegin(0) == 3 && cn.instPinBegin(1) == cn.instPinEnd(0));
+	for(int pin = 0; pin < cn.numPins(); pin++) {
+		hcmInstPort* ip = cn.getPin(pin);
+		assert(cn.getInst(cn.getPinInst(pin)) == ip->getInst() && cn.getNet(cn.getPinNet(pin)) == ip->getNode());
+		assert(cn.getPinDir(pin) == ip->getPort()->getDirection());
+	}
+	assert(cn.getPin(cn.instPinBegin(0) + 2) == u1->getInstPort(y));
+
+	// the fanin of a net are its drivers, an IN_OUT pin is both a driver and a load
+	vector<int> faninN(cn.netFaninBegin(n), cn.netFaninEnd(n));
+	vector<int> fanoutN(cn.netFanoutBegin(n), cn.netFanoutEnd(n));
+	assert(faninN.size() == 1 && cn.getPin(faninN[0]) == u1->getInstPort(y));
+	assert(fanoutN.size() == 1 && cn.getPin(fanoutN[0]) == u2->getInstPort(a));
+	vector<int> faninOut(cn.netFaninBegin(out), cn.netFaninEnd(out));
+	vector<int> fanoutOut(cn.netFanoutBegin(out), cn.netFanoutEnd(out));
+	assert(faninOut.size() == 2 && cn.getPin(faninOut[1]) == u3->getInstPort(p));
+	assert(fanoutOut.size() == 1 && cn.getPin(fanoutOut[0]) == u3->getInstPort(p));
+	assert(cn.netFanoutEnd(in2) - cn.netFanoutBegin(in2) == 2 && cn.netFaninEnd(in2) == cn.netFaninBegin(in2));
+	assert(cn.instFaninEnd(1) - cn.instFaninBegin(1) == 2 && cn.instFanoutEnd(1) - cn.instFanoutBegin(1) == 1);
+	assert(cn.getPin(*cn.instFanoutBegin(1)) == u2->getInstPort(y));
+	assert(*cn.instFaninBegin(2) == *cn.instFanoutBegin(2));
+
+	// a change of the cell makes the view stale
+	top->createNode("n2");
+	assert(cn.isStale());
+	delete d;
+	cout << "Compact netlist test passed" << endl;
+}
+
+void testProperties() {
+	hcmDesign* d = new hcmDesign("PropDesign");
+	hcmCell* c = d->createCell("top");
+	hcmNode* n = c->createNode("n1");
+	hcmPropKey<double> delay("delay");
+
+	assert(n->setProp(delay, 1.5) == OK);
+	double v = 0;
+	assert(n->getProp(delay, v) == OK && v == 1.5);
+	// the string api and the key share the column
+	assert(n->getProp("delay", v) == OK && v == 1.5);
+	assert(n->setProp("delay", 2.5) == OK);
+	assert(d->getPropColumn(delay).get(n->getObjId()) && *d->getPropColumn(delay).get(n->getObjId()) == 2.5);
+	// one type per property name on an object
+	assert(n->setProp("delay", 3) == PROPERTY_EXISTS_WITH_DIFFERENT_TYPE);
+	assert(n->delProp<int>("delay") == PROPERTY_EXISTS_WITH_DIFFERENT_TYPE);
+	assert(c->setProp("delay", 3) == OK);
+	assert(n->delProp<double>("delay") == OK);
+	assert(n->getProp(delay, v) == NOT_FOUND);
+	assert(n->delProp(delay) == NOT_FOUND);
+
+	// a key registered after the store cached the keys of its name is still seen
+	hcmPropKey<double> slew("slew");
+	assert(n->setProp(slew, 0.5) == OK);
+	hcmPropKey<string> slewName("slew");
+	assert(n->setProp(slewName, string("fast")) == PROPERTY_EXISTS_WITH_DIFFERENT_TYPE);
+	assert(c->setProp(slewName, string("fast")) == OK);
+	assert(c->setProp(slew, 0.5) == PROPERTY_EXISTS_WITH_DIFFERENT_TYPE);
+	assert(n->delProp(slewName) == PROPERTY_EXISTS_WITH_DIFFERENT_TYPE);
+	assert(n->delProp(slew) == OK);
+
+	// a new object reusing the id of a deleted one has no stale values
+	assert(n->setProp(delay, 4.0) == OK);
+	c->deleteNode("n1");
+	hcmNode* m = c->createNode("n2");
+	assert(m->getProp(delay, v) == NOT_FOUND);
+
+	// keys made at once from several threads get one id per (name, type)
+	vector<thread> threads;
+	vector<int> ids(8);
+	for(int t = 0; t < (int)ids.size(); t++) {
+		threads.emplace_back([&ids, t]() {
+			for(int k = 0; k < 200; k++) {
+				hcmPropKey<int> key("threadKey" + to_string(k));
+				hcmPropKey<double> other("threadKey" + to_string(k));
+				assert(key.getId() != other.getId() && key.getName() == other.getName());
+			}
+			ids[t] = hcmPropKey<int>("threadKey7").getId();
+		});
+	}
+	for(thread& t : threads) {
+		t.join();
+	}
+	for(int id : ids) {
+		assert(id == ids[0] && hcmPropKeyBase::findKey("threadKey7", typeid(int).name()) == id);
+	}
+	assert(hcmPropKeyBase::findKeys("threadKey7").size() == 2);
+	assert(hcmPropKeyBase::sameNameKeys(ids[0]).size() == 1);
+	delete d;
+	cout << "Properties test passed" << endl;
+}
+
+void testInstPortOrdinals() {
+	hcmDesign* d = new hcmDesign("OrdinalDesign");
+	hcmCell* and2 = d->createCell("and2");
+	hcmPort* y = and2->createNode("Y")->createPort(OUT);
+	hcmPort* a = and2->createNode("A")->createPort(IN);
+	hcmPort* b = and2->createNode("B")->createPort(IN);
+	hcmCell* top = d->createCell("top");
+	hcmNode* n = top->createNode("n");
+	hcmInstance* u1 = top->createInst("u1", and2);
+
+	// ordinals are given in creation order
+	assert(y->getOrdinal() == 0 && a->getOrdinal() == 1 && b->getOrdinal() == 2);
+	assert(and2->getPortTable().size() == 3 && and2->getPortTable()[1] == a);
+
+	// the instPort of a master port is found by its ordinal and by its name
+	assert(!u1->isConnected(a) && u1->getInstPort(a) == NULL);
+	hcmInstPort* ipA = top->connect(u1, n, a);
+	assert(ipA && u1->isConnected(a) && u1->getInstPort(a) == ipA && u1->getInstPort("u1%A") == ipA);
+	assert(!u1->isConnected(b) && u1->getInstPort("u1%B") == NULL);
+	assert(top->connect(u1, n, a) == NULL && u1->getInstPorts().size() == 1);
+	vector<hcmPort*> avail = u1->getAvailablePorts();
+	assert(avail.size() == 2 && avail[0] == b && avail[1] == y);
+	assert(u1->getAvailablePorts("A").empty() && u1->getAvailablePorts("B").size() == 1);
+
+	// a port of another cell with the same ordinal is not connected
+	hcmCell* or2 = d->createCell("or2");
+	or2->createNode("Y")->createPort(OUT);
+	hcmPort* orA = or2->createNode("A")->createPort(IN);
+	assert(orA->getOrdinal() == a->getOrdinal() && !u1->isConnected(orA) && u1->getInstPort(orA) == NULL);
+
+	// disconnecting frees the slot
+	assert(hcmCell::disConnect(ipA) == OK);
+	assert(!u1->isConnected(a) && u1->getInstPort("u1%A") == NULL && u1->getInstPorts().empty());
+	assert(top->connect(u1, n, "A") != NULL && u1->isConnected(a));
+
+	// an ordinal is not reused, a port added after the instance is connected as well
+	and2->getNode("B")->deletePort();
+	assert(and2->getPortTable()[2] == NULL);
+	hcmPort* c = and2->createNode("C")->createPort(IN);
+	assert(c->getOrdinal() == 3 && and2->getPortTable().size() == 4);
+	hcmInstPort* ipC = top->connect(u1, n, c);
+	assert(ipC && u1->getInstPort(c) == ipC && u1->getInstPort("u1%C") == ipC);
+
+	// a bus is available only while none of its bits is connected
+	and2->createBus("D", 1, 0, IN);
+	assert(u1->getAvailablePorts("D").size() == 2);
+	assert(top->connect(u1, n, u1->getAvailablePorts("D")[0]) != NULL);
+	assert(u1->getAvailablePorts("D").empty());
+	delete d;
+	cout << "Instance port ordinals test passed" << endl;
+}
+
+void testCellBuilder() {
+	hcmDesign* d = new hcmDesign("BuilderDesign");
+	hcmCell* inv = d->createCell("inv");
+	hcmPort* a = inv->createNode("A")->createPort(IN);
+	hcmPort* y = inv->createNode("Y")->createPort(OUT);
+	hcmCell* top = d->createCell("top");
+
+	hcmCellBuilder b(top);
+	b.reserve(3, 2, 4);
+	int n = b.addNodes({"in", "mid", "out"}, NOT_PORT);
+	int i = b.addInsts({"u1", "u2"}, {inv, inv});
+	b.addPin(i, n, a);
+	b.addPin(i, n + 1, y);
+	b.addPin(i + 1, n + 1, a);
+	b.addPin(i + 1, n + 2, y);
+	assert(b.commit() == OK);
+	assert(top->getInst("u2") == b.getInst(i + 1));
+	assert(top->getNode("mid")->getInstPorts().size() == 2);
+	assert(b.getInst(i)->getInstPort("u1%Y")->getNode() == b.getNode(n + 1));
+
+	// a bad batch publishes nothing
+	int u3 = b.addInst("u3", inv);
+	b.addPin(u3, b.useNode(top->getNode("VDD")), a);
+	b.addPin(b.useInst(b.getInst(i)), n, a);
+	assert(b.commit() == BAD_PARAM && b.getErrors().size() == 1);
+	assert(top->getInst("u3") == NULL);
+
+	// two handles of one instance can't connect the same port
+	hcmCellBuilder again(top);
+	hcmInstance* u4 = top->createInst("u4", inv);
+	int h1 = again.useInst(u4), h2 = again.useInst(u4);
+	int in = again.useNode(top->getNode("in"));
+	again.addPin(h1, in, a);
+	again.addPin(h2, again.useNode(top->getNode("out")), a);
+	assert(again.commit() == BAD_PARAM && again.getErrors().size() == 1 && !u4->isConnected(a));
+	hcmCellBuilder other(top);
+	other.addPin(other.useInst(u4), other.useNode(top->getNode("in")), a);
+	other.addPin(other.useInst(u4), other.useNode(top->getNode("out")), y);
+	assert(other.commit() == OK && u4->getInstPort(a)->getNode() == top->getNode("in"));
+	assert(u4->getInstPort(y)->getNode() == top->getNode("out") && top->getNode("in")->getInstPorts().size() == 2);
+	delete d;
+	cout << "Cell builder test passed" << endl;
+}
+
+void testOccIterator() {
+	// the leaves and the nets of their pins are the instances of the flat cell and the nodes they are on
+	set<string> globals = {"VDD", "VSS"};
+	hcmDesign* d = new hcmDesign("OccDesign");
+	assert(d->parseStructuralVerilog("../ISCAS-85/stdcell.v") == BAD_PARAM);
+	assert(d->parseStructuralVerilog("../ISCAS-85/c1355high.v") == BAD_PARAM);
+	hcmCell* top = d->getCell("Circuit1355");
+	hcmCell* flat = hcmFlatten("flat", top, globals);
+	map<string, string> flatLeaves, occLeaves;
+	for(auto iI = flat->getInstances().begin(); iI != flat->getInstances().end(); ++iI) {
+		string& text = flatLeaves[iI->first];
+		text = iI->second->masterCell()->getName();
+		const map<string, hcmInstPort*>& pins = iI->second->getInstPorts();
+		for(auto pI = pins.begin(); pI != pins.end(); ++pI) {
+			text += " " + pI->second->getPort()->getName() + "=" + pI->second->getNode()->getName();
+		}
+	}
+	hcmOccIterator it(top, globals);
+	vector<string> order;
+	while(it.nextLeaf()) {
+		assert(it.depth() > 0 && it.inst(it.depth())->masterCell() == it.cell());
+		string& text = occLeaves[it.getHName()];
+		text = it.cell()->getName();
+		order.push_back(it.getHName());
+		for(auto nI = it.cell()->getNodes().begin(); nI != it.cell()->getNodes().end(); ++nI) {
+			hcmOccNet net, again;
+			if(it.getPinNet(nI->second, net)) {
+				assert(it.getPinNet(nI->second, again) && again == net);
+				text += " " + nI->first + "=" + it.getNetHName(net);
+			}
+		}
+	}
+	assert(!occLeaves.empty() && occLeaves == flatLeaves && order.size() == flatLeaves.size());
+
+	// every connected node of a cell above the leaves resolves to a node of the flat cell
+	hcmOccIterator frames(top, globals);
+	int numFrames = 0;
+	while(frames.nextFrame()) {
+		numFrames++;
+		if(frames.cell()->getInstances().empty()) {
+			continue;
+		}
+		for(auto nI = frames.cell()->getNodes().begin(); nI != frames.cell()->getNodes().end(); ++nI) {
+			hcmOccNet net;
+			if(nI->second->getInstPorts().empty()) {
+				continue;
+			}
+			assert(frames.getNodeNet(nI->second, net) && flat->getNode(frames.getNetHName(net)) != NULL);
+		}
+	}
+	assert(numFrames > (int)order.size() && !frames.nextFrame() && !frames.nextLeaf());
+	delete d;
+
+	// a global node missing in the top cell is the same net everywhere, other nodes are per occurrence
+	d = new hcmDesign("OccGlobalDesign");
+	hcmCell* inv = d->createCell("inv");
+	hcmPort* a = inv->createNode("A")->createPort(IN);
+	hcmPort* y = inv->createNode("Y")->createPort(OUT);
+	hcmCell* mid = d->createCell("mid");
+	hcmPort* i = mid->createNode("i")->createPort(IN);
+	hcmPort* o = mid->createNode("o")->createPort(OUT);
+	hcmNode* g = mid->createNode("G");
+	mid->connect(mid->createInst("x1", inv), mid->getNode("i"), a);
+	mid->connect(mid->getInst("x1"), g, y);
+	mid->connect(mid->createInst("x2", inv), g, a);
+	mid->connect(mid->getInst("x2"), mid->getNode("o"), y);
+	top = d->createCell("top");
+	hcmNode* t = top->createNode("t");
+	top->connect(top->createInst("m1", mid), t, i);
+	top->connect(top->getInst("m1"), t, o);
+	top->connect(top->createInst("m2", mid), t, i);
+	for(bool global : {true, false}) {
+		set<string> names;
+		if(global) {
+			names.insert("G");
+		}
+		hcmOccIterator occ(top, names);
+		vector<hcmOccNet> gNets;
+		vector<string> leaves;
+		while(occ.nextLeaf()) {
+			leaves.push_back(occ.getHName());
+			hcmOccNet net;
+			if(occ.inst(2)->getName() == "x1") {
+				assert(occ.getPinNet(inv->getNode("Y"), net));
+				assert(occ.getNetHName(net) == (global ? "G" : occ.getHName(1) + "/G"));
+				gNets.push_back(net);
+			}
+			else if(occ.inst(1)->getName() == "m1") {
+				assert(occ.getPinNet(inv->getNode("Y"), net) && occ.getNetHName(net) == "t");
+			}
+			else {
+				// o is not connected on m2
+				assert(!occ.getPinNet(inv->getNode("Y"), net) && occ.getPinNet(inv->getNode("A"), net));
+			}
+		}
+		assert((leaves == vector<string>{"m1/x1", "m1/x2", "m2/x1", "m2/x2"}));
+		assert(gNets.size() == 2 && (gNets[0] == gNets[1]) == global);
+	}
+	delete d;
+	cout << "Occurrence iterator test passed" << endl;
+}
+
+void testOccTree() {
+	set<string> globals = {"VDD", "VSS"};
+	hcmDesign* d = new hcmDesign("OccTreeDesign");
+	assert(d->parseStructuralVerilog("../ISCAS-85/stdcell.v") == BAD_PARAM);
+	assert(d->parseStructuralVerilog("../ISCAS-85/c1355high.v") == BAD_PARAM);
+	hcmCell* top = d->getCell("Circuit1355");
+	hcmOccTree tree(top);
+
+	// instance occurrences are numbered in the order of the walk, the leaves are the flat instances
+	hcmOccIterator it(top, globals);
+	it.nextFrame();
+	hcmOccId id = 0;
+	hcmOccId numNodes = top->getNodes().size();
+	set<string> leaves, flatLeaves;
+	while(it.nextFrame()) {
+		vector<const hcmInstance*> path;
+		for(int l = 1; l <= it.depth(); l++) {
+			path.push_back(it.inst(l));
+		}
+		assert(tree.getInstOccId(path.begin(), path.end()) == id && tree.getInstOccName(id) == it.getHName());
+		vector<const hcmInstance*> back;
+		assert(tree.getInstOccPath(id, back) && back == path);
+		if(it.cell()->getInstances().empty()) {
+			leaves.insert(tree.getInstOccName(id));
+		}
+		numNodes += it.cell()->getNodes().size();
+		id++;
+	}
+	assert(id > 0 && tree.numInstOccs() == id && tree.numNodeOccs() == numNodes);
+	hcmCell* flat = hcmFlatten("flat", top, globals);
+	for(auto iI = flat->getInstances().begin(); iI != flat->getInstances().end(); ++iI) {
+		flatLeaves.insert(iI->first);
+	}
+	assert(leaves == flatLeaves);
+
+	// every node occurrence converts to its path and back, and has a name of its own
+	set<string> nodeNames;
+	for(hcmOccId n = 0; n < tree.numNodeOccs(); n++) {
+		vector<const hcmInstance*> path;
+		const hcmNode* node;
+		assert(tree.getNodeOccPath(n, path, node));
+		assert(tree.getNodeOccId(path.begin(), path.end(), node) == n);
+		nodeNames.insert(tree.getNodeOccName(n));
+		const hcmCell* cell = path.empty() ? top : path.back()->masterCell();
+		assert(cell->getNodes().at(node->getName()) == node);
+	}
+	assert(nodeNames.size() == tree.numNodeOccs());
+	vector<const hcmInstance*> none;
+	assert(tree.getNodeOccId(none.begin(), none.end(), top->getNode("VDD")) < top->getNodes().size());
+	assert(tree.getNodeOccName(0) == top->getNodes().begin()->first);
+
+	// ids out of range and paths that are not in the tree
+	vector<const hcmInstance*> path;
+	const hcmNode* node;
+	assert(!tree.getInstOccPath(tree.numInstOccs(), path) && tree.getInstOccName(tree.numInstOccs()).empty());
+	assert(!tree.getNodeOccPath(tree.numNodeOccs(), path, node) && tree.getNodeOccName(tree.numNodeOccs()).empty());
+	assert(tree.getInstOccId(none.begin(), none.end()) == HCM_NO_OCC);
+	const hcmInstance* first = top->getInstances().begin()->second;
+	vector<const hcmInstance*> twice = {first, first};
+	assert(tree.getInstOccId(twice.begin(), twice.end()) == HCM_NO_OCC);
+	// a node of another cell than the one at the end of the path
+	assert(tree.getNodeOccId(twice.begin(), twice.begin() + 1, top->getNode("VDD")) == HCM_NO_OCC);
+	assert(tree.getNodeOccId(none.begin(), none.end(), first->masterCell()->getNode("VDD")) == HCM_NO_OCC);
+	delete d;
+	cout << "Occurrence tree test passed" << endl;
+}
+
+class countingListener : public hcmChangeListener {
+	public:
+		int counts[DISCONNECTED + 1] = {};
+		void onChange(const hcmChange& change) { counts[change.type]++; }
+};
+
+void testJournal() {
+	hcmDesign* d = new hcmDesign("JournalDesign");
+	hcmCell* inv = d->createCell("inv");
+	hcmPort* a = inv->createNode("A")->createPort(IN);
+	hcmCell* top = d->createCell("top");
+	countingListener l;
+	d->getJournal().subscribe(&l);
+	d->getJournal().startRecording();
+
+	hcmGeneration invGen = inv->getGeneration();
+	hcmNode* n = top->createNode("n");
+	hcmInstance* u1 = top->createInst("u1", inv);
+	top->connect(u1, n, a);
+	assert(top->getGeneration() == d->getJournal().getGeneration());
+	assert(inv->getGeneration() == invGen);
+	assert(l.counts[NODE_CREATED] == 1 && l.counts[INST_CREATED] == 1 && l.counts[CONNECTED] == 1);
+
+	// deleting the instance reports its disconnection first
+	top->deleteInst("u1");
+	assert(l.counts[DISCONNECTED] == 1 && l.counts[INST_DELETED] == 1);
+	const vector<hcmChangeRecord>& records = d->getJournal().getRecords();
+	assert(records.size() == 5 && records[3].type == DISCONNECTED && records[4].type == INST_DELETED);
+	assert(records[4].inst == d->getNameTable().find("u1"));
+
+	d->getJournal().unsubscribe(&l);
+	delete d;
+	cout << "Journal test passed" << endl;
+}
+
+void testFingerprint() {
+	hcmDesign* d = new hcmDesign("FingerprintDesign");
+	hcmCell* inv = d->createCell("inv");
+	hcmPort* a = inv->createNode("A")->createPort(IN);
+	hcmPort* y = inv->createNode("Y")->createPort(OUT);
+	// buf1 and buf2 differ only by the names of the cell, its instances and its internal node
+	hcmCell* bufs[2];
+	for(int k = 0; k < 2; k++) {
+		string s = to_string(k);
+		bufs[k] = d->createCell("buf" + s);
+		hcmNode* in = bufs[k]->createNode("in");
+		in->createPort(IN);
+		hcmNode* out = bufs[k]->createNode("out");
+		out->createPort(OUT);
+		hcmNode* mid = bufs[k]->createNode("mid" + s);
+		hcmInstance* u1 = bufs[k]->createInst("u1_" + s, inv);
+		hcmInstance* u2 = bufs[k]->createInst("u2_" + s, inv);
+		bufs[k]->connect(u1, in, a);
+		bufs[k]->connect(u1, mid, y);
+		bufs[k]->connect(u2, mid, a);
+		bufs[k]->connect(u2, out, y);
+	}
+	set<string> globals = {"VDD", "VSS"};
+	hcmFingerprinter fp(d, globals);
+	assert(fp.getFingerprint(bufs[0]) == fp.getFingerprint(bufs[1]));
+	assert(fp.getFingerprint(bufs[0]) != fp.getFingerprint(inv));
+
+	// a change of the cell is noticed through its generation
+	hcmInstance* u2 = bufs[1]->getInst("u2_1");
+	delete u2->getInstPort(y);
+	bufs[1]->connect(u2, bufs[1]->getNode("mid1"), y);
+	assert(fp.getFingerprint(bufs[0]) != fp.getFingerprint(bufs[1]));
+	delete d;
+	cout << "Fingerprint test passed" << endl;
+}
+
+void testBus() {
+	hcmDesign* d = new hcmDesign("BusDesign");
+	hcmCell* reg = d->createCell("reg4");
+	hcmBus* q = reg->createBus("Q", 3, 0, OUT);
+	assert(q == reg->getBus("Q") && q->getWidth() == 4);
+	assert(q->getNode(2) == reg->getNode("Q[2]") && q->getNode(2)->getBus() == q);
+	assert(q->getNode(4) == NULL && q->getBitName(1) == "Q[1]");
+
+	// a bus port connects msb first
+	hcmCell* top = d->createCell("top");
+	hcmInstance* u = top->createInst("u", reg);
+	vector<hcmPort*> ports = u->getAvailablePorts("Q");
+	assert(ports.size() == 4 && ports[0] == q->getPort(3) && ports[3] == q->getPort(0));
+
+	delete reg->getNode("Q[1]");
+	assert(q->getNode(1) == NULL && q->getPorts().size() == 3);
+	reg->deleteBus("Q");
+	assert(reg->getBus("Q") == NULL && reg->getNode("Q[0]") == NULL);
+	delete d;
+	cout << "Bus test passed" << endl;
+}
+
+void testMemoryReport() {
+	hcmDesign* d = new hcmDesign("MemoryDesign");
+	hcmCell* inv = d->createCell("inv");
+	hcmPort* a = inv->createNode("A")->createPort(IN);
+	hcmCell* top = d->createCell("top");
+	top->createBus("in", 7, 0, IN);
+	for(int i = 0; i < 8; i++) {
+		hcmInstance* u = top->createInst("u" + to_string(i), inv);
+		top->connect(u, top->getNode("in[" + to_string(i) + "]"), a);
+	}
+	hcmMemoryReport r = d->memoryReport();
+	assert(r.cells.count == 2 && r.instances.count == 8 && r.instPorts.count == 8 && r.buses.count == 1);
+	// VDD and VSS in each cell
+	assert(r.nodes.count == 4 + 1 + 8 && r.ports.count == 1 + 8);
+	assert(r.totalBytes() > r.nodes.total() && r.nodes.instPortMapBytes > 0);
+	delete d;
+
+	// threads starting phases at once all count into the same phase of a name
+	hcmAllocPhase::reset();
+	vector<thread> threads;
+	for(int t = 0; t < 8; t++) {
+		threads.emplace_back([t]() {
+			hcmAllocPhase phase(t % 2 ? "odd" : "even");
+			for(int k = 0; k < 100; k++) {
+				hcmAllocPhase inner("inner" + to_string(k % 4));
+				delete new int(k);
+			}
+		});
+	}
+	for(thread& t : threads) {
+		t.join();
+	}
+	map<string, hcmAllocStats> stats = hcmAllocPhase::getStats();
+	assert(stats.count("odd") && stats.count("even") && stats.count("inner3"));
+	if(hcmAllocPhase::enabled()) {
+		assert(stats["inner0"].allocs >= 8 * 25 && stats["inner0"].bytes >= 8 * 25 * sizeof(int));
+	} else {
+		assert(stats["inner0"].allocs == 0);
+	}
+	cout << "Memory report test passed" << endl;
+}
+
+void testSnapshot() {
+	hcmDesign* d = new hcmDesign("SnapDesign");
+	hcmCell* inv = d->createCell("inv");
+	hcmPort* a = inv->createNode("A")->createPort(IN);
+	hcmCell* top = d->createCell("top");
+	top->createBus("in", 1, 0, IN);
+	hcmInstance* u = top->createInst("u", inv);
+	top->connect(u, top->getNode("in[1]"), a);
+	hcmPropKey<int> delay("snapDelay");
+	hcmPropKey<bool> leaf("snapLeaf");
+	u->setProp(delay, 7);
+	inv->setProp(leaf, true);
+
+	const char* fileName = "snapshot_test.snap";
+	assert(hcmSnapshot::write(d, fileName) == OK);
+	hcmSnapshot snap;
+	assert(snap.open(fileName) == OK);
+	assert(snap.numCells() == 2 && snap.numInsts() == 1 && snap.numPins() == 1);
+	assert(snap.findCell("inv") == 0 && snap.findCell("nope") == HCM_SNAP_NONE);
+
+	hcmDesign* l = snap.load();
+	assert(l != NULL && l->getName() == "SnapDesign");
+	hcmCell* lTop = l->getCell("top");
+	hcmInstance* lu = lTop->getInst("u");
+	assert(lu->masterCell() == l->getCell("inv") && lTop->getBus("in")->getWidth() == 2);
+	assert(lTop->getNode("in[1]")->getInstPorts().size() == 1 && lTop->getNode("in[1]")->getPort()->getDirection() == IN);
+	int v = 0;
+	bool b = false;
+	assert(lu->getProp(delay, v) == OK && v == 7);
+	assert(l->getCell("inv")->getProp(leaf, b) == OK && b);
+	delete l;
+	snap.close();
+
+	// the port order and the ordinals are kept, so a loaded library connects instances by order
+	hcmDesign* lib = new hcmDesign("SnapLib");
+	assert(lib->parseStructuralVerilog("../ISCAS-85/stdcell.v") == BAD_PARAM);
+	assert(hcmSnapshot::write(lib, fileName) == OK);
+	assert(snap.open(fileName) == OK);
+	hcmDesign* loaded = snap.load();
+	snap.close();
+	assert(loaded != NULL);
+	for(auto cI = lib->getCells().begin(); cI != lib->getCells().end(); ++cI) {
+		hcmCell* lc = loaded->getCell(cI->first);
+		const vector<string>* order = cI->second->getPortOrder();
+		assert(lc && (order == NULL) == (lc->getPortOrder() == NULL) && (!order || *order == *lc->getPortOrder()));
+		const vector<hcmPort*>& ports = cI->second->getPortTable();
+		assert(ports.size() == lc->getPortTable().size());
+		for(size_t p = 0; p < ports.size(); p++) {
+			assert(ports[p]->getName() == lc->getPortTable()[p]->getName());
+		}
+	}
+	assert(lib->parseStructuralVerilog("../ISCAS-85/c1355high.v") == BAD_PARAM);
+	assert(loaded->parseStructuralVerilog("../ISCAS-85/c1355high.v") == BAD_PARAM);
+	const map<string, hcmInstance*>& libInsts = lib->getCell("Circuit1355")->getInstances();
+	const map<string, hcmInstance*>& loadedInsts = loaded->getCell("Circuit1355")->getInstances();
+	assert(!libInsts.empty() && libInsts.size() == loadedInsts.size());
+	for(auto iI = libInsts.begin(); iI != libInsts.end(); ++iI) {
+		const map<string, hcmInstPort*>& pins = iI->second->getInstPorts();
+		const map<string, hcmInstPort*>& loadedPins = loadedInsts.at(iI->first)->getInstPorts();
+		assert(pins.size() == loadedPins.size());
+		for(auto pI = pins.begin(); pI != pins.end(); ++pI) {
+			assert(pI->second->getNode()->getName() == loadedPins.at(pI->first)->getNode()->getName());
+		}
+	}
+	delete loaded;
+	delete lib;
+	remove(fileName);
+
+	// not a snapshot
+	assert(snap.open("main.cpp") == BAD_PARAM && !snap.getError().empty());
+
+	// a damaged record is found by load(), the header and the sections are still good
+	assert(hcmSnapshot::write(d, fileName) == OK);
+	string image;
+	{
+		ifstream in(fileName, ios::binary);
+		image.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+	}
+	const hcmSnapHeader* header = (const hcmSnapHeader*)image.data();
+	size_t cellsAt = header->sections[SNAP_CELLS].offset, pinsAt = header->sections[SNAP_PINS].offset;
+	size_t nodesAt = header->sections[SNAP_NODES].offset;
+	size_t propsAt = header->sections[SNAP_PROPS].offset, stringsSize = header->sections[SNAP_STRINGS].count;
+	vector<function<void(string&)> > damages = {
+		[&](string& f) { ((hcmSnapCell*)&f[cellsAt])->numNodes = 1000; },
+		[&](string& f) { ((hcmSnapCell*)&f[cellsAt])->name = stringsSize; },
+		[&](string& f) { ((hcmSnapPin*)&f[pinsAt])->port = 1000; },
+		[&](string& f) { ((hcmSnapNode*)&f[nodesAt])->ordinal = HCM_SNAP_NONE; },
+		[&](string& f) { ((hcmSnapProp*)&f[propsAt])->kind = 17; },
+		[&](string& f) { ((hcmSnapProp*)&f[propsAt])->key = 5; },
+	};
+	for(auto dI = damages.begin(); dI != damages.end(); ++dI) {
+		string damaged = image;
+		(*dI)(damaged);
+		ofstream(fileName, ios::binary | ios::trunc) << damaged;
+		assert(snap.open(fileName) == OK);
+		assert(snap.load() == NULL && !snap.getError().empty());
+		snap.close();
+	}
+	remove(fileName);
+	delete d;
+	cout << "Snapshot test passed" << endl;
+}
+
+void testMultiFileParsing() {
+	// the top comes first, its master is in the other file
+	const char* topFile = "multi_top_test.v";
+	const char* libFile = "multi_lib_test.v";
+	ofstream(topFile) << "module top(a, y);\ninput [1:0] a;\noutput y;\nand2 u1(a[1], a[0], y);\nendmodule\n";
+	ofstream(libFile) << "module and2(A, B, Y);\ninput A, B;\noutput Y;\nendmodule\n";
+
+	hcmDesign* d = new hcmDesign("MultiDesign");
+	vector<string> files = {topFile, libFile};
+	assert(d->parseStructuralVerilog(files, 2) == BAD_PARAM);
+	hcmCell* top = d->getCell("top");
+	hcmInstance* u1 = top->getInst("u1");
+	assert(u1 != NULL && u1->masterCell() == d->getCell("and2"));
+	assert(u1->getInstPort("u1%Y")->getNode() == top->getNode("y"));
+	assert(u1->getInstPort("u1%A")->getNode() == top->getBus("a")->getNode(1));
+
+	// a missing file is reported, the others are still read
+	hcmDesign* m = new hcmDesign("MissingDesign");
+	files = {libFile, "no_such_file.v"};
+	assert(m->parseStructuralVerilog(files) == OK && m->getCell("and2") != NULL);
+	remove(topFile);
+	remove(libFile);
+	delete m;
+	delete d;
+	cout << "Multi file parsing test passed" << endl;
+}
+
+// the printed design read from \a files by \a reader, through the parse cache in \a cacheDir if given.
+// \a cacheHits gets the files read from the cache
+static string parsedDesignText(const vector<string>& files, hcmVerilogReader reader, const string& cacheDir = "",
+                               size_t* cacheHits = NULL) {
+	hcmDesign* d = new hcmDesign("ReaderDesign");
+	d->setParseCacheDir(cacheDir);
+	assert(d->parseStructuralVerilog(files, 1, reader) == BAD_PARAM);
+	stringstream text;
+	streambuf* out = cout.rdbuf(text.rdbuf());
+	d->printInfo();
+	cout.rdbuf(out);
+	if(cacheHits) {
+		*cacheHits = d->getParseCacheHits();
+	}
+	delete d;
+	return text.str();
+}
+
+void testFastReader() {
+	vector<vector<string> > inputs = {{"myrisc.v"}, {"test_inv_call.v"}};
+	for(string c : {"1355", "1908", "2670", "3540", "5315", "6288", "7552"}) {
+		inputs.push_back({"../ISCAS-85/stdcell.v", "../ISCAS-85/c" + c + "high.v"});
+	}
+	for(string c : {"0409", "0410", "1355", "1356", "1404", "1405", "2670", "2671", "2672", "2806", "2807"}) {
+		inputs.push_back({"../wet02/verilog inputs/stdcell.v", "../wet02/verilog inputs/c" + c + ".v"});
+	}
+	// the inputs of the equivalence checker tests
+	DIR* dir = opendir("../wet02/utilities/OB_tests");
+	assert(dir);
+	vector<string> obTests;
+	for(struct dirent* e = readdir(dir); e; e = readdir(dir)) {
+		string name = e->d_name;
+		if(name.size() > 2 && name.compare(name.size() - 2, 2, ".v") == 0) {
+			obTests.push_back(name);
+		}
+	}
+	closedir(dir);
+	sort(obTests.begin(), obTests.end());
+	assert(obTests.size() == 23);
+	for(const string& name : obTests) {
+		inputs.push_back({"../wet02/verilog inputs/stdcell.v", "../wet02/utilities/OB_tests/" + name});
+	}
+	for(auto it = inputs.begin(); it != inputs.end(); ++it) {
+		assert(parsedDesignText(*it, VLOG_READER_FAST) == parsedDesignText(*it, VLOG_READER_BISON));
+	}
+	cout << "Fast reader test passed" << endl;
+}
+
+void testStringPool() {
+	hcmStringPool pool;
+	int a = pool.intern("a");
+	string longName(100000, 'x');
+	int l = pool.intern(longName);
+	assert(pool.intern(string("a")) == a && pool.find(longName) == l && pool.find("b") == -1);
+	assert(pool.get(l) == longName && pool.get(a).data()[1] == 0);
+	assert(pool.getStats().lookups == 3 && pool.getStats().hits == 1 && pool.getStats().bytes == 2 + longName.size() + 1);
+
+	// the name table of a design is a pool
+	hcmDesign* d = new hcmDesign("PoolDesign");
+	hcmCell* c = d->createCell("c");
+	assert(d->getNameTable().getName(c->getNameId()) == "c" && d->getNameTable().intern("c") == c->getNameId());
+	assert(d->getNameTable().getStats().hits > 0);
+	delete d;
+
+	CharBuf buf;
+	buf.init();
+	for(size_t i = 0; i < longName.size(); i++) {
+		buf.append_char('x');
+	}
+	assert(buf.str() == longName);
+	cout << "String pool test passed" << endl;
+}
+
+void testPortOrder() {
+	const char* vFile = "port_order_test.v";
+	ofstream(vFile) << "module mux(S, D, Y);\ninput S;\ninput [1:0] D;\noutput Y;\nendmodule\n"
+		"module top(s, d, y);\ninput s;\ninput [1:0] d;\noutput y;\nmux u1(s, d, y);\nendmodule\n";
+
+	hcmDesign* d = new hcmDesign("PortOrderDesign");
+	assert(d->parseStructuralVerilog(vFile) == BAD_PARAM);
+	hcmCell* mux = d->getCell("mux");
+	hcmCell* top = d->getCell("top");
+	assert(mux->getPortOrder() != NULL && mux->getPortOrder()->size() == 3);
+	assert(top->getBus("d") != NULL);
+
+	// a bus entry holds its bit ports by index
+	const vector<hcmPort*>* D = mux->getOrderedPorts(1);
+	assert(D != NULL && D->size() == 2 && (*D)[0] == mux->getBus("D")->getPort(1));
+	assert(mux->getOrderedPorts(3) == NULL);
+	hcmInstance* u1 = top->getInst("u1");
+	assert(u1->getInstPort("u1%S")->getNode() == top->getNode("s"));
+	assert(u1->getInstPort("u1%Y")->getNode() == top->getNode("y"));
+	assert(u1->getInstPort(string("u1%") + (*D)[1]->getName())->getNode() == top->getBus("d")->getNode(0));
+
+	// the table follows changes of the master
+	mux->setPortOrder({"S", "D", "Y", "E"});
+	assert(mux->getOrderedPorts(3)->empty());
+	mux->createNode("E")->createPort(IN);
+	assert(mux->getOrderedPorts(3)->size() == 1 && (*mux->getOrderedPorts(3))[0] == mux->getPort("E"));
+	assert(top->getPortOrder() != NULL && d->getCell("top")->getOrderedPorts(0)->size() == 1);
+	remove(vFile);
+	delete d;
+	cout << "Port order test passed" << endl;
+}
+
+// the printed cell \a name of \a d
+static string cellText(hcmDesign* d, const string& name) {
+	stringstream text;
+	streambuf* out = cout.rdbuf(text.rdbuf());
+	d->getCell(name)->printInfo();
+	cout.rdbuf(out);
+	return text.str();
+}
+
+void testVerilogLibrary() {
+	hcmDesign* eager = new hcmDesign("EagerDesign");
+	vector<string> files = {"../ISCAS-85/stdcell.v", "../ISCAS-85/c1355high.v"};
+	assert(eager->parseStructuralVerilog(files) == BAD_PARAM);
+
+	// only the cells used by the circuit are built
+	hcmDesign* lazy = new hcmDesign("LazyDesign");
+	assert(lazy->addVerilogLibrary("../ISCAS-85/stdcell.v") == OK);
+	assert(lazy->addVerilogLibrary("no_such_file.v") == BAD_PARAM);
+	assert(lazy->parseStructuralVerilog("../ISCAS-85/c1355high.v") == BAD_PARAM);
+	assert(lazy->getCells().size() < eager->getCells().size());
+	for(auto cI = lazy->getCells().begin(); cI != lazy->getCells().end(); ++cI) {
+		assert(cellText(lazy, cI->first) == cellText(eager, cI->first));
+	}
+
+	// an unused module is built when asked for
+	assert(lazy->getCells().count("dff") == 0);
+	assert(lazy->getCell("dff") != NULL && cellText(lazy, "dff") == cellText(eager, "dff"));
+	assert(lazy->getCell("no_such_cell") == NULL);
+	delete lazy;
+	delete eager;
+	cout << "Verilog library test passed" << endl;
+}
+
+// the entries of the parse cache \a dir, cleared or overwritten with junk if asked. \a smallest gets the
+// path of the smallest entry
+static int cacheEntries(const string& dir, bool clear = false, bool corrupt = false, string* smallest = NULL) {
+	int n = 0;
+	off_t smallestSize = 0;
+	DIR* d = opendir(dir.c_str());
+	for(struct dirent* e = d ? readdir(d) : NULL; e; e = readdir(d)) {
+		if(e->d_name[0] != '.') {
+			n++;
+			string path = dir + "/" + e->d_name;
+			struct stat st;
+			if(smallest && stat(path.c_str(), &st) == 0 && (smallest->empty() || st.st_size < smallestSize)) {
+				*smallest = path;
+				smallestSize = st.st_size;
+			}
+			if(clear) {
+				remove(path.c_str());
+			}
+			else if(corrupt) {
+				ofstream(dir + "/" + e->d_name) << "not an entry";
+			}
+		}
+	}
+	if(d) {
+		closedir(d);
+	}
+	return n;
+}
+
+void testParseCache() {
+	const string dir = "parse_cache_test";
+	const char* topFile = "cache_top_test.v";
+	cacheEntries(dir, true);
+	ofstream(topFile) << "module top(a, b, y);\ninput a, b;\noutput y;\nand2 u1(a, b, y);\nendmodule\n";
+	vector<string> files = {"../ISCAS-85/stdcell.v", "../ISCAS-85/c1355high.v", topFile};
+
+	// the first run fills the cache, the next one reads all the files from it
+	size_t hits = 0;
+	string parsed = parsedDesignText(files, VLOG_READER_BISON);
+	assert(parsedDesignText(files, VLOG_READER_BISON, dir, &hits) == parsed && hits == 0);
+	assert(cacheEntries(dir) == 3);
+	assert(parsedDesignText(files, VLOG_READER_FAST, dir, &hits) == parsed && hits == 3);
+	assert(cacheEntries(dir) == 3);
+
+	// an entry missing a name is parsed again. the top is the smallest entry, its words are after the header
+	// of hcmParseCache.cpp and the strings, the name of its first statement is after the 3 ports
+	string topEntry;
+	cacheEntries(dir, false, false, &topEntry);
+	string entry;
+	{
+		ifstream in(topEntry, ios::binary);
+		entry.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+	}
+	uint64_t stringBytes = *(const uint64_t*)&entry[40];
+	uint32_t* words = (uint32_t*)&entry[48 + ((stringBytes + 3) & ~(uint64_t)3)];
+	assert(words[2] == 3);
+	words[3 + 3 + 1 + 2] = 0xffffffffu;
+	ofstream(topEntry, ios::binary | ios::trunc) << entry;
+	assert(parsedDesignText(files, VLOG_READER_BISON, dir, &hits) == parsed && hits == 2);
+	assert(parsedDesignText(files, VLOG_READER_BISON, dir, &hits) == parsed && hits == 3);
+
+	// only the changed file gets a new entry
+	ofstream(topFile) << "module top(a, b, y);\ninput a, b;\noutput y;\nor2 u1(a, b, y);\nendmodule\n";
+	parsed = parsedDesignText(files, VLOG_READER_BISON);
+	assert(parsedDesignText(files, VLOG_READER_BISON, dir, &hits) == parsed && hits == 2);
+	assert(cacheEntries(dir) == 4);
+
+	// a bad entry is parsed again and replaced, so the next run reads it from the cache
+	cacheEntries(dir, false, true);
+	assert(parsedDesignText(files, VLOG_READER_BISON, dir, &hits) == parsed && hits == 0);
+	assert(parsedDesignText(files, VLOG_READER_BISON, dir, &hits) == parsed && hits == 3 && cacheEntries(dir) == 4);
+	cacheEntries(dir, true);
+	rmdir(dir.c_str());
+	remove(topFile);
+	cout << "Parse cache test passed" << endl;
+}
+
+void testNetGen() {
+	hcmDesign* library = new hcmDesign("GenLibrary");
+	assert(library->parseStructuralVerilog("../ISCAS-85/stdcell.v") == BAD_PARAM);
+	hcmNetGenParams params;
+	params.seed = 7;
+	params.numInsts = 20000;
+	params.dffRatio = 0.1;
+
+	// the same seed and knobs write the same netlist, another seed another one
+	stringstream first, second, other;
+	hcmNetGen gen(library, params);
+	assert(gen.good() && gen.write(first) == 0);
+	hcmNetGen again(library, params);
+	assert(again.write(second) == 0 && first.str() == second.str());
+	params.seed = 8;
+	hcmNetGen reseeded(library, params);
+	assert(reseeded.write(other) == 0 && other.str() != first.str());
+	delete library;
+
+	// the netlist reads with the library and flattens to the gates it was made of
+	const char* vFile = "netgen_test.v";
+	ofstream(vFile) << first.str();
+	hcmDesign* d = new hcmDesign("GenDesign");
+	assert(d->parseStructuralVerilog("../ISCAS-85/stdcell.v") == BAD_PARAM);
+	assert(d->parseStructuralVerilog(vFile) == BAD_PARAM);
+	set<string> globals = {"VDD", "VSS"};
+	hcmCell* flat = hcmFlatten("flat", d->getCell(params.top), globals);
+	assert(flat->getInstances().size() == gen.getFlatInsts());
+	delete d;
+	remove(vFile);
+	cout << "Netgen test passed" << endl;
+}
+
+// the instances of the flat cell \a c with the nets of their pins, and its nodes with their ports
+static string flatCellText(hcmCell* c) {
+	stringstream text;
+	for(auto iI = c->getInstances().begin(); iI != c->getInstances().end(); ++iI) {
+		text << iI->first << " " << iI->second->masterCell()->getName();
+		const map<string, hcmInstPort*>& pins = iI->second->getInstPorts();
+		for(auto pI = pins.begin(); pI != pins.end(); ++pI) {
+			text << " " << pI->second->getPort()->getName() << "=" << pI->second->getNode()->getName();
+		}
+		text << endl;
+	}
+	for(auto nI = c->getNodes().begin(); nI != c->getNodes().end(); ++nI) {
+		text << nI->first << (nI->second->getPort() ? " port" : "") << endl;
+	}
+	return text.str();
+}
+
+void testFlatten() {
+	set<string> globals = {"VDD", "VSS"};
+	for(string c : {"1355", "6288"}) {
+		hcmDesign* d = new hcmDesign("FlatDesign");
+		assert(d->parseStructuralVerilog("../ISCAS-85/stdcell.v") == BAD_PARAM);
+		assert(d->parseStructuralVerilog(("../ISCAS-85/c" + c + "high.v").c_str()) == BAD_PARAM);
+		hcmCell* top = d->getCell("Circuit" + c);
+		// the top down flatten gives the cell of the reference, with the same names
+		hcmCell* ref = hcmFlattenBottomUp("ref", top, globals);
+		hcmCell* flat = hcmFlatten("flat", top, globals);
+		assert(!flat->getInstances().empty() && flatCellText(flat) == flatCellText(ref));
+		delete d;
+	}
+	cout << "Flatten test passed" << endl;
+}
+
+void testFlattenThreads() {
+	set<string> globals = {"VDD", "VSS"};
+	for(string c : {"1355", "6288"}) {
+		hcmDesign* d = new hcmDesign("ThreadsDesign");
+		assert(d->parseStructuralVerilog("../ISCAS-85/stdcell.v") == BAD_PARAM);
+		assert(d->parseStructuralVerilog(("../ISCAS-85/c" + c + "high.v").c_str()) == BAD_PARAM);
+		hcmCell* top = d->getCell("Circuit" + c);
+		// the stages of the threads are merged in order, so any number of threads gives the same cell
+		string text = flatCellText(hcmFlatten("flat1", top, globals, 1));
+		for(unsigned int t : {2, 4, 7}) {
+			assert(flatCellText(hcmFlatten("flat" + to_string(t), top, globals, t)) == text);
+		}
+		delete d;
+	}
+	cout << "Flatten threads test passed" << endl;
+}
+
+// a hierarchy reusing its masters at several levels - leaf is met 32 times, mid 9 times
+static const char* hierText =
+	"module inv(A, Y);\ninput A;\noutput Y;\nendmodule\n"
+	"module leaf(a, y);\ninput a;\noutput y;\nwire w;\ninv u1(a, w);\ninv u2(w, y);\nendmodule\n"
+	"module mid(a, y);\ninput a;\noutput y;\nwire w0, w1;\nleaf l0(a, w0);\nleaf l1(w0, w1);\nleaf l2(w1, y);\nendmodule\n"
+	"module big(a, y);\ninput a;\noutput y;\nwire w0, w1;\nmid m0(a, w0);\nmid m1(w0, w1);\nleaf l(w1, y);\nendmodule\n"
+	"module top(a, y);\ninput a;\noutput y;\nwire w0, w1, w2, w3, w4;\nbig b0(a, w0);\nbig b1(w0, w1);\nbig b2(w1, w2);\n"
+	"big b3(w2, w3);\nmid m(w3, w4);\nleaf l(w4, y);\nendmodule\n";
+
+// the instances a flatten of \a c down to \a limits keeps, by their flat name, with their masters
+static void partialLeaves(hcmCell* c, const hcmFlattenLimits& limits, int level, const string& prefix, map<string, string>& leaves) {
+	for(auto iI = c->getInstances().begin(); iI != c->getInstances().end(); ++iI) {
+		hcmCell* master = iI->second->masterCell();
+		string name = prefix + iI->first;
+		if(master->getInstances().empty() || (limits.maxDepth > 0 && level >= limits.maxDepth) ||
+		   limits.masters.count(master->getName()) || limits.paths.count(name)) {
+			leaves[name] = master->getName();
+		} else {
+			partialLeaves(master, limits, level + 1, name + "/", leaves);
+		}
+	}
+}
+
+// flattens \a top down to \a limits and checks the kept instances and the nets they are on, \a full is the
+// printed full flatten of \a top
+static hcmCell* checkPartial(hcmCell* top, const hcmFlattenLimits& limits, unsigned int numThreads, const string& full) {
+	static int numCells = 0;
+	set<string> globals = {"VDD", "VSS"};
+	hcmCell* part = hcmFlattenPartial("part" + to_string(numCells++), top, globals, limits, numThreads);
+	map<string, string> expected, kept;
+	partialLeaves(top, limits, 1, "", expected);
+	for(auto iI = part->getInstances().begin(); iI != part->getInstances().end(); ++iI) {
+		kept[iI->first] = iI->second->masterCell()->getName();
+	}
+	assert(kept == expected);
+	// the kept instances are on the flat nets of their ports, so flattening them gives the full flatten
+	assert(flatCellText(hcmFlatten("part" + to_string(numCells++), part, globals)) == full);
+	return part;
+}
+
+void testFlattenPartial() {
+	const char* vFile = "partial_test.v";
+	ofstream(vFile) << hierText;
+	hcmDesign* d = new hcmDesign("PartialDesign");
+	assert(d->parseStructuralVerilog(vFile) == BAD_PARAM);
+	hcmCell* top = d->getCell("top");
+	set<string> globals = {"VDD", "VSS"};
+	string full = flatCellText(hcmFlattenBottomUp("ref", top, globals));
+
+	// the instances of level 2 stay, named and connected as in a full flatten
+	hcmFlattenLimits limits;
+	limits.maxDepth = 2;
+	hcmCell* part = checkPartial(top, limits, 1, full);
+	hcmInstance* m1 = part->getInst("b1/m1");
+	assert(m1 != NULL && m1->masterCell() == d->getCell("mid") && part->getInst("b1/l") != NULL);
+	assert(m1->getInstPort("b1/m1%a")->getNode() == part->getNode("b1/w0"));
+	assert(m1->getInstPort("b1/m1%y")->getNode() == part->getNode("b1/w1"));
+	assert(part->getInst("m/l0")->masterCell() == d->getCell("leaf") && part->getInst("l/u1") != NULL);
+
+	// the instances of a master stay at any level
+	limits = hcmFlattenLimits();
+	limits.masters = {"mid"};
+	part = checkPartial(top, limits, 1, full);
+	assert(part->getInst("m")->getInstPort("m%a")->getNode() == part->getNode("w3"));
+	assert(part->getInst("b2/m0") != NULL && part->getInst("b2/l/u1") != NULL);
+
+	// and the instances of the paths, the other instances of their masters are flattened
+	limits = hcmFlattenLimits();
+	limits.paths = {"b1", "b2/m0"};
+	part = checkPartial(top, limits, 1, full);
+	assert(part->getInst("b1")->getInstPort("b1%y")->getNode() == part->getNode("w1"));
+	assert(part->getInst("b2/m0")->getInstPort("b2/m0%y")->getNode() == part->getNode("b2/w0"));
+	assert(part->getInst("b2/m1/l0/u1") != NULL && part->getInst("b0") == NULL);
+	remove(vFile);
+	delete d;
+	cout << "Flatten partial test passed" << endl;
+}
+
+// a random hierarchy of the modules m0 to m7 over the gates of stdcell.v, each module holds gates and
+// the modules up to three below it, so the masters are reused at several levels
+static string randomHierarchy(unsigned int seed) {
+	const char* gates[] = {"inv", "buffer", "and2", "or2", "nand2", "nor2"};
+	uint64_t state = seed;
+	auto next = [&state](uint64_t n) {
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return (state >> 33) % n;
+	};
+	stringstream text;
+	for(int m = 0; m < 8; m++) {
+		text << "module m" << m << "(a, b, y);\ninput a, b;\noutput y;\n";
+		vector<string> nets = {"a", "b"};
+		int numItems = 2 + next(4);
+		for(int i = 0; i < numItems; i++) {
+			string out = (i + 1 == numItems) ? "y" : "w" + to_string(i);
+			if(out != "y") {
+				text << "wire " << out << ";\n";
+			}
+			string in1 = nets[next(nets.size())], in2 = nets[next(nets.size())];
+			if(m > 0 && next(10) < 6) {
+				text << "m" << max(0, m - 3) + (int)next(min(m, 3)) << " u" << i << "(" << in1 << ", " << in2 << ", " << out << ");\n";
+			} else {
+				int g = next(6);
+				text << gates[g] << " u" << i << "(" << in1 << (g < 2 ? "" : ", " + in2) << ", " << out << ");\n";
+			}
+			nets.push_back(out);
+		}
+		text << "endmodule\n";
+	}
+	return text.str();
+}
+
+void testFlattenTemplates() {
+	set<string> globals = {"VDD", "VSS"};
+	const char* vFile = "templates_test.v";
+	ofstream(vFile) << hierText;
+	hcmDesign* d = new hcmDesign("TemplatesDesign");
+	assert(d->parseStructuralVerilog(vFile) == BAD_PARAM);
+	hcmCell* top = d->getCell("top");
+	// leaf and mid are met often enough to be stamped out of templates
+	string full = flatCellText(hcmFlattenBottomUp("ref", top, globals));
+	for(unsigned int t : {1, 4}) {
+		assert(flatCellText(hcmFlatten("flat" + to_string(t), top, globals, t)) == full);
+		hcmFlattenLimits limits;
+		for(limits.maxDepth = 1; limits.maxDepth <= 4; limits.maxDepth++) {
+			checkPartial(top, limits, t, full);
+		}
+		limits = hcmFlattenLimits();
+		limits.masters = {"leaf"};
+		checkPartial(top, limits, t, full);
+		limits.masters.clear();
+		limits.paths = {"b3/m1/l2"};
+		checkPartial(top, limits, t, full);
+	}
+	delete d;
+
+	// the depth a master is met at first is not the highest it is met at
+	for(unsigned int seed = 1; seed <= 40; seed++) {
+		ofstream(vFile) << randomHierarchy(seed);
+		d = new hcmDesign("RandomDesign");
+		assert(d->parseStructuralVerilog("../ISCAS-85/stdcell.v") == BAD_PARAM);
+		assert(d->parseStructuralVerilog(vFile) == BAD_PARAM);
+		top = d->getCell("m7");
+		full = flatCellText(hcmFlattenBottomUp("ref", top, globals));
+		for(unsigned int t : {1, 4}) {
+			hcmFlattenLimits limits;
+			for(limits.maxDepth = 0; limits.maxDepth <= 4; limits.maxDepth++) {
+				checkPartial(top, limits, t, full);
+			}
+		}
+		delete d;
+	}
+	remove(vFile);
+	cout << "Flatten templates test passed" << endl;
+}
+
+void testNamePaths() {
+	hcmNameTable names;
+	hcmNameId abc = names.intern("a/b/c");
+	hcmNameId abd = names.intern("a/b/d");
+	hcmNameId ab = names.find("a/b");
+	// the paths are names of their own, the names under a path share it
+	assert(ab != HCM_NO_NAME && names.getParent(abc) == ab && names.getParent(abd) == ab && names.size() == 4);
+	assert(names.getLeaf(abc) == "c" && names.getName(abd) == "a/b/d" && names.find("a/b/d") == abd);
+	assert(names.intern(ab, "c") == abc && names.find("a/b/e") == HCM_NO_NAME && names.find("b") == HCM_NO_NAME);
+	assert(names.isUnder(abc, names.find("a")) && !names.isUnder(abc, abd));
+	assert(names.nameSize(abc) == 5 && names.isPrefixOf(abc, "a/b/c%A") && !names.isPrefixOf(abc, "a/b/d%A") && !names.isPrefixOf(abc, "a/b"));
+
+	// the names compare as their strings
+	vector<string> strs = {"a", "a/b", "a/b/c", "a/bc", "a.b", "a0", "ab/c", "", "x//y", "a/b/c/"};
+	for(size_t i = 0; i < strs.size(); i++) {
+		assert(names.getName(names.intern(strs[i])) == strs[i]);
+	}
+	for(size_t i = 0; i < strs.size(); i++) {
+		for(size_t j = 0; j < strs.size(); j++) {
+			int res = names.compare(names.find(strs[i]), names.find(strs[j]));
+			int exp = strs[i].compare(strs[j]);
+			assert((res < 0) == (exp < 0) && (res > 0) == (exp > 0));
+		}
+	}
+
+	// the memory report counts the parent paths of the flat names as names
+	hcmDesign* d = new hcmDesign("PathDesign");
+	hcmCell* top = d->createCell("top");
+	size_t before = d->memoryReport().nameTableNames;
+	top->createNode("u1/u2/n1");
+	top->createNode("u1/u2/n2");
+	hcmMemoryReport r = d->memoryReport();
+	assert(r.nameTableNames == d->getNameTable().size() && r.nameTableNames == before + 4);
+	assert(d->getNameTable().find("u1/u2") != HCM_NO_NAME && top->getNode("u1/u2") == NULL);
+
+	// the flat objects keep their names as ids, the string is made by getName()
+	hcmNode* n1 = top->getNode("u1/u2/n1");
+	assert(n1->getName() == "u1/u2/n1" && d->getNameTable().getParent(n1->getNameId()) == d->getNameTable().find("u1/u2"));
+	assert(r.nodes.stringBytes == 0);
+	hcmCell* inv = d->createCell("inv");
+	hcmPort* a = inv->createNode("A")->createPort(IN);
+	hcmInstance* g = top->createInst("u1/u2/g1", inv);
+	hcmInstPort* ip = top->connect(g, n1, a);
+	assert(ip->getName() == "u1/u2/g1%A" && ip->getNameId() == HCM_NO_NAME);
+	assert(g->getInstPort("u1/u2/g1%A") == ip && g->getInstPort("u1/u2/g2%A") == NULL && g->getInstPort("u1/u2/g1") == NULL);
+	delete d;
+	cout << "Name paths test passed" << endl;
+}
+
 int main(int argc, char* argv[]) {
 	testParsing();
+	testCompactNetlist();
+	testProperties();
+	testInstPortOrdinals();
+	testCellBuilder();
+	testOccIterator();
+	testOccTree();
+	testJournal();
+	testFingerprint();
+	testBus();
+	testMemoryReport();
+	testSnapshot();
+	testMultiFileParsing();
+	testFastReader();
+	testStringPool();
+	testPortOrder();
+	testVerilogLibrary();
+	testParseCache();
+	testNetGen();
+	testFlatten();
+	testFlattenThreads();
+	testFlattenPartial();
+	testFlattenTemplates();
+	testNamePaths();
 	return 0;
 }
 
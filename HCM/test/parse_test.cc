@@ -2,15 +2,22 @@
 using namespace std;
 
 int main(int argc, char **argv) {
-  if (argc < 2) {
-    printf("Usage: %s file1.v [file2.v] ...\n", argv[0]);
+  // -fast reads the files by the hand written reader
+  hcmVerilogReader reader = VLOG_READER_BISON;
+  int first = 1;
+  if (argc > 1 && !strcmp(argv[1], "-fast")) {
+    reader = VLOG_READER_FAST;
+    first++;
+  }
+  if (argc <= first) {
+    printf("Usage: %s [-fast] file1.v [file2.v] ...\n", argv[0]);
     exit(1);
   }
 
   hcmDesign* d = new hcmDesign("MyDesign");
-  for (int i = 1; i < argc; i++) {
+  for (int i = first; i < argc; i++) {
     printf("parsing %s ...\n", argv[i]);
-    d->parseStructuralVerilog(argv[i]);
+    d->parseStructuralVerilog(argv[i], reader);
   }
   d->printInfo();
   delete d;
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <thread>
 #include "hcm.h"
 #include "flat.h"
 #include "utils/System.h"
@@ -78,16 +79,30 @@ int main(int argc, char **argv)
 	globalNodes.insert("VDD");
 	globalNodes.insert("VSS");
 
-	// Spec HCM routine
+	// Spec and Impl HCM routines - the designs are independent, so the spec is parsed on its own thread
 	hcmDesign *specDesign = new hcmDesign("specDesign");
+	hcmDesign *impDesign = new hcmDesign("impDesign");
 	for (i = 0; i < specVlgFiles.size(); i++)
 	{
 		printf("-I- Parsing verilog %s ...\n", specVlgFiles[i].c_str());
-		if (!specDesign->parseStructuralVerilog(specVlgFiles[i].c_str()))
-		{
-			cerr << "-E- Could not parse: " << specVlgFiles[i] << " aborting." << endl;
-			exit(1);
-		}
+	}
+	for (i = 0; i < implementationVlgFiles.size(); i++)
+	{
+		printf("-I- Parsing verilog %s ...\n", implementationVlgFiles[i].c_str());
+	}
+	hcmRes specRes = OK;
+	thread specParser([&]() { specRes = specDesign->parseStructuralVerilog(specVlgFiles); });
+	hcmRes impRes = impDesign->parseStructuralVerilog(implementationVlgFiles);
+	specParser.join();
+	if (!specRes)
+	{
+		cerr << "-E- Could not parse the spec verilog files, aborting." << endl;
+		exit(1);
+	}
+	if (!impRes)
+	{
+		cerr << "-E- Could not parse the implementation verilog files, aborting." << endl;
+		exit(1);
 	}
 
 	hcmCell *topSpecCell = specDesign->getCell(specCellName);
@@ -99,18 +114,6 @@ int main(int argc, char **argv)
 
 	hcmCell *flatSpecCell = hcmFlatten(specCellName + string("_flat"), topSpecCell, globalNodes);
 
-	// Impl HCM routine
-	hcmDesign *impDesign = new hcmDesign("impDesign");
-	for (i = 0; i < implementationVlgFiles.size(); i++)
-	{
-		printf("-I- Parsing verilog %s ...\n", implementationVlgFiles[i].c_str());
-		if (!impDesign->parseStructuralVerilog(implementationVlgFiles[i].c_str()))
-		{
-			cerr << "-E- Could not parse: " << implementationVlgFiles[i] << " aborting." << endl;
-			exit(1);
-		}
-	}
-
 	hcmCell *topImpCell = impDesign->getCell(implementationCellName);
 	if (!topImpCell)
 	{